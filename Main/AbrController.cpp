@@ -0,0 +1,139 @@
+/*
+ * AbrController.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "AbrController.h"
+
+#include <algorithm>
+
+using namespace libdashtest;
+
+#define DECODE_SMOOTHING    0.3     /* weight of the newest decode time */
+#define DECODE_HEADROOM     0.9     /* share of a segment duration decoding may use */
+
+AbrController::AbrController    (const std::vector<uint32_t> &bandwidths, IThroughputEstimator *estimator,
+                                 IAbrPolicy *policy, size_t decodeWorkers) :
+               estimator        (estimator),
+               policy           (policy),
+               decodeWorkers    (decodeWorkers > 0 ? decodeWorkers : 1),
+               lastLevel        (0)
+{
+    for(size_t i = 0; i < bandwidths.size(); i++)
+        this->levelToIndex.push_back(i);
+
+    std::stable_sort(this->levelToIndex.begin(), this->levelToIndex.end(),
+                     [&bandwidths](size_t a, size_t b) { return bandwidths.at(a) < bandwidths.at(b); });
+
+    this->indexToLevel.resize(bandwidths.size());
+    for(size_t level = 0; level < this->levelToIndex.size(); level++)
+    {
+        uint32_t bandwidth = bandwidths.at(this->levelToIndex.at(level));
+
+        this->indexToLevel.at(this->levelToIndex.at(level)) = level;
+        this->bitrates.push_back(bandwidth > 0 ? bandwidth : 1);
+    }
+
+    this->decodeSeconds.resize(bandwidths.size(), 0);
+}
+AbrController::~AbrController   ()
+{
+    delete(this->estimator);
+    delete(this->policy);
+}
+
+void            AbrController::AddDownload          (size_t bytes, double seconds)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->estimator->AddSample(bytes, seconds);
+}
+void            AbrController::AddDecode            (size_t representation, double seconds)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(representation >= this->indexToLevel.size() || seconds <= 0)
+        return;
+
+    double &estimate = this->decodeSeconds.at(this->indexToLevel.at(representation));
+    if(estimate <= 0)
+        estimate = seconds;
+    else
+        estimate = DECODE_SMOOTHING * seconds + (1 - DECODE_SMOOTHING) * estimate;
+}
+size_t          AbrController::Select               (double bufferLevel, double bufferCapacity, double segmentDuration)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(this->bitrates.empty())
+        return 0;
+
+    AbrContext context;
+    context.bitrates        = &this->bitrates;
+    context.lastLevel       = this->lastLevel;
+    context.maxLevel        = this->MaxDecodableLevel(segmentDuration);
+    context.throughput      = this->estimator->Estimate();
+    context.bufferLevel     = bufferLevel;
+    context.bufferCapacity  = bufferCapacity;
+    context.segmentDuration = segmentDuration;
+
+    size_t level = this->policy->Select(context);
+    if(level > context.maxLevel)
+        level = context.maxLevel;
+
+    this->lastLevel = level;
+
+    return this->levelToIndex.at(level);
+}
+size_t          AbrController::LowestRepresentation () const
+{
+    return this->levelToIndex.empty() ? 0 : this->levelToIndex.front();
+}
+double          AbrController::ThroughputEstimate   ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    return this->estimator->Estimate();
+}
+double          AbrController::DecodeEstimate       (size_t representation)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(representation >= this->indexToLevel.size())
+        return 0;
+
+    return this->DecodeEstimateLevel(this->indexToLevel.at(representation));
+}
+std::string     AbrController::PolicyName           () const
+{
+    return this->policy->Name();
+}
+double          AbrController::DecodeEstimateLevel  (size_t level) const
+{
+    if(this->decodeSeconds.at(level) > 0)
+        return this->decodeSeconds.at(level);
+
+    /* not decoded yet: scale the nearest measured level by bitrate */
+    for(size_t distance = 1; distance < this->bitrates.size(); distance++)
+    {
+        if(level >= distance && this->decodeSeconds.at(level - distance) > 0)
+            return this->decodeSeconds.at(level - distance) * this->bitrates.at(level) / this->bitrates.at(level - distance);
+        if(level + distance < this->bitrates.size() && this->decodeSeconds.at(level + distance) > 0)
+            return this->decodeSeconds.at(level + distance) * this->bitrates.at(level) / this->bitrates.at(level + distance);
+    }
+
+    return 0;
+}
+size_t          AbrController::MaxDecodableLevel    (double segmentDuration) const
+{
+    /* decode workers run in parallel, so each may take decodeWorkers segments' time */
+    double budget = DECODE_HEADROOM * segmentDuration * this->decodeWorkers;
+
+    size_t level = 0;
+    for(size_t i = 1; i < this->bitrates.size(); i++)
+        if(this->DecodeEstimateLevel(i) <= budget)
+            level = i;
+
+    return level;
+}
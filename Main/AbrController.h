@@ -0,0 +1,66 @@
+/*
+ * AbrController.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Chooses the representation of the next segment from a throughput
+ * estimate, the buffer level and the measured V-PCC decode time of each
+ * representation. A representation the decode workers cannot finish within
+ * one segment duration is never selected, however fast the network is.
+ *****************************************************************************/
+
+#ifndef ABRCONTROLLER_H_
+#define ABRCONTROLLER_H_
+
+#include "ThroughputEstimator.h"
+#include "AbrPolicy.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace libdashtest
+{
+    class AbrController
+    {
+        public:
+            /*
+             *  bandwidths are the representations' @bandwidth in MPD order,
+             *  which is also the order of all representation arguments below.
+             *  Takes ownership of estimator and policy.
+             */
+            AbrController           (const std::vector<uint32_t> &bandwidths, IThroughputEstimator *estimator,
+                                     IAbrPolicy *policy, size_t decodeWorkers);
+            virtual ~AbrController  ();
+
+            void    AddDownload         (size_t bytes, double seconds);
+            void    AddDecode           (size_t representation, double seconds);
+            size_t  Select              (double bufferLevel, double bufferCapacity, double segmentDuration);
+
+            size_t  LowestRepresentation    () const;
+            double  ThroughputEstimate      ();
+            /*
+             *  Expected decode time of one segment, 0 while neither this nor
+             *  any other representation has been decoded yet.
+             */
+            double  DecodeEstimate          (size_t representation);
+            std::string PolicyName          () const;
+
+        private:
+            std::vector<double>     bitrates;       /* ascending */
+            std::vector<size_t>     levelToIndex;
+            std::vector<size_t>     indexToLevel;
+            std::vector<double>     decodeSeconds;  /* per level, 0 = not measured */
+            IThroughputEstimator    *estimator;
+            IAbrPolicy              *policy;
+            size_t                  decodeWorkers;
+            size_t                  lastLevel;
+            std::mutex              monitorMutex;
+
+            double  DecodeEstimateLevel (size_t level) const;
+            size_t  MaxDecodableLevel   (double segmentDuration) const;
+    };
+}
+
+#endif /* ABRCONTROLLER_H_ */
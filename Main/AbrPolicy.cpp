@@ -0,0 +1,112 @@
+/*
+ * AbrPolicy.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "AbrPolicy.h"
+
+#include <math.h>
+
+using namespace libdashtest;
+
+ThroughputPolicy::ThroughputPolicy  (double safetyFactor) :
+                  safetyFactor      (safetyFactor)
+{
+}
+ThroughputPolicy::~ThroughputPolicy ()
+{
+}
+
+size_t          ThroughputPolicy::Select    (const AbrContext &context)
+{
+    const std::vector<double> &bitrates = *context.bitrates;
+
+    if(context.throughput <= 0)
+        return 0;
+
+    size_t level = 0;
+    for(size_t i = 1; i < bitrates.size(); i++)
+        if(bitrates.at(i) <= this->safetyFactor * context.throughput)
+            level = i;
+
+    return level;
+}
+std::string     ThroughputPolicy::Name      () const
+{
+    return "throughput";
+}
+
+BufferPolicy::BufferPolicy  ()
+{
+}
+BufferPolicy::~BufferPolicy ()
+{
+}
+
+size_t          BufferPolicy::Select        (const AbrContext &context)
+{
+    const std::vector<double> &bitrates = *context.bitrates;
+
+    if(bitrates.size() < 2)
+        return 0;
+
+    double minimumBuffer    = context.segmentDuration;
+    double target           = context.bufferCapacity - context.segmentDuration;
+    if(target < 2 * minimumBuffer)
+        target = 2 * minimumBuffer;
+
+    double maxUtility   = log(bitrates.back() / bitrates.front()) + 1;
+    double gp           = (maxUtility - 1) / (target / minimumBuffer - 1);
+    double v            = minimumBuffer / gp;
+
+    size_t level        = 0;
+    double bestScore    = 0;
+    for(size_t i = 0; i < bitrates.size(); i++)
+    {
+        double utility  = log(bitrates.at(i) / bitrates.front()) + 1;
+        double score    = (v * (utility + gp) - context.bufferLevel) / bitrates.at(i);
+
+        if(i == 0 || score >= bestScore)
+        {
+            level       = i;
+            bestScore   = score;
+        }
+    }
+
+    return level;
+}
+std::string     BufferPolicy::Name          () const
+{
+    return "buffer";
+}
+
+HybridPolicy::HybridPolicy      (double lowWatermark, double highWatermark, double safetyFactor) :
+              throughputPolicy  (safetyFactor),
+              lowWatermark      (lowWatermark),
+              highWatermark     (highWatermark),
+              isBufferBased     (false)
+{
+}
+HybridPolicy::~HybridPolicy     ()
+{
+}
+
+size_t          HybridPolicy::Select        (const AbrContext &context)
+{
+    double fill = context.bufferCapacity > 0 ? context.bufferLevel / context.bufferCapacity : 0;
+
+    if(this->isBufferBased && fill < this->lowWatermark)
+        this->isBufferBased = false;
+    else if(!this->isBufferBased && fill >= this->highWatermark)
+        this->isBufferBased = true;
+
+    if(this->isBufferBased)
+        return this->bufferPolicy.Select(context);
+
+    return this->throughputPolicy.Select(context);
+}
+std::string     HybridPolicy::Name          () const
+{
+    return "hybrid";
+}
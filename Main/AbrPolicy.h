@@ -0,0 +1,96 @@
+/*
+ * AbrPolicy.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Quality selection rules used by AbrController. Policies work on levels,
+ * i.e. representations sorted by ascending bandwidth, and never see the
+ * MPD order.
+ *****************************************************************************/
+
+#ifndef ABRPOLICY_H_
+#define ABRPOLICY_H_
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+
+namespace libdashtest
+{
+    struct AbrContext
+    {
+        const std::vector<double>   *bitrates;          /* bit/s per level, ascending */
+        size_t                      lastLevel;
+        size_t                      maxLevel;           /* highest level the decoder keeps up with */
+        double                      throughput;         /* bit/s, 0 while unknown */
+        double                      bufferLevel;        /* seconds fetched but not yet presented */
+        double                      bufferCapacity;     /* seconds the pipeline can hold */
+        double                      segmentDuration;    /* seconds */
+    };
+
+    class IAbrPolicy
+    {
+        public:
+            virtual ~IAbrPolicy () {}
+
+            virtual size_t      Select  (const AbrContext &context) = 0;
+            virtual std::string Name    () const                    = 0;
+    };
+
+    /*
+     *  Highest level whose bitrate fits into safetyFactor times the
+     *  throughput estimate. This is the old rule with smoothing added.
+     */
+    class ThroughputPolicy : public IAbrPolicy
+    {
+        public:
+            ThroughputPolicy            (double safetyFactor = 0.9);
+            virtual ~ThroughputPolicy   ();
+
+            virtual size_t      Select  (const AbrContext &context);
+            virtual std::string Name    () const;
+
+        private:
+            double  safetyFactor;
+    };
+
+    /*
+     *  BOLA-BASIC: picks the level maximising (V * (utility + gp) - buffer)
+     *  / bitrate with utility = ln(bitrate / lowest bitrate) + 1. gp and V are
+     *  derived so that the lowest level is chosen at one segment of buffer
+     *  and the highest level once the buffer is nearly full.
+     */
+    class BufferPolicy : public IAbrPolicy
+    {
+        public:
+            BufferPolicy            ();
+            virtual ~BufferPolicy   ();
+
+            virtual size_t      Select  (const AbrContext &context);
+            virtual std::string Name    () const;
+    };
+
+    /*
+     *  Uses ThroughputPolicy while the buffer is short (start-up, after a
+     *  stall) and BufferPolicy once it is filled past highWatermark of the
+     *  capacity, switching back below lowWatermark.
+     */
+    class HybridPolicy : public IAbrPolicy
+    {
+        public:
+            HybridPolicy            (double lowWatermark = 0.3, double highWatermark = 0.6, double safetyFactor = 0.9);
+            virtual ~HybridPolicy   ();
+
+            virtual size_t      Select  (const AbrContext &context);
+            virtual std::string Name    () const;
+
+        private:
+            ThroughputPolicy    throughputPolicy;
+            BufferPolicy        bufferPolicy;
+            double              lowWatermark;
+            double              highWatermark;
+            bool                isBufferBased;
+    };
+}
+
+#endif /* ABRPOLICY_H_ */
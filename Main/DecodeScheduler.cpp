@@ -0,0 +1,165 @@
+/*
+ * DecodeScheduler.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "DecodeScheduler.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace libdashtest;
+
+DecodeScheduler::DecodeScheduler    (size_t workerCount, size_t maxInFlight, const std::vector<std::string> &options) :
+                 options            (options),
+                 maxInFlight        (maxInFlight > workerCount ? maxInFlight : workerCount),
+                 nextSubmit         (0),
+                 nextCollect        (0),
+                 isStopping         (false)
+{
+    if(workerCount == 0)
+        workerCount = 1;
+
+    for(size_t i = 0; i < workerCount; i++)
+        this->workers.push_back(std::thread(&DecodeScheduler::WorkerMain, this));
+}
+DecodeScheduler::~DecodeScheduler   ()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->monitorMutex);
+        this->isStopping = true;
+        this->jobAvailable.notify_all();
+    }
+
+    for(size_t i = 0; i < this->workers.size(); i++)
+        this->workers.at(i).join();
+
+    for(size_t i = 0; i < this->jobs.size(); i++)
+        delete(this->jobs.at(i).segment);
+
+    for(std::map<size_t, DecodedSegment *>::iterator it = this->started.begin(); it != this->started.end(); it++)
+        delete(it->second);
+}
+
+void                DecodeScheduler::Submit         (MediaSegment *segment)
+{
+    std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+    while(this->nextSubmit - this->nextCollect >= this->maxInFlight)
+        this->slotAvailable.wait(lock);
+
+    Job job;
+    job.sequence    = this->nextSubmit++;
+    job.segment     = segment;
+
+    this->jobs.push_back(job);
+    this->jobAvailable.notify_one();
+}
+DecodedSegment*     DecodeScheduler::Next           ()
+{
+    std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+    std::map<size_t, DecodedSegment *>::iterator it;
+    while((it = this->started.find(this->nextCollect)) == this->started.end())
+        this->segmentChanged.wait(lock);
+
+    return it->second;
+}
+bool                DecodeScheduler::NextFrame      (DecodedSegment *segment, pcc::PCCPointSet3 &frame)
+{
+    std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+    while(segment->frames.empty() && !segment->isComplete)
+        this->segmentChanged.wait(lock);
+
+    if(!segment->frames.empty())
+    {
+        frame = std::move(segment->frames.front());
+        segment->frames.pop_front();
+        return true;
+    }
+
+    if(this->started.erase(segment->sequence) > 0)
+    {
+        this->nextCollect++;
+        this->slotAvailable.notify_one();
+    }
+
+    return false;
+}
+size_t              DecodeScheduler::WorkerCount    () const
+{
+    return this->workers.size();
+}
+size_t              DecodeScheduler::InFlight       ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    return this->nextSubmit - this->nextCollect;
+}
+void                DecodeScheduler::WorkerMain     ()
+{
+    VPCCSegmentDecoder decoder;
+    decoder.Init(this->options);
+
+    while(true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+            while(this->jobs.empty() && !this->isStopping)
+                this->jobAvailable.wait(lock);
+
+            if(this->isStopping)
+                return;
+
+            job = this->jobs.front();
+            this->jobs.pop_front();
+        }
+
+        DecodedSegment *result = new DecodedSegment();
+        result->sequence        = job.sequence;
+        result->index           = job.segment->index;
+        result->representation  = job.segment->representation;
+        result->name            = job.segment->name;
+        result->bytes           = job.segment->data.size();
+        result->isFailed        = job.segment->isFailed;
+        result->isDecoded       = false;
+        result->isComplete      = false;
+        result->decodeSeconds   = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(this->monitorMutex);
+            this->started[result->sequence] = result;
+            this->segmentChanged.notify_all();
+        }
+
+        bool    isDecoded       = false;
+        double  decodeSeconds   = 0;
+
+        if(!result->isFailed)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            isDecoded = decoder.Decode(job.segment->name, job.segment->data, [this, result](pcc::PCCPointSet3 &frame) {
+                std::lock_guard<std::mutex> lock(this->monitorMutex);
+                result->frames.push_back(std::move(frame));
+                this->segmentChanged.notify_all();
+            });
+            std::chrono::duration<double> sec = std::chrono::steady_clock::now() - start;
+            decodeSeconds = sec.count();
+
+            if(!isDecoded)
+                std::cerr << "DecodeScheduler: decode error " << result->name << std::endl;
+        }
+
+        delete(job.segment);
+
+        std::lock_guard<std::mutex> lock(this->monitorMutex);
+        result->isDecoded       = isDecoded;
+        result->decodeSeconds   = decodeSeconds;
+        result->isComplete      = true;
+        this->segmentChanged.notify_all();
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * DecodeScheduler.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Keeps several independently decodable (all-intra) segments decoding at
+ * once on a pool of worker threads, each owning a VPCCSegmentDecoder.
+ * Results are handed out strictly in submission (= presentation) order,
+ * the frames of the oldest segment as soon as each one is reconstructed.
+ *****************************************************************************/
+
+#ifndef DECODESCHEDULER_H_
+#define DECODESCHEDULER_H_
+
+#include "VPCCSegmentDecoder.h"
+#include "MediaSegment.h"
+
+#include "PCCPointSet.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace libdashtest
+{
+    struct DecodedSegment
+    {
+        size_t                          sequence;       /* submission order, used for re-ordering */
+        size_t                          index;          /* MediaSegment::index */
+        size_t                          representation; /* MediaSegment::representation */
+        std::string                     name;
+        size_t                          bytes;          /* compressed size, freed once decoded */
+        bool                            isFailed;       /* MediaSegment::isFailed, nothing was decoded */
+        bool                            isDecoded;
+        bool                            isComplete;     /* decoding ended, no frame is added anymore */
+        double                          decodeSeconds;
+        std::deque<pcc::PCCPointSet3>   frames;         /* reconstructed, not yet taken with NextFrame() */
+    };
+
+    class DecodeScheduler
+    {
+        public:
+            DecodeScheduler             (size_t workerCount, size_t maxInFlight, const std::vector<std::string> &options);
+            virtual ~DecodeScheduler    ();
+
+            /*
+             *  Takes ownership of segment. Blocks while maxInFlight segments
+             *  are submitted but not yet collected with NextFrame().
+             */
+            void                Submit      (MediaSegment *segment);
+            /*
+             *  Blocks until the oldest outstanding segment is being decoded,
+             *  even if later ones finished first. Its frames are taken with
+             *  NextFrame(); the caller deletes the result once that returned
+             *  false.
+             */
+            DecodedSegment*     Next        ();
+            /*
+             *  Moves the next frame of segment, as returned by Next(), to
+             *  frame as soon as it is reconstructed. False once segment is
+             *  complete and all its frames were taken; isDecoded and
+             *  decodeSeconds are set then and the next segment is collected.
+             */
+            bool                NextFrame   (DecodedSegment *segment, pcc::PCCPointSet3 &frame);
+
+            size_t              WorkerCount () const;
+            size_t              InFlight    ();
+
+        private:
+            struct Job
+            {
+                size_t          sequence;
+                MediaSegment    *segment;
+            };
+
+            std::vector<std::string>            options;
+            std::vector<std::thread>            workers;
+            std::deque<Job>                     jobs;
+            std::map<size_t, DecodedSegment *>  started;
+            size_t                              maxInFlight;
+            size_t                              nextSubmit;
+            size_t                              nextCollect;
+            bool                                isStopping;
+
+            std::mutex                          monitorMutex;
+            std::condition_variable             jobAvailable;
+            std::condition_variable             segmentChanged;
+            std::condition_variable             slotAvailable;
+
+            void    WorkerMain  ();
+    };
+}
+
+#endif /* DECODESCHEDULER_H_ */
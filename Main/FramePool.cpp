@@ -0,0 +1,151 @@
+/*
+ * FramePool.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "FramePool.h"
+
+using namespace libdashtest;
+using namespace open3d;
+
+PointCloudFrame::PointCloudFrame    (size_t reservePoints) :
+                 cloud              (std::make_shared<t::geometry::PointCloud>()),
+                 index              (0),
+                 pointCount         (0),
+                 capacity           (0)
+{
+    if(reservePoints > 0)
+        this->Allocate(reservePoints);
+}
+PointCloudFrame::~PointCloudFrame   ()
+{
+}
+
+void                                                PointCloudFrame::Assign     (const pcc::PCCPointSet3 &points, size_t index, size_t capacity)
+{
+    size_t count = points.getPointCount();
+    if(capacity < count)
+        capacity = count;
+    if(capacity != this->capacity)
+        this->Allocate(capacity);
+
+    this->index         = index;
+    this->pointCount    = count;
+
+    float *positions    = this->cloud->GetPointPositions().GetDataPtr<float>();
+    float *colors       = this->cloud->GetPointColors().GetDataPtr<float>();
+    bool  hasColors     = points.hasColors();
+
+    for(size_t i = 0; i < count; i++)
+    {
+        const pcc::PCCPoint3D &p = points[i];
+        positions[3 * i]        = p[0];
+        positions[3 * i + 1]    = p[1];
+        positions[3 * i + 2]    = p[2];
+
+        if(hasColors)
+        {
+            const pcc::PCCColor3B &c = points.getColor(i);
+            colors[3 * i]       = c[0] / 255.0f;
+            colors[3 * i + 1]   = c[1] / 255.0f;
+            colors[3 * i + 2]   = c[2] / 255.0f;
+        }
+        else
+        {
+            colors[3 * i]       = 1.0f;
+            colors[3 * i + 1]   = 1.0f;
+            colors[3 * i + 2]   = 1.0f;
+        }
+    }
+
+    /* padding draws on top of the last real point */
+    for(size_t i = count; i < capacity; i++)
+    {
+        for(size_t k = 0; k < 3; k++)
+        {
+            positions[3 * i + k]    = count > 0 ? positions[3 * (count - 1) + k] : 0.0f;
+            colors[3 * i + k]       = count > 0 ? colors[3 * (count - 1) + k] : 0.0f;
+        }
+    }
+}
+std::shared_ptr<t::geometry::PointCloud>&           PointCloudFrame::Cloud      ()
+{
+    return this->cloud;
+}
+std::shared_ptr<geometry::PointCloud>               PointCloudFrame::ToLegacy   () const
+{
+    std::shared_ptr<geometry::PointCloud> legacy = std::make_shared<geometry::PointCloud>();
+
+    const float *positions  = this->cloud->GetPointPositions().GetDataPtr<float>();
+    const float *colors     = this->cloud->GetPointColors().GetDataPtr<float>();
+
+    legacy->points_.resize(this->pointCount);
+    legacy->colors_.resize(this->pointCount);
+    for(size_t i = 0; i < this->pointCount; i++)
+    {
+        legacy->points_[i] = Eigen::Vector3d(positions[3 * i], positions[3 * i + 1], positions[3 * i + 2]);
+        legacy->colors_[i] = Eigen::Vector3d(colors[3 * i], colors[3 * i + 1], colors[3 * i + 2]);
+    }
+
+    return legacy;
+}
+size_t                                              PointCloudFrame::Index      () const
+{
+    return this->index;
+}
+size_t                                              PointCloudFrame::PointCount () const
+{
+    return this->pointCount;
+}
+size_t                                              PointCloudFrame::Capacity   () const
+{
+    return this->capacity;
+}
+void                                                PointCloudFrame::Allocate   (size_t capacity)
+{
+    core::SizeVector shape({(int64_t) capacity, 3});
+
+    this->cloud->SetPointPositions(core::Tensor::Empty(shape, core::Dtype::Float32));
+    this->cloud->SetPointColors(core::Tensor::Empty(shape, core::Dtype::Float32));
+    this->capacity = capacity;
+}
+
+FramePool::FramePool            (size_t frameCount, size_t reservePoints) :
+           freeFrames           (frameCount)
+{
+    for(size_t i = 0; i < frameCount; i++)
+    {
+        this->frames.push_back(new PointCloudFrame(reservePoints));
+        this->freeFrames.TryPush(this->frames.back());
+    }
+}
+FramePool::~FramePool           ()
+{
+    for(size_t i = 0; i < this->frames.size(); i++)
+        delete(this->frames.at(i));
+}
+
+PointCloudFrame*    FramePool::Acquire      ()
+{
+    return this->freeFrames.Pop();
+}
+void                FramePool::Release      (PointCloudFrame *frame)
+{
+    if(frame == NULL)
+        return;
+
+    this->freeFrames.Push(frame);
+}
+size_t              FramePool::Capacity     () const
+{
+    return this->frames.size();
+}
+size_t              FramePool::Available    () const
+{
+    return this->freeFrames.Size();
+}
+RingStats           FramePool::Stats        () const
+{
+    return this->freeFrames.Stats();
+}
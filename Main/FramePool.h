@@ -0,0 +1,83 @@
+/*
+ * FramePool.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Reusable point cloud buffers shared by the decoder and the renderer.
+ * A decoded PCCPointSet3 is written straight into the float32 tensors of a
+ * pooled open3d::t::geometry::PointCloud, so steady-state playback neither
+ * touches the disk nor allocates per frame. The tensors are laid out
+ * the way the renderer uploads them, so one update is a straight copy.
+ *****************************************************************************/
+
+#ifndef FRAMEPOOL_H_
+#define FRAMEPOOL_H_
+
+#include "open3d/Open3D.h"
+#include "PCCPointSet.h"
+#include "SPSCRing.h"
+
+#include <memory>
+#include <vector>
+
+namespace libdashtest
+{
+    class PointCloudFrame
+    {
+        public:
+            PointCloudFrame             (size_t reservePoints);
+            virtual ~PointCloudFrame    ();
+
+            /*
+             *  Converts positions and colours into the pooled cloud, which
+             *  always holds capacity points: rows past the point count
+             *  repeat the last point, so every frame of one capacity fits
+             *  the same GPU buffer. The tensors are only reallocated when
+             *  capacity changes.
+             */
+            void    Assign  (const pcc::PCCPointSet3 &points, size_t index, size_t capacity);
+
+            std::shared_ptr<open3d::t::geometry::PointCloud>&   Cloud       ();
+            /*
+             *  Copy of the real points only, for snapshots.
+             */
+            std::shared_ptr<open3d::geometry::PointCloud>       ToLegacy    () const;
+            size_t                                              Index       () const;
+            size_t                                              PointCount  () const;
+            size_t                                              Capacity    () const;
+
+        private:
+            std::shared_ptr<open3d::t::geometry::PointCloud>    cloud;
+            size_t                                              index;
+            size_t                                              pointCount;
+            size_t                                              capacity;
+
+            void    Allocate    (size_t capacity);
+    };
+
+    class FramePool
+    {
+        public:
+            FramePool           (size_t frameCount, size_t reservePoints = 0);
+            virtual ~FramePool  ();
+
+            /*
+             *  Blocks until a frame is returned by the renderer, which
+             *  throttles the decoder when playback falls behind. Frames are
+             *  acquired by the decode stage only and released by the UI
+             *  thread only, so the free list is a SPSCRing.
+             */
+            PointCloudFrame*    Acquire     ();
+            void                Release     (PointCloudFrame *frame);
+
+            size_t              Capacity    () const;
+            size_t              Available   () const;
+            RingStats           Stats       () const;
+
+        private:
+            std::vector<PointCloudFrame *>      frames;
+            SPSCRing<PointCloudFrame *>         freeFrames;
+    };
+}
+
+#endif /* FRAMEPOOL_H_ */
@@ -10,34 +10,89 @@
  *****************************************************************************/
 
 #include "HTTPConnection.h"
+#include "../libdash/source/helpers/Time.h"
+
+#include <algorithm>
+#include <atomic>
+#include <errno.h>
 
 using namespace libdashtest;
 using namespace dash::network;
 using namespace dash::metrics;
+using namespace dash::helpers;
+
+static std::atomic<uint32_t> next_tcp_id(1);
+
+/* value of a "Name: value\r\n" header line, names are case-insensitive */
+static bool     header_value    (const std::string &line, const char *name, std::string &value)
+{
+    size_t length = strlen(name);
+
+    if(line.size() <= length || line.at(length) != ':' || strncasecmp(line.c_str(), name, length))
+        return false;
+
+    size_t start    = line.find_first_not_of(" \t", length + 1);
+    size_t end      = line.find_last_not_of(" \t\r\n");
+
+    value = start == std::string::npos || end < start ? "" : line.substr(start, end - start + 1);
+    return true;
+}
 
 HTTPConnection::HTTPConnection  () :
-                peekBufferLen   (0),
-                contentLength   (0),
-                isInit          (false),
-                isScheduled     (false)
+                peekBufferLen       (0),
+                contentLength       (0),
+                statusCode          (0),
+                isInit              (false),
+                isScheduled         (false),
+                receiveStart        (0),
+                receiveEnd          (0),
+                isNonBlocking       (false),
+                wouldBlock          (false),
+                isChunked           (false),
+                chunkState          (ChunkSize),
+                chunkLeft           (0),
+                chunkedLength       (0),
+                hasContentLength    (false),
+                lastTransferBytes   (0),
+                lastTransferSeconds (0),
+                metricsLog          (NULL)
 {
-    this->peekBuffer = new uint8_t[PEEKBUFFER];
+    this->peekBuffer    = new uint8_t[PEEKBUFFER];
+    this->receiveBuffer = new uint8_t[RECEIVEBUFFER];
 }
 HTTPConnection::~HTTPConnection ()
 {
     delete[] this->peekBuffer;
+    delete[] this->receiveBuffer;
     this->CloseSocket();
+
+    for(size_t i = 0; i < this->transfers.size(); i++)
+        delete(this->transfers.at(i).trace);
+
+    for(size_t i = 0; i < this->httpTransactions.size(); i++)
+        delete(this->httpTransactions.at(i));
+
+    for(size_t i = 0; i < this->tcpConnections.size(); i++)
+        delete(this->tcpConnections.at(i));
 }
 
 int             HTTPConnection::Read            (uint8_t *data, size_t len, IChunk *chunk)
 {
     if(this->peekBufferLen == 0)
     {
-        int size = recv(this->httpSocket, (char *)data, len, 0);
+        int size = this->ReadBody(data, len, chunk);
 
+        if(size <= 0 && this->wouldBlock)
+            return READ_WOULD_BLOCK;
+
+        /* a response without Content-Length ends with the connection */
         if(size <= 0)
+        {
+            this->ResponseFinished(chunk);
             return 0;
+        }
 
+        this->BytesReceived(size);
         return size;
     }
 
@@ -92,15 +147,56 @@ bool            HTTPConnection::Init            (IChunk *chunk)
 }
 bool            HTTPConnection::ParseHeader     ()
 {
+    this->contentLength     = 0;
+    this->statusCode        = 0;
+    this->hasContentLength  = false;
+    this->isChunked         = false;
+    this->chunkState        = ChunkSize;
+    this->chunkLeft         = 0;
+    this->chunkedLength     = 0;
+
     std::string line = this->ReadLine();
     
     if(line.size() == 0)
         return false;
 
+    HTTPTransaction *transaction = this->transfers.empty() ? NULL : this->transfers.front().transaction;
+    if(transaction)
+        transaction->SetResponseReceivedTime(Time::GetCurrentUTCTimeStrMs());
+
+    /* HTTP/1.1 206 Partial Content */
+    if(!line.compare(0, 5, "HTTP/") && line.find(' ') != std::string::npos)
+        this->statusCode = atoi(line.substr(line.find(' ') + 1).c_str());
+
     while(line.compare("\r\n"))
     {
-        if(!line.compare(0, 14, "Content-Length"))
-            this->contentLength = atoi(line.substr(15,line.size()).c_str());
+        std::string value;
+
+        if(header_value(line, "Content-Length", value))
+        {
+            this->contentLength     = atoi(value.c_str());
+            this->hasContentLength  = true;
+        }
+        else if(header_value(line, "Transfer-Encoding", value))
+        {
+            /* the last coding decides how the body ends, RFC 7230 3.3.3 */
+            size_t coding   = value.find_last_of(',');
+            size_t last     = coding == std::string::npos ? 0 : value.find_first_not_of(" \t", coding + 1);
+
+            /* a list ending in ',' names no last coding, so where the body ends is unknown */
+            if(last == std::string::npos)
+            {
+                this->statusCode        = 0;
+                this->contentLength     = 0;
+                this->hasContentLength  = false;
+                return false;
+            }
+
+            this->isChunked = !strcasecmp(value.c_str() + last, "chunked");
+        }
+
+        if(transaction)
+            transaction->AddHTTPHeaderLine(line);
 
         line = this->ReadLine();
 
@@ -108,31 +204,194 @@ bool            HTTPConnection::ParseHeader     ()
             return false;
     }
 
+    /* Content-Length has to be ignored for a chunked body */
+    if(this->isChunked)
+    {
+        this->contentLength     = 0;
+        this->hasContentLength  = false;
+    }
+
+    if(transaction)
+    {
+        transaction->SetResponseCode(this->statusCode);
+
+        if(this->hasContentLength && this->contentLength == 0)
+            this->ResponseFinished(this->transfers.front().chunk);
+    }
+
     return true;
 }
 std::string     HTTPConnection::ReadLine        ()
 {
-    std::stringstream ss;
-    char c[1];
-    int size = recv(this->httpSocket, c, 1, 0);
+    size_t scanned = this->receiveStart;
 
-    while(size > 0)
+    while(true)
     {
-        ss << c[0];
-        if(c[0] == '\n')
-            break;
+        uint8_t *begin  = this->receiveBuffer + scanned;
+        uint8_t *eol    = (uint8_t *) memchr(begin, '\n', this->receiveEnd - scanned);
+
+        if(eol != NULL)
+        {
+            std::string line((const char *) this->receiveBuffer + this->receiveStart, eol + 1 - (this->receiveBuffer + this->receiveStart));
+            this->receiveStart += line.size();
+            return line;
+        }
+
+        size_t offset   = scanned - this->receiveStart;
+        if(!this->FillBuffer())
+            return "";
 
-        size = recv(this->httpSocket, c, 1, 0);
+        scanned         = this->receiveStart + offset;
+    }
+}
+int             HTTPConnection::Receive         (uint8_t *data, size_t len)
+{
+    if(this->receiveStart == this->receiveEnd)
+    {
+        /* nothing buffered: large reads skip the buffer */
+        if(len >= RECEIVEBUFFER)
+            return this->ReceiveSocket(data, len);
+
+        if(!this->FillBuffer())
+            return 0;
     }
 
-    if(size > 0)
-        return ss.str();
+    size_t size = this->receiveEnd - this->receiveStart;
+    if(size > len)
+        size = len;
 
-    return "";
+    memcpy(data, this->receiveBuffer + this->receiveStart, size);
+    this->receiveStart += size;
+
+    return size;
+}
+int             HTTPConnection::ReadBody        (uint8_t *data, size_t len, IChunk *chunk)
+{
+    if(!this->isChunked)
+        return this->Receive(data, len);
+
+    while(this->chunkState != ChunkData)
+    {
+        if(this->chunkState == ChunkDone)
+            return 0;
+
+        std::string line = this->ReadLine();
+        if(line.size() == 0)
+            return -1;
+
+        switch(this->chunkState)
+        {
+            case ChunkSize:
+                /* chunk-size [; chunk-ext] CRLF */
+                this->chunkLeft     = strtoull(line.c_str(), NULL, 16);
+                this->chunkState    = this->chunkLeft > 0 ? ChunkData : ChunkTrailer;
+                break;
+            case ChunkEnd:
+                if(line.compare("\r\n"))
+                    return -1;
+
+                this->chunkState = ChunkSize;
+                break;
+            case ChunkTrailer:
+                /* trailer fields up to the empty line */
+                if(line.compare("\r\n"))
+                    break;
+
+                this->chunkState    = ChunkDone;
+                this->contentLength = (int) this->chunkedLength;
+                this->ResponseFinished(chunk);
+                return 0;
+            default:
+                break;
+        }
+    }
+
+    if(len > this->chunkLeft)
+        len = (size_t) this->chunkLeft;
+
+    int size = this->Receive(data, len);
+    if(size <= 0)
+        return size;
+
+    this->chunkLeft     -= size;
+    this->chunkedLength += size;
+
+    if(this->chunkLeft == 0)
+        this->chunkState = ChunkEnd;
+
+    return size;
+}
+bool            HTTPConnection::FillBuffer      ()
+{
+    if(this->receiveStart == this->receiveEnd)
+    {
+        this->receiveStart  = 0;
+        this->receiveEnd    = 0;
+    }
+    else if(this->receiveEnd == RECEIVEBUFFER)
+    {
+        if(this->receiveStart == 0)
+            return false;
+
+        memmove(this->receiveBuffer, this->receiveBuffer + this->receiveStart, this->receiveEnd - this->receiveStart);
+        this->receiveEnd    -= this->receiveStart;
+        this->receiveStart  = 0;
+    }
+
+    int size = this->ReceiveSocket(this->receiveBuffer + this->receiveEnd, RECEIVEBUFFER - this->receiveEnd);
+    if(size <= 0)
+        return false;
+
+    this->receiveEnd += size;
+    return true;
+}
+bool            HTTPConnection::HeaderBuffered  ()
+{
+    static const char end[] = "\r\n\r\n";
+
+    while(true)
+    {
+        uint8_t *begin  = this->receiveBuffer + this->receiveStart;
+        uint8_t *last   = this->receiveBuffer + this->receiveEnd;
+
+        if(std::search(begin, last, end, end + 4) != last)
+            return true;
+
+        if(!this->FillBuffer())
+            return false;
+    }
+}
+int             HTTPConnection::ReceiveSocket   (uint8_t *data, size_t len)
+{
+    int size = recv(this->httpSocket, (char *)data, len, this->isNonBlocking ? MSG_DONTWAIT : 0);
+
+    if(size < 0 && this->isNonBlocking && (errno == EAGAIN || errno == EWOULDBLOCK))
+        this->wouldBlock = true;
+
+    return size;
+}
+int             HTTPConnection::Descriptor      ()
+{
+    return this->httpSocket;
+}
+int             HTTPConnection::ReadNonBlocking (uint8_t *data, size_t len, IChunk *chunk)
+{
+    this->isNonBlocking = true;
+    this->wouldBlock    = false;
+
+    int ret = this->Read(data, len, chunk);
+
+    this->isNonBlocking = false;
+    return ret;
 }
 bool            HTTPConnection::SendData        (std::string data)
 {
+    /* a keep-alive connection the server has closed must fail the send, not raise SIGPIPE */
+#if defined MSG_NOSIGNAL
+    int size = send(this->httpSocket, data.c_str(), data.size(), MSG_NOSIGNAL);
+#else
     int size = send(this->httpSocket, data.c_str(), data.size(), 0);
+#endif
     
     if(size == -1)
         return false;
@@ -143,6 +402,9 @@ bool            HTTPConnection::SendData        (std::string data)
 }
 void            HTTPConnection::CloseSocket     ()
 {
+    if(this->tcpConnections.size() > 0)
+        ((TCPConnection *) this->tcpConnections.back())->SetConnectionClosedTime(Time::GetCurrentUTCTimeStrMs());
+
     closesocket(this->httpSocket);
     WSACleanup();
 }
@@ -153,8 +415,19 @@ bool            HTTPConnection::ConnectToHost   (std::string host, int port)
     if(WSAStartup(MAKEWORD(2,0), &info))
       return false;
 
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    /* bytes left from an earlier socket belong to nothing sent on this one */
+    this->receiveStart  = 0;
+    this->receiveEnd    = 0;
+
     this->httpSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
 
+#if defined SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(this->httpSocket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
     memset(&this->addr, 0, sizeof(this->addr));
 
     this->hostent           = gethostbyname(host.c_str());
@@ -172,6 +445,22 @@ bool            HTTPConnection::ConnectToHost   (std::string host, int port)
 
     }while(result == 1);
 
+    std::chrono::duration<double, std::milli> connectTime = std::chrono::steady_clock::now() - start;
+    std::stringstream destination;
+    destination << inet_ntoa(this->addr.sin_addr) << ":" << port;
+
+    TCPConnection *connection = new TCPConnection();
+    connection->SetTCPId(next_tcp_id++);
+    connection->SetDestinationAddress(destination.str());
+    connection->SetConnectionOpenedTime(Time::GetCurrentUTCTimeStrMs());
+    connection->SetConnectionTime((uint64_t) connectTime.count());
+    this->tcpConnections.push_back(connection);
+
+    if(this->metricsLog)
+        this->metricsLog->WriteConnection(connection);
+
+    this->DropOldMetrics();
+
     return true;
 }
 bool            HTTPConnection::Schedule        (IChunk *chunk)
@@ -183,6 +472,7 @@ bool            HTTPConnection::Schedule        (IChunk *chunk)
 
     if(this->SendData(this->PrepareRequest(chunk)))
     {
+        this->RequestSent(chunk);
         this->isScheduled = this->ParseHeader();
         return this->isScheduled;
     }
@@ -190,6 +480,144 @@ bool            HTTPConnection::Schedule        (IChunk *chunk)
     return false;
 }
 
+int             HTTPConnection::LastStatusCode      () const
+{
+    return this->statusCode;
+}
+int             HTTPConnection::LastContentLength   () const
+{
+    return this->contentLength;
+}
+
+size_t          HTTPConnection::LastTransferBytes   () const
+{
+    return this->lastTransferBytes;
+}
+double          HTTPConnection::LastTransferSeconds () const
+{
+    return this->lastTransferSeconds;
+}
+void            HTTPConnection::SetMetricsLog       (HTTPMetricsLog *log)
+{
+    this->metricsLog = log;
+}
+void            HTTPConnection::RequestSent         (IChunk *chunk)
+{
+    HTTPTransaction *transaction = new HTTPTransaction();
+
+    transaction->SetTCPId(this->tcpConnections.size() > 0 ? this->tcpConnections.back()->TCPId() : 0);
+    transaction->SetType(chunk->GetType());
+    transaction->SetOriginalUrl(chunk->AbsoluteURI());
+    transaction->SetActualUrl(chunk->AbsoluteURI());
+    transaction->SetRange(chunk->HasByteRange() ? chunk->Range() : "");
+    transaction->SetRequestSentTime(Time::GetCurrentUTCTimeStrMs());
+    transaction->SetInterval(THROUGHPUT_TRACE_INTERVAL);
+    this->httpTransactions.push_back(transaction);
+
+    Transfer transfer;
+    transfer.chunk          = chunk;
+    transfer.transaction    = transaction;
+    transfer.trace          = NULL;
+    transfer.sent           = std::chrono::steady_clock::now();
+    transfer.traceBytes     = 0;
+    transfer.bytes          = 0;
+    this->transfers.push_back(transfer);
+}
+void            HTTPConnection::BytesReceived       (size_t len)
+{
+    if(this->transfers.empty())
+        return;
+
+    Transfer                                &transfer   = this->transfers.front();
+    std::chrono::steady_clock::time_point   now         = std::chrono::steady_clock::now();
+
+    if(transfer.trace && now - transfer.traceStart >= std::chrono::milliseconds(THROUGHPUT_TRACE_INTERVAL))
+        this->CloseTrace(transfer, now);
+
+    if(transfer.trace == NULL)
+    {
+        transfer.trace      = new ThroughputMeasurement();
+        transfer.traceStart = now;
+        transfer.traceBytes = 0;
+        transfer.trace->SetStartOfPeriod(Time::GetCurrentUTCTimeStrMs());
+    }
+
+    transfer.traceBytes += len;
+    transfer.bytes      += len;
+
+    if(this->hasContentLength && transfer.bytes >= (size_t) this->contentLength)
+        this->ResponseFinished(transfer.chunk);
+}
+void            HTTPConnection::ResponseFinished    (IChunk *chunk)
+{
+    size_t i = 0;
+    while(i < this->transfers.size() && this->transfers.at(i).chunk != chunk)
+        i++;
+
+    if(i == this->transfers.size())
+        return;
+
+    Transfer transfer = this->transfers.at(i);
+    this->transfers.erase(this->transfers.begin() + i);
+
+    std::chrono::steady_clock::time_point now   = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point start = transfer.sent > this->lastCompleted ? transfer.sent : this->lastCompleted;
+    std::chrono::duration<double> seconds = now - start;
+
+    this->CloseTrace(transfer, now);
+    transfer.transaction->SetResponseFinishedTime(Time::GetCurrentUTCTimeStrMs());
+
+    this->lastCompleted         = now;
+    this->lastTransferBytes     = transfer.bytes;
+    this->lastTransferSeconds   = seconds.count();
+
+    if(this->metricsLog)
+        this->metricsLog->WriteTransaction(transfer.transaction);
+
+    this->DropOldMetrics();
+}
+void            HTTPConnection::CloseTrace          (Transfer &transfer, std::chrono::steady_clock::time_point now)
+{
+    if(transfer.trace == NULL)
+        return;
+
+    std::chrono::duration<double, std::milli> duration = now - transfer.traceStart;
+
+    transfer.trace->SetDurationOfPeriod((uint64_t) duration.count());
+    transfer.trace->AddReceivedBytes(transfer.traceBytes);
+    transfer.transaction->AddThroughputMeasurement(transfer.trace);
+    transfer.trace = NULL;
+}
+
+void            HTTPConnection::DropOldMetrics      ()
+{
+    /* the current TCP connection stays, it is the last one */
+    while(this->tcpConnections.size() > METRICS_HISTORY)
+    {
+        delete(this->tcpConnections.front());
+        this->tcpConnections.erase(this->tcpConnections.begin());
+    }
+
+    /* transactions still on the wire are filled in by their Transfer */
+    size_t i = 0;
+    while(this->httpTransactions.size() > METRICS_HISTORY + this->transfers.size() && i < this->httpTransactions.size())
+    {
+        bool inFlight = false;
+        for(size_t k = 0; k < this->transfers.size(); k++)
+            if(this->transfers.at(k).transaction == this->httpTransactions.at(i))
+                inFlight = true;
+
+        if(inFlight)
+        {
+            i++;
+            continue;
+        }
+
+        delete(this->httpTransactions.at(i));
+        this->httpTransactions.erase(this->httpTransactions.begin() + i);
+    }
+}
+
 const std::vector<ITCPConnection *>&        HTTPConnection::GetTCPConnectionList    () const
 {
     return tcpConnections;
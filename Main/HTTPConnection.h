@@ -13,16 +13,25 @@
 #define HTTPCONNECTION_H_
 
 #include "../libdash/source/portable/Networking.h"
-#include "IConnection.h"
+#include "../libdash/source/metrics/HTTPTransaction.h"
+#include "../libdash/source/metrics/TCPConnection.h"
+#include "../libdash/source/metrics/ThroughputMeasurement.h"
+#include "IAsyncConnection.h"
+#include "HTTPMetricsLog.h"
 
+#include <chrono>
+#include <deque>
 #include <sstream>
 #include <stdint.h>
 
-#define PEEKBUFFER 4096
+#define PEEKBUFFER                  4096
+#define RECEIVEBUFFER               16384   /* longest header line; smaller body reads are served from it */
+#define THROUGHPUT_TRACE_INTERVAL   100     /* ms of received bytes summed up per trace entry */
+#define METRICS_HISTORY             32      /* completed transactions and closed TCP connections kept for IDASHMetrics */
 
 namespace libdashtest
 {
-    class HTTPConnection : public dash::network::IConnection
+    class HTTPConnection : public dash::network::IAsyncConnection
     {
         public:
             HTTPConnection          ();
@@ -35,7 +44,41 @@ namespace libdashtest
             virtual void    CloseSocket ();
 
             /*
-             *  IDASHMetrics
+             *  IAsyncConnection: the same Read() with every recv() done as
+             *  MSG_DONTWAIT, so the socket itself stays blocking for Read().
+             */
+            virtual int     Descriptor      ();
+            virtual int     ReadNonBlocking (uint8_t *data, size_t len, dash::network::IChunk *chunk);
+
+            /*
+             *  Status line and Content-Length of the response header parsed
+             *  last, i.e. of the response currently being read. A chunked
+             *  body has its decoded size as Content-Length once its last
+             *  chunk was read, 0 before.
+             */
+            int             LastStatusCode      () const;
+            int             LastContentLength   () const;
+
+            /*
+             *  Size and duration of the response completed last. The time
+             *  runs from when the connection started serving it, i.e. the
+             *  request was sent or, if it was pipelined, the previous
+             *  response was complete, to its last byte.
+             */
+            size_t          LastTransferBytes   () const;
+            double          LastTransferSeconds () const;
+
+            /*
+             *  Every connection and completed transaction is also written
+             *  to log, which has to outlive the connection.
+             */
+            void            SetMetricsLog       (HTTPMetricsLog *log);
+
+            /*
+             *  IDASHMetrics, one entry per TCP connection and per request.
+             *  A keep-alive connection serves any number of requests, so
+             *  only the newest METRICS_HISTORY completed entries are kept,
+             *  the metrics log has all of them.
              */
             const std::vector<dash::metrics::ITCPConnection *>&     GetTCPConnectionList    () const;
             const std::vector<dash::metrics::IHTTPTransaction *>&   GetHTTPTransactionList  () const;
@@ -47,16 +90,73 @@ namespace libdashtest
             uint8_t             *peekBuffer;
             size_t              peekBufferLen;
             int                 contentLength;
+            int                 statusCode;
             bool                isInit;
             bool                isScheduled;
 
+            /*
+             *  Everything is received through one buffer: header lines are
+             *  parsed in place and body bytes behind the header are handed
+             *  to Read() from there, larger reads go to the socket directly.
+             */
+            uint8_t             *receiveBuffer;
+            size_t              receiveStart;   /* first byte not consumed yet */
+            size_t              receiveEnd;
+            bool                isNonBlocking;  /* inside ReadNonBlocking() */
+            bool                wouldBlock;     /* a non-blocking recv() found nothing to read */
+
+            /* where a chunked body is, a line is only consumed once it arrived completely */
+            enum ChunkState
+            {
+                ChunkSize,
+                ChunkData,
+                ChunkEnd,       /* CRLF behind the chunk data */
+                ChunkTrailer,
+                ChunkDone
+            };
+
+            bool                isChunked;      /* Transfer-Encoding: chunked */
+            ChunkState          chunkState;
+            uint64_t            chunkLeft;      /* bytes of the current chunk not read yet */
+            uint64_t            chunkedLength;  /* decoded body bytes so far */
+
             std::vector<dash::metrics::ITCPConnection *>    tcpConnections;
             std::vector<dash::metrics::IHTTPTransaction *>  httpTransactions;
 
+            /* a request on the wire whose response is not complete yet */
+            struct Transfer
+            {
+                dash::network::IChunk                   *chunk;
+                dash::metrics::HTTPTransaction          *transaction;
+                dash::metrics::ThroughputMeasurement    *trace;         /* entry being summed up */
+                std::chrono::steady_clock::time_point   sent;
+                std::chrono::steady_clock::time_point   traceStart;
+                uint32_t                                traceBytes;
+                size_t                                  bytes;
+            };
+
+            std::deque<Transfer>                    transfers;      /* in request order */
+            bool                                    hasContentLength;
+            std::chrono::steady_clock::time_point   lastCompleted;
+            size_t                                  lastTransferBytes;
+            double                                  lastTransferSeconds;
+            HTTPMetricsLog                          *metricsLog;
+
+            void                RequestSent         (dash::network::IChunk *chunk);
+            void                BytesReceived       (size_t len);
+            void                ResponseFinished    (dash::network::IChunk *chunk);
+            void                CloseTrace          (Transfer &transfer, std::chrono::steady_clock::time_point now);
+            void                DropOldMetrics      ();
+
             virtual std::string PrepareRequest  (dash::network::IChunk *chunk);
             virtual bool        SendData        (std::string data);
             virtual bool        ParseHeader     ();
             virtual std::string ReadLine        ();
+            int                 Receive         (uint8_t *data, size_t len);
+            int                 ReadBody        (uint8_t *data, size_t len, dash::network::IChunk *chunk);
+            bool                FillBuffer      ();
+            bool                HeaderBuffered  ();
+            int                 ReceiveSocket   (uint8_t *data, size_t len);
             virtual bool        ConnectToHost   (std::string host, int port);
     };
 }
@@ -0,0 +1,107 @@
+/*
+ * HTTPMetricsLog.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "HTTPMetricsLog.h"
+
+#include <sstream>
+#include <stdio.h>
+
+using namespace libdashtest;
+using namespace dash::metrics;
+
+static const char *transaction_types[] = { "MPD", "XLink", "InitializationSegment", "IndexSegment",
+                                           "MediaSegment", "BitstreamSwitchingSegment", "other" };
+
+HTTPMetricsLog::HTTPMetricsLog  (const std::string &path) :
+                out             (path.c_str(), std::ios::out | std::ios::app)
+{
+}
+HTTPMetricsLog::~HTTPMetricsLog ()
+{
+}
+
+bool    HTTPMetricsLog::IsOpen              () const
+{
+    return this->out.is_open();
+}
+void    HTTPMetricsLog::WriteConnection     (const ITCPConnection *connection)
+{
+    std::stringstream line;
+
+    line << "{\"TcpList\":{\"tcpid\":" << connection->TCPId() << ",\"dest\":";
+    WriteString(line, connection->DestinationAddress());
+    line << ",\"topen\":";
+    WriteString(line, connection->ConnectionOpenedTime());
+    line << ",\"tconnect\":" << connection->ConnectionTime() << "}}\n";
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+    this->out << line.str();
+    this->out.flush();
+}
+void    HTTPMetricsLog::WriteTransaction    (const IHTTPTransaction *transaction)
+{
+    std::stringstream line;
+
+    line << "{\"HttpList\":{\"tcpid\":" << transaction->TCPId() << ",\"type\":";
+    WriteString(line, transaction_types[transaction->Type() <= Other ? transaction->Type() : Other]);
+    line << ",\"url\":";
+    WriteString(line, transaction->OriginalUrl());
+    line << ",\"actualurl\":";
+    WriteString(line, transaction->ActualUrl());
+    line << ",\"range\":";
+    WriteString(line, transaction->Range());
+    line << ",\"trequest\":";
+    WriteString(line, transaction->RequestSentTime());
+    line << ",\"tresponse\":";
+    WriteString(line, transaction->ResponseReceivedTime());
+    line << ",\"tfin\":";
+    WriteString(line, transaction->ResponseFinishedTime());
+    line << ",\"responsecode\":" << transaction->ResponseCode()
+         << ",\"interval\":" << transaction->Interval() << ",\"trace\":[";
+
+    const std::vector<IThroughputMeasurement *> &trace = transaction->ThroughputTrace();
+    for(size_t i = 0; i < trace.size(); i++)
+    {
+        line << (i > 0 ? ",{\"s\":" : "{\"s\":");
+        WriteString(line, trace.at(i)->StartOfPeriod());
+        line << ",\"d\":" << trace.at(i)->DurationOfPeriod() << ",\"b\":[";
+
+        const std::vector<uint32_t> &bytes = trace.at(i)->ReceivedBytesPerTrace();
+        for(size_t j = 0; j < bytes.size(); j++)
+            line << (j > 0 ? "," : "") << bytes.at(j);
+
+        line << "]}";
+    }
+    line << "]}}\n";
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+    this->out << line.str();
+    this->out.flush();
+}
+void    HTTPMetricsLog::WriteString         (std::ostream &out, const std::string &value)
+{
+    out << '"';
+    for(size_t i = 0; i < value.size(); i++)
+    {
+        unsigned char c = value.at(i);
+
+        if(c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if(c < 0x20)
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
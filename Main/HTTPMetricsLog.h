@@ -0,0 +1,42 @@
+/*
+ * HTTPMetricsLog.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Writes the TcpList and HttpList metrics of ISO/IEC 23009-1 Annex D as
+ * JSON lines: one object per TCP connection once it is established and one
+ * per HTTP transaction once its last byte arrived. Keys are the Annex D
+ * names. One log is shared by all connections.
+ *****************************************************************************/
+
+#ifndef HTTPMETRICSLOG_H_
+#define HTTPMETRICSLOG_H_
+
+#include "IHTTPTransaction.h"
+#include "ITCPConnection.h"
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace libdashtest
+{
+    class HTTPMetricsLog
+    {
+        public:
+            HTTPMetricsLog          (const std::string &path);
+            virtual ~HTTPMetricsLog ();
+
+            bool    IsOpen              () const;
+            void    WriteConnection     (const dash::metrics::ITCPConnection *connection);
+            void    WriteTransaction    (const dash::metrics::IHTTPTransaction *transaction);
+
+        private:
+            std::ofstream   out;
+            std::mutex      monitorMutex;
+
+            static void     WriteString (std::ostream &out, const std::string &value);
+    };
+}
+
+#endif /* HTTPMETRICSLOG_H_ */
@@ -0,0 +1,470 @@
+/*
+ * LiveMPDManager.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "LiveMPDManager.h"
+#include "TestChunk.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <math.h>
+#include <stdint.h>
+#include <sstream>
+#include <stdio.h>
+#include <time.h>
+
+#define FETCH_READ_SIZE 32768
+
+using namespace libdashtest;
+using namespace dash;
+using namespace dash::mpd;
+
+static double   now_seconds ()
+{
+    std::chrono::duration<double> since = std::chrono::system_clock::now().time_since_epoch();
+    return since.count();
+}
+
+LiveMPDManager::LiveMPDManager  (const std::string &host, size_t port, const std::string &mpdPath) :
+                host            (host),
+                port            (port),
+                mpdPath         (mpdPath),
+                mpd             (NULL),
+                metricsLog      (NULL),
+                isRunning       (false)
+{
+    this->manager       = CreateDashManager();
+    this->connection    = new PersistentHTTPConnection();
+    this->stats         = LiveMPDStats();
+}
+LiveMPDManager::~LiveMPDManager ()
+{
+    this->Stop();
+
+    delete(this->connection);
+    delete(this->mpd);
+    delete(this->manager);
+}
+
+bool                LiveMPDManager::Open                (const std::vector<uint8_t> &document)
+{
+    if(this->mpd != NULL || document.empty())
+        return false;
+
+    this->mpd = this->Parse(this->mpdPath, document);
+
+    return this->mpd != NULL && this->Representation(0) != NULL;
+}
+void                LiveMPDManager::Start               ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(this->isRunning || this->mpd == NULL || this->mpd->GetType() != "dynamic")
+        return;
+
+    this->isRunning = true;
+    this->refresher = std::thread(&LiveMPDManager::Refresh, this);
+}
+void                LiveMPDManager::Stop                ()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->monitorMutex);
+        this->isRunning = false;
+    }
+    this->wakeUp.notify_all();
+    this->refreshed.notify_all();
+
+    if(this->refresher.joinable())
+        this->refresher.join();
+}
+void                LiveMPDManager::SetMetricsLog       (HTTPMetricsLog *log)
+{
+    this->metricsLog = log;
+    this->connection->SetMetricsLog(log);
+}
+bool                LiveMPDManager::IsDynamic           ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    return this->mpd != NULL && this->mpd->GetType() == "dynamic";
+}
+bool                LiveMPDManager::AvailableSegments   (size_t representation, size_t &first, size_t &end)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    double wait = 0;
+    return this->Window(representation, 0, first, end, wait);
+}
+bool                LiveMPDManager::LiveEdge            (size_t representation, size_t &number)
+{
+    size_t first    = 0;
+    size_t end      = 0;
+    if(!this->AvailableSegments(representation, first, end) || end == SIZE_MAX)
+        return false;
+
+    number = end > first ? end - 1 : first;
+    return true;
+}
+bool                LiveMPDManager::WaitForSegment      (size_t representation, size_t number, double timeout)
+{
+    std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout));
+
+    while(true)
+    {
+        size_t  first   = 0;
+        size_t  end     = 0;
+        double  wait    = 0;
+        if(!this->Window(representation, number, first, end, wait) || number < first)
+            return false;
+
+        if(number < end)
+            return true;
+
+        /* due but not listed yet, and no refresh is going to list it */
+        if(!this->isRunning && wait <= 0)
+            return false;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now >= deadline)
+            return false;
+
+        std::chrono::steady_clock::time_point wake = deadline;
+        if(wait > 0)
+        {
+            std::chrono::steady_clock::time_point due = now +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(wait));
+            if(due < wake)
+                wake = due;
+        }
+
+        this->refreshed.wait_until(lock, wake);
+    }
+}
+bool                LiveMPDManager::SegmentMedia        (size_t representation, size_t number, std::string &media)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    IRepresentation *rep = this->Representation(representation);
+    if(rep == NULL)
+        return false;
+
+    if(rep->GetSegmentList() == NULL)
+    {
+        ISegmentTemplate *segmentTemplate = this->Template(representation);
+
+        return segmentTemplate != NULL &&
+               segmentTemplate->GetMediaURIFromNumber(media, rep->GetId(), rep->GetBandwidth(), segmentTemplate->GetStartNumber() + number);
+    }
+
+    ISegmentList    *list   = rep->GetSegmentList();
+    size_t          start   = list->GetStartNumber() > 0 ? list->GetStartNumber() - 1 : 0;
+    if(number < start || number - start >= list->GetSegmentURLs().size())
+        return false;
+
+    media = list->GetSegmentURLs().at(number - start)->GetMediaURI();
+    return true;
+}
+LiveMPDStats        LiveMPDManager::Stats               ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    return this->stats;
+}
+double              LiveMPDManager::ParseDuration       (const std::string &duration)
+{
+    /* PnYnMnDTnHnMnS; years and months are never used for live timing, take them as 365 and 30 days */
+    double  seconds = 0;
+    bool    isTime  = false;
+    size_t  pos     = duration.find('P');
+
+    if(pos == std::string::npos)
+        return 0;
+
+    for(pos = pos + 1; pos < duration.size(); pos++)
+    {
+        if(duration.at(pos) == 'T')
+        {
+            isTime = true;
+            continue;
+        }
+
+        char    *end    = NULL;
+        double  value   = strtod(duration.c_str() + pos, &end);
+        if(end == duration.c_str() + pos || *end == '\0')
+            break;
+
+        switch(*end)
+        {
+            case 'Y':   seconds += value * 365 * 86400;                 break;
+            case 'M':   seconds += isTime ? value * 60 : value * 30 * 86400;   break;
+            case 'W':   seconds += value * 7 * 86400;                   break;
+            case 'D':   seconds += value * 86400;                       break;
+            case 'H':   seconds += value * 3600;                        break;
+            case 'S':   seconds += value;                               break;
+            default:    return seconds;
+        }
+
+        pos = end - duration.c_str();
+    }
+
+    return seconds;
+}
+double              LiveMPDManager::ParseDateTime       (const std::string &dateTime)
+{
+    /* YYYY-MM-DDThh:mm:ss[.fff][Z|+hh:mm|-hh:mm], no zone is taken as UTC */
+    struct tm   time    = {};
+    int         length  = 0;
+    if(sscanf(dateTime.c_str(), "%d-%d-%dT%d:%d:%d%n", &time.tm_year, &time.tm_mon, &time.tm_mday,
+                                                    &time.tm_hour, &time.tm_min, &time.tm_sec, &length) < 6)
+        return 0;
+
+    time.tm_year    -= 1900;
+    time.tm_mon     -= 1;
+
+    double      seconds = (double) timegm(&time);
+    const char  *rest   = dateTime.c_str() + length;
+
+    if(*rest == '.')
+    {
+        char *end = NULL;
+        seconds += strtod(rest, &end);
+        rest = end;
+    }
+
+    int hours   = 0;
+    int minutes = 0;
+    if((*rest == '+' || *rest == '-') && sscanf(rest + 1, "%d:%d", &hours, &minutes) == 2)
+    {
+        double offset = hours * 3600 + minutes * 60;
+        seconds += *rest == '+' ? -offset : offset;
+    }
+
+    return seconds;
+}
+void                LiveMPDManager::Refresh             ()
+{
+    std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+    while(this->isRunning && this->mpd->GetType() == "dynamic")
+    {
+        /* without minimumUpdatePeriod the MPD does not change any more */
+        if(this->mpd->GetMinimumUpdatePeriod().empty())
+        {
+            this->wakeUp.wait(lock, [this] { return !this->isRunning; });
+            break;
+        }
+
+        std::chrono::duration<double> period(this->UpdatePeriod());
+        if(this->wakeUp.wait_for(lock, period, [this] { return !this->isRunning; }))
+            break;
+
+        lock.unlock();
+        this->Update();
+        lock.lock();
+    }
+}
+bool                LiveMPDManager::Update              ()
+{
+    std::string patchPath;
+    std::string mpdPath;
+    {
+        std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+        patchPath   = this->PatchPath();
+        mpdPath     = this->mpd->GetLocations().size() > 0 ? this->ResolvePath(this->mpd->GetLocations().at(0)) : this->mpdPath;
+    }
+
+    std::vector<uint8_t> data;
+    if(!patchPath.empty())
+    {
+        bool isDownloaded = this->Download(patchPath, data);
+
+        std::lock_guard<std::mutex> lock(this->monitorMutex);
+        if(isDownloaded && this->manager->Patch(this->mpd, data.data(), data.size()))
+        {
+            this->stats.patches++;
+            this->refreshed.notify_all();
+            return true;
+        }
+
+        this->stats.failedPatches++;
+    }
+
+    IMPD *fresh = this->Fetch(mpdPath);
+
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+    if(fresh == NULL)
+    {
+        this->stats.failedRefreshes++;
+        return false;
+    }
+
+    delete(this->mpd);
+    this->mpd = fresh;
+
+    this->stats.fullRefreshes++;
+    this->refreshed.notify_all();
+    return true;
+}
+IMPD*               LiveMPDManager::Fetch               (const std::string &path)
+{
+    std::vector<uint8_t> data;
+    if(!this->Download(path, data))
+        return NULL;
+
+    return this->Parse(path, data);
+}
+IMPD*               LiveMPDManager::Parse               (const std::string &path, const std::vector<uint8_t> &data)
+{
+    std::stringstream url;
+    url << "http://" << this->host << ":" << this->port << path;
+
+    return this->manager->Open(data.data(), data.size(), url.str());
+}
+bool                LiveMPDManager::Download            (const std::string &path, std::vector<uint8_t> &data)
+{
+    TestChunk chunk(this->host, this->port, path, 0, 0, false, dash::metrics::MPD);
+
+    if(this->connection->Init(&chunk))
+        this->connection->Schedule(&chunk);
+
+    int     ret     = 0;
+    size_t  size    = 0;
+    do
+    {
+        data.resize(size + FETCH_READ_SIZE);
+        ret = this->connection->Read(data.data() + size, FETCH_READ_SIZE, &chunk);
+        if(ret > 0)
+            size += ret;
+    }while(ret > 0);
+    data.resize(size);
+
+    int status = this->connection->LastStatusCode();
+    if(ret < 0 || status != 200 || size != (size_t) this->connection->LastContentLength())
+    {
+        std::cerr << "LiveMPDManager: " << path << " failed with status " << status << std::endl;
+
+        /* start the next request on a fresh connection */
+        delete(this->connection);
+        this->connection = new PersistentHTTPConnection();
+        this->connection->SetMetricsLog(this->metricsLog);
+        return false;
+    }
+
+    return true;
+}
+std::string         LiveMPDManager::ResolvePath         (const std::string &url) const
+{
+    /* absolute URLs are fetched from this->host as well, only their path is used */
+    size_t scheme = url.find("://");
+    if(scheme != std::string::npos)
+    {
+        size_t path = url.find('/', scheme + 3);
+        return path == std::string::npos ? "/" : url.substr(path);
+    }
+
+    if(!url.empty() && url.at(0) == '/')
+        return url;
+
+    return this->mpdPath.substr(0, this->mpdPath.rfind('/') + 1) + url;
+}
+std::string         LiveMPDManager::PatchPath           ()
+{
+    const std::vector<IPatchLocation *> &locations = this->mpd->GetPatchLocations();
+    if(locations.empty() || locations.at(0)->GetUrl().empty())
+        return "";
+
+    /* a patch is only valid for ttl seconds after the MPD was published */
+    IPatchLocation *location = locations.at(0);
+    if(location->GetTtl() > 0 && now_seconds() > ParseDateTime(this->mpd->GetPublishTime()) + location->GetTtl())
+        return "";
+
+    return this->ResolvePath(location->GetUrl());
+}
+double              LiveMPDManager::UpdatePeriod        ()
+{
+    double period = ParseDuration(this->mpd->GetMinimumUpdatePeriod());
+
+    return period > LIVE_MIN_UPDATE_PERIOD ? period : LIVE_MIN_UPDATE_PERIOD;
+}
+bool                LiveMPDManager::Window              (size_t representation, size_t number, size_t &first, size_t &end, double &wait)
+{
+    IRepresentation         *rep        = this->Representation(representation);
+    IMultipleSegmentBase    *segments   = NULL;
+    if(rep == NULL)
+        return false;
+
+    if(rep->GetSegmentList() != NULL)
+    {
+        ISegmentList *list = rep->GetSegmentList();
+
+        segments    = list;
+        first       = list->GetStartNumber() > 0 ? list->GetStartNumber() - 1 : 0;
+        end         = first + list->GetSegmentURLs().size();
+    }
+    else
+    {
+        ISegmentTemplate *segmentTemplate = this->Template(representation);
+        if(segmentTemplate == NULL)
+            return false;
+
+        /* a $Number$ template without SegmentTimeline describes segments without end */
+        segments    = segmentTemplate;
+        first       = 0;
+        end         = segmentTemplate->GetSegmentTimeline() ? segmentTemplate->GetSegmentTimeline()->GetSegmentCount() : SIZE_MAX;
+    }
+
+    wait = -1;
+
+    uint32_t    timescale   = segments->GetTimescale() > 0 ? segments->GetTimescale() : 1;
+    double      duration    = (double) segments->GetDuration() / timescale;
+
+    /* a static MPD or one without segment durations lists only what is available */
+    if(this->mpd->GetType() != "dynamic" || duration <= 0 || this->mpd->GetAvailabilityStarttime().empty())
+        return true;
+
+    double elapsed = now_seconds() - ParseDateTime(this->mpd->GetAvailabilityStarttime())
+                                   - ParseDuration(this->mpd->GetPeriods().at(0)->GetStart());
+
+    double produced = elapsed > 0 ? floor(elapsed / duration) : 0;
+    if(produced < end)
+        end = (size_t) produced;
+
+    double depth = ParseDuration(this->mpd->GetTimeShiftBufferDepth());
+    if(depth > 0 && elapsed > depth && floor((elapsed - depth) / duration) > first)
+        first = (size_t) floor((elapsed - depth) / duration);
+
+    if(first > end)
+        first = end;
+
+    wait = (number + 1) * duration - elapsed;
+    if(wait < 0)
+        wait = 0;
+
+    return true;
+}
+IRepresentation*    LiveMPDManager::Representation      (size_t representation)
+{
+    if(this->mpd == NULL || this->mpd->GetPeriods().empty() ||
+       this->mpd->GetPeriods().at(0)->GetAdaptationSets().empty())
+        return NULL;
+
+    const std::vector<IRepresentation *> &reps = this->mpd->GetPeriods().at(0)->GetAdaptationSets().at(0)->GetRepresentation();
+    if(representation >= reps.size())
+        return NULL;
+
+    return reps.at(representation);
+}
+ISegmentTemplate*   LiveMPDManager::Template            (size_t representation)
+{
+    if(this->Representation(representation)->GetSegmentTemplate())
+        return this->Representation(representation)->GetSegmentTemplate();
+
+    return this->mpd->GetPeriods().at(0)->GetAdaptationSets().at(0)->GetSegmentTemplate();
+}
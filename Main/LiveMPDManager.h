@@ -0,0 +1,127 @@
+/*
+ * LiveMPDManager.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Keeps a dynamic MPD current while the content is still being produced.
+ * The MPD is refreshed every minimumUpdatePeriod on a background thread.
+ * If it carries a PatchLocation, only the MPD Patch is downloaded and
+ * applied to the parsed MPD in place. The full MPD is downloaded again
+ * when there is no usable patch or a patch does not apply.
+ *
+ * Segment numbers count from the start of the first Period, so SegmentURL
+ * i of a SegmentList is segment startNumber - 1 + i and stays the same
+ * number when old SegmentURLs are removed. With a SegmentTemplate segment
+ * n is $Number$ startNumber + n. Segment n is available from
+ * availabilityStartTime + Period@start + (n + 1) * duration until
+ * timeShiftBufferDepth later.
+ *****************************************************************************/
+
+#ifndef LIVEMPDMANAGER_H_
+#define LIVEMPDMANAGER_H_
+
+#include "libdash.h"
+#include "PersistentHTTPConnection.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+#define LIVE_MIN_UPDATE_PERIOD  0.5     /* seconds between refreshes if minimumUpdatePeriod is shorter */
+
+namespace libdashtest
+{
+    struct LiveMPDStats
+    {
+        size_t  patches;            /* MPD Patches applied */
+        size_t  fullRefreshes;      /* full MPD downloads after the first one */
+        size_t  failedPatches;      /* patches that did not apply, each followed by a full refresh */
+        size_t  failedRefreshes;    /* refreshes that left the MPD unchanged */
+    };
+
+    class LiveMPDManager
+    {
+        public:
+            LiveMPDManager          (const std::string &host, size_t port, const std::string &mpdPath);
+            virtual ~LiveMPDManager ();
+
+            /*
+             *  Takes the MPD document already downloaded from mpdPath, e.g.
+             *  by SegmentFetcher::Open(), so the first download is the
+             *  first refresh.
+             */
+            bool    Open    (const std::vector<uint8_t> &document);
+            /*
+             *  Starts refreshing a dynamic MPD in the background; does
+             *  nothing for a static one.
+             */
+            void    Start   ();
+            void    Stop    ();
+            /*
+             *  Logs the MPD and MPD Patch downloads; set it before Start().
+             */
+            void    SetMetricsLog   (HTTPMetricsLog *log);
+
+            bool    IsDynamic       ();
+            /*
+             *  Segments [first, end) of the representation of the first
+             *  adaptation set that are available now and listed in the MPD.
+             */
+            bool    AvailableSegments   (size_t representation, size_t &first, size_t &end);
+            /*
+             *  Newest available segment, the live edge to start playing at.
+             *  False if the MPD does not tell, e.g. for a $Number$ template
+             *  without SegmentTimeline and availabilityStartTime.
+             */
+            bool    LiveEdge            (size_t representation, size_t &number);
+            /*
+             *  Waits until segment number is available and listed in the
+             *  MPD. Returns false after timeout seconds, or at once if the
+             *  segment already left the time shift buffer.
+             */
+            bool    WaitForSegment      (size_t representation, size_t number, double timeout);
+            bool    SegmentMedia        (size_t representation, size_t number, std::string &media);
+
+            LiveMPDStats    Stats   ();
+
+            static double   ParseDuration   (const std::string &duration);  /* xs:duration in seconds */
+            static double   ParseDateTime   (const std::string &dateTime);  /* xs:dateTime in seconds since the epoch */
+
+        private:
+            std::string                 host;
+            size_t                      port;
+            std::string                 mpdPath;
+            dash::IDASHManager          *manager;
+            dash::mpd::IMPD             *mpd;
+            PersistentHTTPConnection    *connection;
+            HTTPMetricsLog              *metricsLog;
+            LiveMPDStats                stats;
+            bool                        isRunning;
+            std::thread                 refresher;
+            std::mutex                  monitorMutex;
+            std::condition_variable     wakeUp;         /* refresher: stop requested */
+            std::condition_variable     refreshed;      /* WaitForSegment: the MPD changed */
+
+            void                Refresh         ();
+            bool                Update          ();
+            dash::mpd::IMPD*    Fetch           (const std::string &path);
+            dash::mpd::IMPD*    Parse           (const std::string &path, const std::vector<uint8_t> &data);
+            bool                Download        (const std::string &path, std::vector<uint8_t> &data);
+            std::string         ResolvePath     (const std::string &url) const;
+            std::string         PatchPath       ();
+            double              UpdatePeriod    ();
+            /*
+             *  wait is the time until segment number is due, 0 if it is
+             *  already and -1 if the clock does not tell.
+             */
+            bool                Window          (size_t representation, size_t number, size_t &first, size_t &end, double &wait);
+
+            dash::mpd::IRepresentation*     Representation  (size_t representation);
+            dash::mpd::ISegmentTemplate*    Template        (size_t representation);
+    };
+}
+
+#endif /* LIVEMPDMANAGER_H_ */
@@ -6,35 +6,37 @@
 #include <atomic>
 #include <chrono>
 #include <mutex>
-#include <random>
 #include <thread>
 #include <vector>
 #include <experimental/filesystem>
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <climits>
 #include "open3d/Open3D.h"
 #include "libdash.h"
-#include "TestChunk.h"
-#include "PersistentHTTPConnection.h"
+#include "SegmentFetcher.h"
+#include "HTTPMetricsLog.h"
+#include "LiveMPDManager.h"
+#include "AbrController.h"
+#include "SegmentBuffer.h"
+#include "PresentationClock.h"
+#include "DecodeScheduler.h"
+#include "FramePool.h"
+#include "MediaSegment.h"
+#include "SPSCRing.h"
 
 #include <fstream>
 #include <pthread.h>
 #include <cstring>
-#include <semaphore.h>
 #include <cstdlib>
-#include <sys/wait.h>
 #include <sys/stat.h>
 #include <sys/types.h>
-#include <signal.h>
 #include <unistd.h>
-#include <arpa/inet.h>
-#include <sys/socket.h>
 
 #include "IMPD.h"
 #include "INode.h"
 
-#define BUF_SIZE 10
 using namespace open3d;
 using namespace open3d::visualization;
 using namespace std;
@@ -47,76 +49,53 @@ string PATH;
 const int WIDTH = 1024;
 const int HEIGHT = 1024;
 const int PLY_COUNT_PER_BIN = 10; // 10 15 30 = frame
-const int PLY_PER_DIRECTORY = 5; // 10 or 15
 const int BIN_COUNT = 10; // 10 Fix
+const string SERVER_HOST = "203.252.121.219";
+const int SERVER_PORT = 80;
+const string MPD_PATH = "/video/loot.mpd";
+const int FRAME_POOL_SIZE = PLY_COUNT_PER_BIN * 2; // decoded frames in flight
+const int SEGMENT_QUEUE_SIZE = 16; // hard cap on downloaded segments waiting for the decoder
+const int BUFFER_SEGMENTS = 4; // prefetch target in segments unless the MPD's minBufferTime asks for more
+const int FETCH_CONNECTIONS = 4; // keep-alive sockets, large segments are split into one Range: per socket
+const int PIPELINE_DEPTH = 2; // segment requests on the wire ahead of the one being read
+const int DECODE_WORKERS = std::max(1u, std::thread::hardware_concurrency() / 4); // decOpt.txt runs 4 threads per decode
 
 const Eigen::Vector3f CENTER_OFFSET(0.0f, 0.0f, -3.0f);
 const std::string CLOUD_NAME = "points";
-void error_handling(char* message);
-
-typedef struct {
-	sem_t filled;
-	sem_t empty;
-	pthread_mutex_t lock;
-	char ** elem;
-	int capacity;
-	int num;
-	int front;
-	int rear;
-} bounded_buffer;
-
-bounded_buffer * buf1 = 0x0;
-bounded_buffer * buf2 = 0x0;
-
-void bounded_buffer_init(bounded_buffer * buf, int capacity) {
-	sem_init(&(buf->filled), 0, 0);
-	sem_init(&(buf->empty), 0, capacity);
-	pthread_mutex_init(&(buf->lock), 0x0);
-	buf->capacity = capacity;
-	buf->elem = (char **) calloc(sizeof(char *), capacity);
-	buf->num = 0;
-	buf->front = 0;
-	buf->rear = 0;
+void error_handling(const char* message);
+
+// download -> decode -> render, one producer and one consumer per ring
+SPSCRing<MediaSegment *> * segment_queue = 0x0;
+SPSCRing<PointCloudFrame *> * frame_queue = 0x0;
+FramePool * frame_pool = 0x0;
+SegmentBuffer * segment_buffer = 0x0;
+PresentationClock * presentation_clock = 0x0;
+// Created by libdash_thread before the first segment is queued
+AbrController * abr_controller = 0x0;
+
+void print_buffer_stats(ostream & out, const BufferStats & stats) {
+	out << "buffer level " << stats.level << "/" << stats.target << "s"
+		<< " max " << stats.maxLevel << "s"
+		<< " held " << stats.bytesHeld << "B max " << stats.maxBytesHeld << "B"
+		<< " startup " << stats.startupSeconds << "s"
+		<< " stalls " << stats.stalls << " (" << stats.stallSeconds << "s)\n";
 }
 
-void bounded_buffer_queue(bounded_buffer * buf, char * msg) {
-	sem_wait(&(buf->empty));
-	pthread_mutex_lock(&(buf->lock));
-		buf->elem[buf->rear] = msg;
-		buf->rear = (buf->rear + 1) % buf->capacity;
-		buf->num += 1;
-	pthread_mutex_unlock(&(buf->lock));
-	sem_post(&(buf->filled));
+void print_pacing_stats(ostream & out, const FramePacingStats & stats) {
+	out << "pacing " << stats.frameRate << "fps presented " << stats.presented
+		<< " dropped " << stats.dropped << " duplicated " << stats.duplicated
+		<< " jitter mean " << stats.meanJitter * 1000 << "ms rms " << stats.rmsJitter * 1000
+		<< "ms max " << stats.maxJitter * 1000 << "ms\n";
 }
 
-char * bounded_buffer_dequeue(bounded_buffer * buf) {
-	char * r = 0x0;
-	
-	sem_wait(&(buf->filled));
-	pthread_mutex_lock(&(buf->lock));
-		r = buf->elem[buf->front];
-		buf->front = (buf->front + 1) % buf->capacity;
-		buf->num -= 1;
-	pthread_mutex_unlock(&(buf->lock));
-	sem_post(&(buf->empty));
-	return r;
-}
-
-void download(IConnection *connection, IChunk *chunk, ofstream *file)
-{
-	int len = 32768;
-	uint8_t *p_data = new uint8_t[32768];
-
-	int ret = 0;
-	do
-	{
-		ret = connection->Read(p_data, len, chunk);
-		if(ret > 0)
-			file->write((char *)p_data, ret);
-	}while(ret > 0);
+void print_ring_stats(ostream & out, const char * name, const RingStats & stats) {
+	out << name << " occupancy " << stats.occupancy << "/" << stats.capacity
+		<< " high " << stats.highWatermark
+		<< " pushed " << stats.pushed << " popped " << stats.popped
+		<< " producer-stalls " << stats.producerStalls
+		<< " consumer-stalls " << stats.consumerStalls << "\n";
 }
 
-
 class MultipleWindowsApp {
 	public:
 		MultipleWindowsApp() {
@@ -157,10 +136,13 @@ class MultipleWindowsApp {
 				std::lock_guard<std::mutex> lock(cloud_lock_);
 				auto mat = rendering::MaterialRecord();
 				mat.shader = "defaultUnlit";
+				// The shown frame goes back to the pool, the snapshot keeps a copy
+				auto cloud = shown_frame_ ? shown_frame_->ToLegacy()
+					: std::make_shared<geometry::PointCloud>();
 				new_vis->AddGeometry(
-						CLOUD_NAME + " #" + std::to_string(n_snapshots_), cloud_,
+						CLOUD_NAME + " #" + std::to_string(n_snapshots_), cloud,
 						&mat);
-				bounds = cloud_->GetAxisAlignedBoundingBox();
+				bounds = cloud->GetAxisAlignedBoundingBox();
 			}
 
 			new_vis->ResetCameraToDefault();
@@ -184,75 +166,80 @@ class MultipleWindowsApp {
 		void ReadThreadMain() {
 			// This is NOT the UI thread, need to call PostToMainThread() to
 			// update the scene or any part of the UI.
-			geometry::AxisAlignedBoundingBox bounds;
-			char * msg;	
+			PointCloudFrame * frame;
 			int cnt = 0;
 			std::ofstream writeFile;
 			writeFile.open("./timeLog/open3d.txt");
 			
 			while (main_vis_) {
-				msg = bounded_buffer_dequeue(buf2);
-				std::string full_path = string(msg);
+				// Starts, and resumes after running dry, with a segment's worth of frames ready
+				bool rebuffer = frame_queue->Size() == 0;
+				if(!segment_buffer->WaitForFrame()) {
+					// The stream ended short, e.g. after a failed download
+					main_vis_->Close();
+					print_pacing_stats(writeFile, presentation_clock->Stats());
+					writeFile.close();
+					break;
+				}
+				frame = frame_queue->Pop();
 				std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
-				
-				Eigen::Vector3d extent;
-				{
-					std::lock_guard<std::mutex> lock(cloud_lock_);
-					cloud_ = std::make_shared<geometry::PointCloud>();
-					io::ReadPointCloudFromPLY(full_path, *cloud_, {"auto",false,false,false,{}});
-					bounds = cloud_->GetAxisAlignedBoundingBox();
-					extent = bounds.GetExtent();
+				if(rebuffer)
+					presentation_clock->Restart(frame->Index());
+
+				// Decode fell behind: skip overdue frames while newer ones are ready
+				while(presentation_clock->Lateness(frame->Index()) > 0 && frame_queue->Size() > 0) {
+					presentation_clock->Dropped();
+					segment_buffer->FramePresented();
+					cnt++;
+					// The UI thread is the only one returning frames to the pool
+					gui::Application::GetInstance().PostToMainThread(
+							main_vis_.get(), [frame]() { frame_pool->Release(frame); });
+					frame = frame_queue->Pop();
 				}
 
-				
-				auto mat = rendering::MaterialRecord();
-				mat.shader = "defaultUnlit";
-
+				presentation_clock->WaitUntilDue(frame->Index());
 				gui::Application::GetInstance().PostToMainThread(
-						main_vis_.get(), [this, bounds, mat]() {
+						main_vis_.get(), [this, frame]() {
 						std::lock_guard<std::mutex> lock(cloud_lock_);
-						main_vis_->RemoveGeometry(CLOUD_NAME);
-						main_vis_->AddGeometry(CLOUD_NAME, cloud_, &mat);
-							
-						//main_vis_->ResetCameraToDefault();
-						//Eigen::Vector3f center = bounds.GetCenter().cast<float>();
-						//main_vis_->SetupCamera(60, center, center + CENTER_OFFSET,
-						//		{0.0f, -1.0f, 0.0f});
+						if(scene_capacity_ != frame->Capacity()) {
+							// First frame or larger segments: (re)create the GPU
+							// buffers, sized to the frame pool's capacity
+							auto mat = rendering::MaterialRecord();
+							mat.shader = "defaultUnlit";
+							if(scene_cloud_)
+								main_vis_->RemoveGeometry(CLOUD_NAME);
+							scene_cloud_ = std::make_shared<t::geometry::PointCloud>(frame->Cloud()->Clone());
+							main_vis_->AddGeometry(CLOUD_NAME, scene_cloud_, &mat);
+							scene_capacity_ = frame->Capacity();
+						}
+						else {
+							// Same size: stream positions and colours into the existing buffers
+							main_vis_->GetScene()->GetScene()->UpdateGeometry(CLOUD_NAME, *frame->Cloud(),
+									rendering::Scene::kUpdatePointsFlag | rendering::Scene::kUpdateColorsFlag);
+							main_vis_->PostRedraw();
+						}
+						presentation_clock->Presented(frame->Index());
+						// Only snapshots still read the previous frame
+						frame_pool->Release(shown_frame_);
+						shown_frame_ = frame;
 						});
 
-				Eigen::Vector3d magnitude = 0.005 * extent;
-				auto seed = std::random_device()();
-				std::mt19937 gen_algo(seed);
-				std::uniform_real_distribution<> random(-0.5, 0.5);
-
-				std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-
-				// Perturb the cloud with a random walk to simulate an actual read
-				{
-					std::lock_guard<std::mutex> lock(cloud_lock_);
-					for (size_t i = 0; i < cloud_->points_.size(); ++i) {
-						Eigen::Vector3d perturb(magnitude[0] * random(gen_algo),
-								magnitude[1] * random(gen_algo),
-								magnitude[2] * random(gen_algo));
-						cloud_->points_[i] = perturb;
-					}
-				}
-				
 				cnt++;
+				segment_buffer->FramePresented();
 				cout << "In Open3D, CNT=" << cnt << endl;
 				std::chrono::duration<double> sec = std::chrono::system_clock::now() - start;
 				cout << "OPEN-3D Time(sec) : " << sec.count() <<"seconds" <<'\n';
 				writeFile << "OPEN-3D Time(sec) : " << sec.count() << "seconds\n";
 				
 				if(cnt == 1) main_vis_->ResetCameraToDefault(); 
-				else if(cnt == PLY_COUNT_PER_BIN * BIN_COUNT - 1) {
+				else if(cnt >= PLY_COUNT_PER_BIN * BIN_COUNT - 1) {
 					main_vis_->Close();
+					print_pacing_stats(writeFile, presentation_clock->Stats());
 					writeFile.close();
 					break;
 				}
 				
-				if (!main_vis_) {  // might have changed while sleeping
+				if (!main_vis_) {  // might have changed while waiting
 					break;
 				}
 			}
@@ -260,7 +247,9 @@ class MultipleWindowsApp {
 
 	private:
 		std::mutex cloud_lock_;
-		std::shared_ptr<geometry::PointCloud> cloud_;
+		std::shared_ptr<t::geometry::PointCloud> scene_cloud_; // owns the size of the GPU buffers
+		size_t scene_capacity_ = 0;
+		PointCloudFrame * shown_frame_ = 0x0;
 
 		std::atomic<bool> is_done_;
 		std::shared_ptr<visualizer::O3DVisualizer> main_vis_;
@@ -274,64 +263,118 @@ void *
 libdash_thread(void *ptr)
 {
 	cout << "Hello, Lib-dash Thread\n";
-	pthread_t tid;
-	char msg[256], command[1024], filepath[1024];
-	vector<string> binaryFile;
-	char highfile[128], midfile[128], lowfile[128];	
-	int serv_sock;
-	char ret[BUF_SIZE] = "Low";
-	int str_len;
-	socklen_t clnt_adr_sz;
-	struct sockaddr_in serv_adr, clnt_adr;
-	int port = *((int*)ptr);
-	
-	serv_sock = socket(PF_INET, SOCK_DGRAM, 0);
-	if(serv_sock == -1)
-		error_handling("UDP socket creation error");
-	
-	memset(&serv_adr, 0, sizeof(serv_adr));
-	serv_adr.sin_family = AF_INET;
-	serv_adr.sin_addr.s_addr = htonl(INADDR_ANY);
-	//strcpy(port, (char*)ptr);
-	cout << "PORT: " << port <<"\n";
-	serv_adr.sin_port = htons(port);
 
-	if(bind(serv_sock, (struct sockaddr*)&serv_adr, sizeof(serv_adr)) == -1)
-		error_handling("bind() error");
+	// Annex D metrics of every connection and request, one JSON object per line
+	HTTPMetricsLog metrics_log("./timeLog/http_metrics.jsonl");
+
+	// One parsed MPD and one pool of keep-alive connections for the whole session
+	SegmentFetcher fetcher(SERVER_HOST, SERVER_PORT, FETCH_CONNECTIONS);
+	if(metrics_log.IsOpen())
+		fetcher.SetMetricsLog(&metrics_log);
+	if(!fetcher.Open(MPD_PATH))
+		error_handling("MPD download error");
+
+	// A dynamic MPD is refreshed in the background (patched in place when
+	// it has a PatchLocation) and playback starts at its live edge; the
+	// manager keeps its own copy, parsed from the document just downloaded
+	LiveMPDManager live_manager(SERVER_HOST, SERVER_PORT, MPD_PATH);
+	int first_segment = 0;
+	if(fetcher.MPD()->GetType() == "dynamic") {
+		if(!live_manager.Open(fetcher.MPDDocument()))
+			error_handling("live MPD parse error");
+		if(metrics_log.IsOpen())
+			live_manager.SetMetricsLog(&metrics_log);
+		live_manager.Start();
+		fetcher.SetLiveManager(&live_manager);
+		size_t live_edge = 0;
+		if(live_manager.LiveEdge(0, live_edge) && live_edge <= (size_t) (INT_MAX - BIN_COUNT))
+			first_segment = (int) live_edge;
+		else
+			cout << "Live edge unknown, starting at the first segment" << endl;
+	}
+	const int last_segment = first_segment + BIN_COUNT;
+
+	const vector<IRepresentation *> & representations = fetcher.Representations();
+	vector<uint32_t> bandwidths;
+	for(size_t i = 0 ; i < representations.size() ; i++)
+		bandwidths.push_back(representations.at(i)->GetBandwidth());
+
+	// Throughput rule while the pipeline fills, buffer rule (BOLA) once it
+	// is full; representations the decoders cannot keep up with are skipped.
+	abr_controller = new AbrController(bandwidths, new EWMAThroughputEstimator(),
+			new HybridPolicy(), DECODE_WORKERS);
+	size_t quality = abr_controller->LowestRepresentation();
+
+	// Prefetch target: the MPD's minBufferTime, at least BUFFER_SEGMENTS segments
+	double segment_duration = fetcher.SegmentDuration();
+	double buffer_target = std::max(fetcher.MinBufferTime(), BUFFER_SEGMENTS * segment_duration);
+	buffer_target = std::min(buffer_target, SEGMENT_QUEUE_SIZE * segment_duration);
+	segment_buffer->Configure(segment_duration, buffer_target);
+
+	// Frame rate from the MPD, otherwise frames per segment over its duration
+	double frame_rate = fetcher.FrameRate();
+	if(frame_rate <= 0)
+		frame_rate = PLY_COUNT_PER_BIN / segment_duration;
+	presentation_clock->SetFrameRate(frame_rate);
 
 	std::ofstream writeFile;
 	writeFile.open("./timeLog/libdash.txt");
 
+	// Keep PIPELINE_DEPTH requests outstanding; a quality decision applies
+	// to the next request sent, PIPELINE_DEPTH segments ahead.
+	int requested = first_segment;
+	while(requested < last_segment && requested < first_segment + PIPELINE_DEPTH) {
+		segment_buffer->Reserve();
+		fetcher.Queue(quality, requested++);
+	}
+
 	for(int frame=0;frame<BIN_COUNT;frame++){
 		std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
 		
-		sprintf(command, "./libdash_mcnl_test %d %s %d", frame, ret, port);
-		system(command);
-		clnt_adr_sz = sizeof(clnt_adr);
-		str_len = recvfrom(serv_sock, ret, BUF_SIZE, 0, (struct sockaddr*)&clnt_adr, &clnt_adr_sz);
-		ret[str_len] = 0;
-		cout << "RET: " << ret << endl;
-		string buildbinpath = PATH + "/AR-streaming-with-MPEG-DASH/build/bin";
-		for(auto& p : std::experimental::filesystem::directory_iterator(buildbinpath)) {
-			string Filename = p.path().string();
-			cout << Filename << endl;
-			Filename = Filename.substr(Filename.find("/bin/") + 5);
-
-			sprintf(highfile ,"high_s%d", frame);
-			sprintf(midfile ,"mid_s%d", frame);
-			sprintf(lowfile ,"low_s%d", frame);
-			if(Filename.find(highfile) != string::npos || Filename.find(midfile) != string::npos || Filename.find(lowfile) != string::npos) {
-				snprintf(msg, 256, "%s", Filename.c_str());
-				bounded_buffer_queue(buf1, strdup(msg));
-				cout << Filename << endl;
+		MediaSegment * segment = new MediaSegment();
+		if(!fetcher.Receive(segment)) {
+			cerr << "Segment download error : " << frame << endl;
+			// Receive already resent it once. The decode and render stages
+			// count BIN_COUNT segments, so pass it on as failed for them to
+			// skip, and give back its place in the buffer.
+			segment->data.clear();
+			segment->isFailed = true;
+			segment_buffer->SegmentFailed();
+			segment_queue->Push(segment);
+			if(requested < last_segment) {
+				segment_buffer->Reserve();
+				fetcher.Queue(quality, requested++);
 			}
+			continue;
+		}
+		cout << "Downloaded " << segment->name << " (" << segment->data.size() << " B)" << endl;
+		abr_controller->AddDownload(segment->data.size(), fetcher.LastDownloadSeconds());
+		segment_buffer->SegmentFetched(segment->data.size());
+		segment_queue->Push(segment);
+
+		// Everything fetched but not yet on screen counts as buffer
+		double buffer_level = segment_buffer->Level();
+		quality = abr_controller->Select(buffer_level, buffer_target, segment_duration);
+		cout << "RET: " << representations.at(quality)->GetId()
+			<< " (" << abr_controller->PolicyName() << ", throughput "
+			<< abr_controller->ThroughputEstimate() << " bit/s, buffer " << buffer_level << " s)" << endl;
+		if(requested < last_segment) {
+			segment_buffer->Reserve();
+			fetcher.Queue(quality, requested++);
 		}
+
 		std::chrono::duration<double> sec = std::chrono::system_clock::now() - start;
 		writeFile << "Lib-Dash Time(sec) : " << sec.count() << "seconds\n";
 		//cout << "Lib-DASH Time(sec) : " << sec.count() <<"seconds" <<'\n';
 	}
 	writeFile.close();
-	close(serv_sock);
+
+	if(live_manager.IsDynamic()) {
+		LiveMPDStats live_stats = live_manager.Stats();
+		cout << "MPD patches " << live_stats.patches << " failed " << live_stats.failedPatches
+			<< " full refreshes " << live_stats.fullRefreshes << " failed " << live_stats.failedRefreshes << endl;
+	}
+	live_manager.Stop();
 
 	return 0x0;
 }
@@ -344,7 +387,7 @@ mpeg_vpcc_thread(void *ptr)
 	pthread_t tid;
 	tid = pthread_self();
 	
-	char * msg;
+	MediaSegment * segment;
 	char line[1024] = {0, };
 	vector<string> opt;
 	string decOptpath = PATH + "/AR-streaming-with-MPEG-DASH/Main/decOpt.txt";
@@ -355,89 +398,63 @@ mpeg_vpcc_thread(void *ptr)
 	while(f1.getline(line, 1001)) {
 		opt.push_back(line);
 	}
+	// All-intra segments decode independently: keep several in flight and
+	// let the scheduler hand them back in presentation order.
+	DecodeScheduler scheduler(DECODE_WORKERS, DECODE_WORKERS * 2, opt);
+	size_t frame_index = 0;
+	size_t frame_capacity = 0; // points per pooled frame, only grows
+
 	std::ofstream writeFile;
 	writeFile.open("./timeLog/mpeg-vpcc.txt");
-	
-	for(int i = 0 ; i < BIN_COUNT ; i++) {  /// To do
-		msg = bounded_buffer_dequeue(buf1);
-		if(msg != 0x0) {
-			std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
 
-			printf("MPEG-VPCC Thread [%ld] read %s\n", (unsigned long) tid, msg);
-			char path[1024], comprename[1024], reconname[1024];
-			sprintf(path, "../../bin/%s", "PccAppDecoder");
-			
-			msg[strlen(msg)-4] = 0x0;
-			char dir_path[1024];
-			sprintf(dir_path, "./../../dec_test/%s",msg);
-			cout << "dir_path : " << dir_path << endl;
-			
-			pid_t pid, waitpid;
-			int status;
-			pid = fork();
-			if(pid == 0) {
-				mkdir(dir_path, 0755);
-				sprintf(comprename,"--compressedStreamPath=%s.bin", msg);	
-				sprintf(reconname,"--reconstructedDataPath=./../../dec_test/%s/%s_dec_%%04d.ply", msg ,msg);				
-				execl(path, "PccAppDecoder", comprename, opt[0].c_str(), opt[1].c_str(), opt[2].c_str(), reconname, opt[3].c_str(), NULL);
-			}else {
-				char ply_count[101];
-				char dir[256];
-				int cnt = 0;
-				char command[1024];
-				char ply_path[1024];
-				
-				string decTestpath = PATH + "/AR-streaming-with-MPEG-DASH/dec_test";
-				sprintf(ply_path, "ls -l %s/%s/*.ply | wc -l", decTestpath.c_str(), msg);
-				while(1) {
-					FILE *fp = popen(ply_path, "r");
-					if(fgets(ply_count, 10, fp) == NULL) break;
-					cout << "cnt :" << ply_count << " msg : " << msg <<  " " << atoi(ply_count) << endl;
-					if(atoi(ply_count) == PLY_PER_DIRECTORY) { // 10
-						sprintf(dir, "%s/%s/ply%02d", decTestpath.c_str(), msg, cnt++);
-						mkdir(dir, 0755);
-						sprintf(command, "mv %s/*.ply %s", dir_path,dir);
-						//cout << "Command :" << command << endl;
-						system(command);
-						
-						string directory_path;
-						directory_path = string(dir); 
-						
-						vector<string> files;
-						for(auto & p : std::experimental::filesystem::directory_iterator(directory_path)) 
-						{
-							string filepath = string(dir) + "/" + p.path().filename().string();
-							files.push_back(filepath);
-						}
-						sort(files.begin(), files.end());
-						
-						for(int i = 0 ; i < files.size() ; i++) {
-							string filepath = files[i];
-							//cout << "PUSH: " << filepath << endl;
-							bounded_buffer_queue(buf2, strdup(filepath.c_str()));
-						}
-					}
-					pclose(fp);
-					if(cnt == (PLY_COUNT_PER_BIN / PLY_PER_DIRECTORY)) {
-						sprintf(command, "rm -rf %s.bin *.ofl *.opcl *.trc *.txt *.otl", msg);
-						system(command);
-						break;
-					}
-					printf("cnt : %d, WEXITSTATUS: %d\n", cnt, WEXITSTATUS(status));
-				}
-				
-				waitpid = wait(&status);
-				free(msg);
-				kill(pid, SIGKILL);
+	std::thread collector([&]() {
+		for(int i = 0 ; i < BIN_COUNT ; i++) {
+			std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
+			DecodedSegment * decoded = scheduler.Next();
+
+			// Frames are pushed as soon as they are reconstructed, while the
+			// rest of the segment is still being decoded
+			pcc::PCCPointSet3 points;
+			while(scheduler.NextFrame(decoded, points)) {
+				// Every frame gets the same point capacity, so the renderer can
+				// keep updating one GPU buffer; grow with headroom when exceeded
+				if(points.getPointCount() > frame_capacity)
+					frame_capacity = points.getPointCount() + points.getPointCount() / 8;
+
+				PointCloudFrame * frame = frame_pool->Acquire();
+				frame->Assign(points, frame_index++, frame_capacity);
+				frame_queue->Push(frame);
+				segment_buffer->FrameDecoded();
+			}
+			if(decoded->isFailed) {
+				writeFile << "MPEG-VPCC skipped " << decoded->name << " (download failed)\n";
+				delete decoded;
+				continue;
 			}
+			if(decoded->isDecoded)
+				abr_controller->AddDecode(decoded->representation, decoded->decodeSeconds);
+			segment_buffer->SegmentConsumed(decoded->bytes);
 
 			std::chrono::duration<double> sec = std::chrono::system_clock::now() - start;
-			writeFile << "MPEG-VPCC Time(sec) : " << sec.count() << "seconds\n";
+			writeFile << "MPEG-VPCC Time(sec) : " << sec.count() << "seconds"
+				<< " decode " << decoded->decodeSeconds << "seconds " << decoded->name << "\n";
 			cout << "MPEG-VPCC Time(sec) : " << sec.count() <<"seconds" <<'\n';
+			print_ring_stats(writeFile, "segment_queue", segment_queue->Stats());
+			print_ring_stats(writeFile, "frame_queue", frame_queue->Stats());
+			print_ring_stats(writeFile, "frame_pool", frame_pool->Stats());
+			print_buffer_stats(writeFile, segment_buffer->Stats());
+			delete decoded;
 		}
-
+		segment_buffer->EndOfStream();
+	});
+	
+	for(int i = 0 ; i < BIN_COUNT ; i++) {
+		segment = segment_queue->Pop();
+		printf("MPEG-VPCC Thread [%ld] read %s\n", (unsigned long) tid, segment->name.c_str());
+		scheduler.Submit(segment);
 	}
 
+	collector.join();
 	writeFile.close();
 	return 0x0;
 }
@@ -463,14 +480,13 @@ int main(int argc, char *argv[]) {
 	pthread_t thread2;
 	pthread_t thread3;
 
-	buf1 = (bounded_buffer *)malloc(sizeof(bounded_buffer));
-	bounded_buffer_init(buf1, 100);
-	
-	buf2 = (bounded_buffer *)malloc(sizeof(bounded_buffer));
-	bounded_buffer_init(buf2, 100);
+	segment_queue = new SPSCRing<MediaSegment *>(SEGMENT_QUEUE_SIZE);
+	frame_queue = new SPSCRing<PointCloudFrame *>(FRAME_POOL_SIZE);
+	frame_pool = new FramePool(FRAME_POOL_SIZE);
+	segment_buffer = new SegmentBuffer(PLY_COUNT_PER_BIN, PLY_COUNT_PER_BIN);
+	presentation_clock = new PresentationClock(PLY_COUNT_PER_BIN);
 		
-	int port = atoi(argv[1]);
-	pthread_create(&thread1, 0x0, libdash_thread, (void*)&port);
+	pthread_create(&thread1, 0x0, libdash_thread, 0x0);
 	pthread_create(&thread2, 0x0, mpeg_vpcc_thread, 0x0);
 	pthread_create(&thread3, 0x0, open3d_thread, 0x0);
 	
@@ -479,12 +495,18 @@ int main(int argc, char *argv[]) {
 	pthread_join(thread1, 0x0);
 	pthread_join(thread2, 0x0);
 	pthread_join(thread3, 0x0);
+	print_ring_stats(cout, "segment_queue", segment_queue->Stats());
+	print_ring_stats(cout, "frame_queue", frame_queue->Stats());
+	print_ring_stats(cout, "frame_pool", frame_pool->Stats());
+	print_buffer_stats(cout, segment_buffer->Stats());
+	print_pacing_stats(cout, presentation_clock->Stats());
+	delete abr_controller;
 	cout << "END\n";
 
 	return 0;
 }
 
-void error_handling(char *message) {
+void error_handling(const char *message) {
 	fputs(message, stderr);
 	fputc('\n', stderr);
 	exit(1);
@@ -0,0 +1,29 @@
+/*
+ * MediaSegment.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * A downloaded V-PCC segment travelling from the download stage to the
+ * decode stage.
+ *****************************************************************************/
+
+#ifndef MEDIASEGMENT_H_
+#define MEDIASEGMENT_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace libdashtest
+{
+    struct MediaSegment
+    {
+        size_t                  index;          /* segment number in presentation order */
+        size_t                  representation; /* index into the adaptation set's representations */
+        std::string             name;           /* file name without extension, e.g. high_s3 */
+        std::vector<uint8_t>    data;
+        bool                    isFailed;       /* download failed, no data; the later stages skip it */
+    };
+}
+
+#endif /* MEDIASEGMENT_H_ */
@@ -22,6 +22,12 @@ PersistentHTTPConnection::PersistentHTTPConnection  () :
 }
 PersistentHTTPConnection::~PersistentHTTPConnection ()
 {
+    while(this->chunkQueue.size() > 0)
+    {
+        delete(this->chunkQueue.front());
+        this->chunkQueue.pop();
+    }
+
     DeleteConditionVariable(&this->chunkFinished);
     DeleteCriticalSection(&this->monitorMutex);
 }
@@ -30,16 +36,17 @@ int                 PersistentHTTPConnection::Peek              (uint8_t *data,
 {
     EnterCriticalSection(&this->monitorMutex);
 
-    while(this->chunkQueue.front()->Chunk() != chunk && this->chunkQueue.size() > 0)
+    while(this->chunkQueue.size() > 0 && this->chunkQueue.front()->Chunk() != chunk)
         SleepConditionVariableCS(&this->chunkFinished, &this->monitorMutex, INFINITE);
 
-    HTTPChunk *front = this->chunkQueue.front();
-
     if(this->chunkQueue.size() == 0)
     {
         LeaveCriticalSection(&this->monitorMutex);
         return -1;
     }
+
+    HTTPChunk *front = this->chunkQueue.front();
+
     if(front->BytesLeft() == 0)
     {
         LeaveCriticalSection(&this->monitorMutex);
@@ -47,9 +54,9 @@ int                 PersistentHTTPConnection::Peek              (uint8_t *data,
     }
     if(front->HeaderParsed() == false)
     {
-        this->ParseHeader();
+        bool isParsed = this->ParseHeader();
         front->HeaderParsed(true);
-        front->ContentLength(this->contentLength);
+        front->ContentLength(!isParsed ? 0 : this->isChunked ? CONTENT_LENGTH_UNKNOWN : this->contentLength);
     }
 
     if(len > front->BytesLeft())
@@ -65,42 +72,64 @@ int                 PersistentHTTPConnection::Read              (uint8_t *data,
 {
     EnterCriticalSection(&this->monitorMutex);
 
-    while(this->chunkQueue.front()->Chunk() != chunk && this->chunkQueue.size() > 0)
+    while(this->chunkQueue.size() > 0 && this->chunkQueue.front()->Chunk() != chunk)
+    {
+        /* the event loop comes back once the chunks before are complete */
+        if(this->isNonBlocking)
+        {
+            LeaveCriticalSection(&this->monitorMutex);
+            return READ_WOULD_BLOCK;
+        }
         SleepConditionVariableCS(&this->chunkFinished, &this->monitorMutex, INFINITE);
-
-    HTTPChunk *front = this->chunkQueue.front();
+    }
 
     if(this->chunkQueue.size() == 0)
     {
         LeaveCriticalSection(&this->monitorMutex);
         return -1;
     }
+
+    HTTPChunk *front = this->chunkQueue.front();
+
     if(front->HeaderParsed() == false)
     {
-        this->ParseHeader();
+        if(this->isNonBlocking && !this->HeaderBuffered() && this->wouldBlock)
+        {
+            LeaveCriticalSection(&this->monitorMutex);
+            return READ_WOULD_BLOCK;
+        }
+        /* without a usable header there is no body to read, the status code fails the response */
+        bool isParsed = this->ParseHeader();
         front->HeaderParsed(true);
-        front->ContentLength(this->contentLength);
+        front->ContentLength(!isParsed ? 0 : this->isChunked ? CONTENT_LENGTH_UNKNOWN : this->contentLength);
     }
-    if(front->BytesLeft() == 0)
+    if(front->BytesLeft() > 0)
     {
-        LeaveCriticalSection(&this->monitorMutex);
-        delete(front);
-        this->chunkQueue.pop();
-        WakeAllConditionVariable(&this->chunkFinished);
-        return 0;
+        if(len > front->BytesLeft())
+            len = (size_t) front->BytesLeft();
+
+        int ret = HTTPConnection::Read(data, len, chunk);
+
+        if(ret > 0)
+        {
+            front->AddBytesRead(ret);
+            LeaveCriticalSection(&this->monitorMutex);
+            return ret;
+        }
+        if(ret == READ_WOULD_BLOCK)
+        {
+            LeaveCriticalSection(&this->monitorMutex);
+            return ret;
+        }
     }
 
-    if(len > front->BytesLeft())
-        len = (size_t) front->BytesLeft();
-
-    size_t ret = HTTPConnection::Read(data, len, chunk);
-
-    if(ret > 0)
-        front->AddBytesRead(ret);
-
+    /* all bytes read, the last chunk reached or the connection lost */
+    this->ResponseFinished(chunk);
+    delete(front);
+    this->chunkQueue.pop();
     LeaveCriticalSection(&this->monitorMutex);
-
-    return ret;
+    WakeAllConditionVariable(&this->chunkFinished);
+    return 0;
 }
 std::string         PersistentHTTPConnection::PrepareRequest    (IChunk *chunk)
 {
@@ -115,7 +144,10 @@ std::string         PersistentHTTPConnection::PrepareRequest    (IChunk *chunk)
         std::stringstream req;
         req << "GET " << chunk->Path() << " HTTP/1.1\r\n" <<
                "Host: " << chunk->Host() << "\r\n" <<
-               "Range: bytes=" << chunk->StartByte() << "-" << chunk->EndByte() << "\r\n\r\n";
+               "Range: bytes=" << chunk->StartByte() << "-";
+        if(chunk->EndByte() != RANGE_TO_END)
+            req << chunk->EndByte();
+        req << "\r\n\r\n";
 
         request = req.str();
     }
@@ -145,12 +177,18 @@ bool                PersistentHTTPConnection::Schedule          (IChunk *chunk)
     if(!this->isInit)
         return false;
 
+    /* readers walk chunkQueue and the transfers under the lock, and the queue has to keep the order on the wire */
+    EnterCriticalSection(&this->monitorMutex);
+
     if(this->SendData(this->PrepareRequest(chunk)))
     {
+        this->RequestSent(chunk);
         this->chunkQueue.push(new HTTPChunk(chunk));
+        LeaveCriticalSection(&this->monitorMutex);
         return true;
     }
 
+    LeaveCriticalSection(&this->monitorMutex);
     return false;
 }
 bool                PersistentHTTPConnection::InitChunk         (IChunk *chunk)
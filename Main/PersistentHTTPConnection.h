@@ -18,7 +18,9 @@
 
 #include <queue>
 
-#define RETRY 5
+#define RETRY                   5
+#define RANGE_TO_END            ((size_t) -1)   /* IChunk::EndByte() of an open "bytes=N-" range */
+#define CONTENT_LENGTH_UNKNOWN  ((uint64_t) -1) /* HTTPChunk::ContentLength() of a chunked body */
 
 namespace libdashtest
 {
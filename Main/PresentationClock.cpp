@@ -0,0 +1,112 @@
+/*
+ * PresentationClock.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "PresentationClock.h"
+
+#include <math.h>
+#include <thread>
+
+using namespace libdashtest;
+
+PresentationClock::PresentationClock    (double frameRate) :
+                   frameRate            (frameRate > 0 ? frameRate : 30),
+                   anchorIndex          (0),
+                   anchor               (std::chrono::steady_clock::now()),
+                   presented            (0),
+                   dropped              (0),
+                   duplicated           (0),
+                   jitterSum            (0),
+                   jitterSquareSum      (0),
+                   maxJitter            (0)
+{
+}
+PresentationClock::~PresentationClock   ()
+{
+}
+
+void                PresentationClock::SetFrameRate (double frameRate)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(frameRate > 0)
+        this->frameRate = frameRate;
+}
+void                PresentationClock::Restart      (size_t index)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->anchorIndex   = index;
+    this->anchor        = std::chrono::steady_clock::now();
+}
+void                PresentationClock::WaitUntilDue (size_t index)
+{
+    std::chrono::steady_clock::time_point deadline;
+    {
+        std::lock_guard<std::mutex> lock(this->monitorMutex);
+        deadline = this->Deadline(index);
+    }
+
+    std::this_thread::sleep_until(deadline);
+}
+size_t              PresentationClock::Lateness     (size_t index)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    std::chrono::duration<double> late = std::chrono::steady_clock::now() - this->Deadline(index);
+    if(late.count() <= 0)
+        return 0;
+
+    return (size_t) (late.count() * this->frameRate);
+}
+void                PresentationClock::Presented    (size_t index)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    std::chrono::duration<double> jitter = std::chrono::steady_clock::now() - this->Deadline(index);
+    double magnitude = fabs(jitter.count());
+
+    this->presented++;
+    this->jitterSum         += magnitude;
+    this->jitterSquareSum   += magnitude * magnitude;
+    if(magnitude > this->maxJitter)
+        this->maxJitter = magnitude;
+
+    if(jitter.count() > 0)
+        this->duplicated += (size_t) (jitter.count() * this->frameRate);
+}
+void                PresentationClock::Dropped      ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->dropped++;
+}
+double              PresentationClock::FrameRate    ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    return this->frameRate;
+}
+FramePacingStats    PresentationClock::Stats        ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    FramePacingStats stats;
+    stats.frameRate     = this->frameRate;
+    stats.presented     = this->presented;
+    stats.dropped       = this->dropped;
+    stats.duplicated    = this->duplicated;
+    stats.meanJitter    = this->presented > 0 ? this->jitterSum / this->presented : 0;
+    stats.maxJitter     = this->maxJitter;
+    stats.rmsJitter     = this->presented > 0 ? sqrt(this->jitterSquareSum / this->presented) : 0;
+
+    return stats;
+}
+std::chrono::steady_clock::time_point   PresentationClock::Deadline (size_t index) const
+{
+    double seconds = ((double) index - (double) this->anchorIndex) / this->frameRate;
+
+    return this->anchor + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+}
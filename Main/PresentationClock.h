@@ -0,0 +1,72 @@
+/*
+ * PresentationClock.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Paces the renderer at the content frame rate. Frame n is due at
+ * anchor + n / frameRate. Frames that are more than one interval late are
+ * dropped when a newer one is ready. A frame shown late leaves the
+ * previous one on screen, which is counted as duplicated slots. Jitter is
+ * the difference between when a frame was handed to the UI thread and
+ * when it was due.
+ *****************************************************************************/
+
+#ifndef PRESENTATIONCLOCK_H_
+#define PRESENTATIONCLOCK_H_
+
+#include <chrono>
+#include <mutex>
+#include <stddef.h>
+
+namespace libdashtest
+{
+    struct FramePacingStats
+    {
+        double  frameRate;
+        size_t  presented;
+        size_t  dropped;
+        size_t  duplicated;     /* slots in which the previous frame stayed on screen */
+        double  meanJitter;     /* mean absolute jitter in seconds */
+        double  maxJitter;
+        double  rmsJitter;
+    };
+
+    class PresentationClock
+    {
+        public:
+            PresentationClock           (double frameRate);
+            virtual ~PresentationClock  ();
+
+            void    SetFrameRate    (double frameRate);
+            /*
+             *  Makes frame index due now, e.g. at start-up and after a stall.
+             */
+            void    Restart         (size_t index);
+            void    WaitUntilDue    (size_t index);
+            /*
+             *  Whole frame intervals index is overdue, 0 if it is not late.
+             */
+            size_t  Lateness        (size_t index);
+            void    Presented       (size_t index);
+            void    Dropped         ();
+
+            double              FrameRate   ();
+            FramePacingStats    Stats       ();
+
+        private:
+            double                                  frameRate;
+            size_t                                  anchorIndex;
+            std::chrono::steady_clock::time_point   anchor;
+            size_t                                  presented;
+            size_t                                  dropped;
+            size_t                                  duplicated;
+            double                                  jitterSum;
+            double                                  jitterSquareSum;
+            double                                  maxJitter;
+            std::mutex                              monitorMutex;
+
+            std::chrono::steady_clock::time_point   Deadline    (size_t index) const;
+    };
+}
+
+#endif /* PRESENTATIONCLOCK_H_ */
@@ -0,0 +1,189 @@
+/*
+ * SPSCRing.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Bounded single-producer/single-consumer ring used between the client
+ * stages (download -> decode -> render). Push and Pop never take a lock;
+ * a side only sleeps on its semaphore when the ring is full (producer) or
+ * empty (consumer), and the other side posts it only if it is parked.
+ *****************************************************************************/
+
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include <semaphore.h>
+
+namespace libdashtest
+{
+    struct RingStats
+    {
+        size_t      capacity;
+        size_t      occupancy;      /* items queued right now */
+        size_t      highWatermark;  /* largest occupancy seen */
+        uint64_t    pushed;
+        uint64_t    popped;
+        uint64_t    producerStalls; /* Push had to wait: downstream is the bottleneck */
+        uint64_t    consumerStalls; /* Pop had to wait: upstream is the bottleneck */
+    };
+
+    template <typename T>
+    class SPSCRing
+    {
+        public:
+            SPSCRing            (size_t capacity) :
+                                 capacity       (capacity > 0 ? capacity : 1),
+                                 mask           (RoundUp(capacity) - 1),
+                                 slots          (RoundUp(capacity)),
+                                 head           (0),
+                                 tail           (0),
+                                 producerParked (false),
+                                 consumerParked (false),
+                                 highWatermark  (0),
+                                 producerStalls (0),
+                                 consumerStalls (0)
+            {
+                sem_init(&this->spaceAvailable, 0, 0);
+                sem_init(&this->dataAvailable, 0, 0);
+            }
+            virtual ~SPSCRing   ()
+            {
+                sem_destroy(&this->spaceAvailable);
+                sem_destroy(&this->dataAvailable);
+            }
+
+            bool    TryPush (const T &item)
+            {
+                size_t h = this->head.load(std::memory_order_relaxed);
+                size_t t = this->tail.load(std::memory_order_acquire);
+
+                if(h - t >= this->capacity)
+                    return false;
+
+                this->slots[h & this->mask] = item;
+                this->head.store(h + 1, std::memory_order_release);
+
+                if(h + 1 - t > this->highWatermark.load(std::memory_order_relaxed))
+                    this->highWatermark.store(h + 1 - t, std::memory_order_relaxed);
+
+                this->Wake(this->consumerParked, this->dataAvailable);
+                return true;
+            }
+            bool    TryPop  (T &item)
+            {
+                size_t t = this->tail.load(std::memory_order_relaxed);
+                size_t h = this->head.load(std::memory_order_acquire);
+
+                if(t == h)
+                    return false;
+
+                item = this->slots[t & this->mask];
+                this->tail.store(t + 1, std::memory_order_release);
+
+                this->Wake(this->producerParked, this->spaceAvailable);
+                return true;
+            }
+            /* Blocks while the ring is full (backpressure) */
+            void    Push    (const T &item)
+            {
+                if(this->TryPush(item))
+                    return;
+
+                this->producerStalls.fetch_add(1, std::memory_order_relaxed);
+                while(true)
+                {
+                    this->producerParked.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if(this->TryPush(item))
+                    {
+                        this->producerParked.store(false, std::memory_order_relaxed);
+                        return;
+                    }
+                    sem_wait(&this->spaceAvailable);
+                }
+            }
+            /* Blocks while the ring is empty */
+            T       Pop     ()
+            {
+                T item;
+
+                if(this->TryPop(item))
+                    return item;
+
+                this->consumerStalls.fetch_add(1, std::memory_order_relaxed);
+                while(true)
+                {
+                    this->consumerParked.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if(this->TryPop(item))
+                    {
+                        this->consumerParked.store(false, std::memory_order_relaxed);
+                        return item;
+                    }
+                    sem_wait(&this->dataAvailable);
+                }
+            }
+
+            size_t      Capacity    () const
+            {
+                return this->capacity;
+            }
+            size_t      Size        () const
+            {
+                return this->head.load(std::memory_order_acquire) - this->tail.load(std::memory_order_acquire);
+            }
+            RingStats   Stats       () const
+            {
+                RingStats stats;
+
+                stats.capacity          = this->Capacity();
+                stats.pushed            = this->head.load(std::memory_order_acquire);
+                stats.popped            = this->tail.load(std::memory_order_acquire);
+                stats.occupancy         = (size_t) (stats.pushed - stats.popped);
+                stats.highWatermark     = this->highWatermark.load(std::memory_order_relaxed);
+                stats.producerStalls    = this->producerStalls.load(std::memory_order_relaxed);
+                stats.consumerStalls    = this->consumerStalls.load(std::memory_order_relaxed);
+
+                return stats;
+            }
+
+        private:
+            const size_t        capacity;
+            const size_t        mask;
+            std::vector<T>      slots;
+
+            /* head is only written by the producer, tail only by the consumer */
+            alignas(64) std::atomic<size_t> head;
+            alignas(64) std::atomic<size_t> tail;
+
+            std::atomic<bool>   producerParked;
+            std::atomic<bool>   consumerParked;
+            sem_t               spaceAvailable;
+            sem_t               dataAvailable;
+
+            std::atomic<size_t>     highWatermark;
+            std::atomic<uint64_t>   producerStalls;
+            std::atomic<uint64_t>   consumerStalls;
+
+            static size_t   RoundUp (size_t capacity)
+            {
+                size_t size = 1;
+                while(size < capacity)
+                    size <<= 1;
+                return size;
+            }
+            void            Wake    (std::atomic<bool> &parked, sem_t &sem)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(parked.load(std::memory_order_relaxed) && parked.exchange(false, std::memory_order_relaxed))
+                    sem_post(&sem);
+            }
+    };
+}
+
+#endif /* SPSCRING_H_ */
@@ -0,0 +1,167 @@
+/*
+ * SegmentBuffer.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "SegmentBuffer.h"
+
+#include <iostream>
+
+using namespace libdashtest;
+
+SegmentBuffer::SegmentBuffer    (size_t framesPerSegment, size_t resumeFrames) :
+               framesPerSegment (framesPerSegment > 0 ? framesPerSegment : 1),
+               resumeFrames     (resumeFrames > 0 ? resumeFrames : 1),
+               segmentDuration  (1),
+               target           (1),
+               segmentsReserved (0),
+               segmentsFetched  (0),
+               framesDecoded    (0),
+               framesPresented  (0),
+               isEndOfStream    (false),
+               created          (std::chrono::steady_clock::now())
+{
+    this->stats.level           = 0;
+    this->stats.target          = this->target;
+    this->stats.maxLevel        = 0;
+    this->stats.bytesHeld       = 0;
+    this->stats.maxBytesHeld    = 0;
+    this->stats.startupSeconds  = 0;
+    this->stats.stalls          = 0;
+    this->stats.stallSeconds    = 0;
+}
+SegmentBuffer::~SegmentBuffer   ()
+{
+}
+
+void        SegmentBuffer::Configure        (double segmentDuration, double targetLevel)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->segmentDuration   = segmentDuration > 0 ? segmentDuration : 1;
+    this->target            = targetLevel > this->segmentDuration ? targetLevel : this->segmentDuration;
+    this->stats.target      = this->target;
+    this->levelChanged.notify_all();
+}
+void        SegmentBuffer::Reserve          ()
+{
+    std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+    /* requested segments count as well, so pipelined requests cannot overshoot */
+    while(this->Seconds(this->segmentsReserved + 1) - this->PresentedSeconds() > this->target)
+        this->levelChanged.wait(lock);
+
+    this->segmentsReserved++;
+}
+void        SegmentBuffer::SegmentFetched   (size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->segmentsFetched++;
+    this->stats.bytesHeld += bytes;
+    if(this->stats.bytesHeld > this->stats.maxBytesHeld)
+        this->stats.maxBytesHeld = this->stats.bytesHeld;
+    if(this->LevelLocked() > this->stats.maxLevel)
+        this->stats.maxLevel = this->LevelLocked();
+}
+void        SegmentBuffer::SegmentFailed    ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    if(this->segmentsReserved > 0)
+        this->segmentsReserved--;
+    this->levelChanged.notify_all();
+}
+void        SegmentBuffer::SegmentConsumed  (size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->stats.bytesHeld -= bytes < this->stats.bytesHeld ? bytes : this->stats.bytesHeld;
+}
+void        SegmentBuffer::FrameDecoded     ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->framesDecoded++;
+    this->frameAvailable.notify_all();
+}
+void        SegmentBuffer::EndOfStream      ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->isEndOfStream = true;
+    this->frameAvailable.notify_all();
+}
+bool        SegmentBuffer::WaitForFrame     ()
+{
+    std::unique_lock<std::mutex> lock(this->monitorMutex);
+
+    if(this->framesDecoded > this->framesPresented)
+        return true;
+    if(this->isEndOfStream)
+        return false;
+
+    /* ran dry (or not started yet): refill before presenting again */
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    while(this->framesDecoded - this->framesPresented < this->resumeFrames && !this->isEndOfStream)
+        this->frameAvailable.wait(lock);
+
+    std::chrono::duration<double> sec = std::chrono::steady_clock::now() - start;
+    if(this->framesPresented == 0)
+    {
+        std::chrono::duration<double> startup = std::chrono::steady_clock::now() - this->created;
+        this->stats.startupSeconds = startup.count();
+    }
+    else
+    {
+        this->stats.stalls++;
+        this->stats.stallSeconds += sec.count();
+        std::cerr << "SegmentBuffer: stall " << this->stats.stalls << " for " << sec.count() << " s" << std::endl;
+    }
+
+    return this->framesDecoded > this->framesPresented;
+}
+void        SegmentBuffer::FramePresented   ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    this->framesPresented++;
+    this->levelChanged.notify_all();
+}
+double      SegmentBuffer::Level            ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    return this->LevelLocked();
+}
+double      SegmentBuffer::Target           ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    return this->target;
+}
+BufferStats SegmentBuffer::Stats            ()
+{
+    std::lock_guard<std::mutex> lock(this->monitorMutex);
+
+    BufferStats stats = this->stats;
+    stats.level = this->LevelLocked();
+
+    return stats;
+}
+double      SegmentBuffer::Seconds          (size_t segments) const
+{
+    return segments * this->segmentDuration;
+}
+double      SegmentBuffer::PresentedSeconds () const
+{
+    return (double) this->framesPresented * this->segmentDuration / this->framesPerSegment;
+}
+double      SegmentBuffer::LevelLocked      () const
+{
+    double level = this->Seconds(this->segmentsFetched) - this->PresentedSeconds();
+
+    return level > 0 ? level : 0;
+}
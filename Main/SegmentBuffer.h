@@ -0,0 +1,99 @@
+/*
+ * SegmentBuffer.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Book-keeping for the client's buffer, measured in seconds of media that
+ * is requested or fetched but not yet presented. The download stage
+ * prefetches until the target level is reached. The renderer starts and,
+ * after running dry, resumes only once enough decoded frames are ready,
+ * so that one slow download or decode does not turn into a stutter.
+ *
+ * Segments and frames themselves travel through the SPSC rings; a
+ * segment's bytes are freed as soon as it is decoded.
+ *****************************************************************************/
+
+#ifndef SEGMENTBUFFER_H_
+#define SEGMENTBUFFER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+
+namespace libdashtest
+{
+    struct BufferStats
+    {
+        double  level;          /* seconds fetched, not yet presented */
+        double  target;
+        double  maxLevel;
+        size_t  bytesHeld;      /* fetched, not yet decoded */
+        size_t  maxBytesHeld;
+        double  startupSeconds;
+        size_t  stalls;
+        double  stallSeconds;
+    };
+
+    class SegmentBuffer
+    {
+        public:
+            /*
+             *  resumeFrames decoded frames must be ready before playback
+             *  starts or resumes after a stall.
+             */
+            SegmentBuffer           (size_t framesPerSegment, size_t resumeFrames);
+            virtual ~SegmentBuffer  ();
+
+            void    Configure       (double segmentDuration, double targetLevel);
+
+            /*
+             *  Download stage: blocks until one more segment fits below the
+             *  target level and counts it as requested.
+             */
+            void    Reserve         ();
+            void    SegmentFetched  (size_t bytes);
+            /*
+             *  Download stage: a reserved segment could not be fetched and
+             *  will never be presented, so it no longer counts as requested.
+             */
+            void    SegmentFailed   ();
+            void    SegmentConsumed (size_t bytes);
+            void    FrameDecoded    ();
+            void    EndOfStream     ();
+
+            /*
+             *  Renderer: returns once a decoded frame may be presented, false
+             *  when the stream has ended and every frame was presented.
+             */
+            bool    WaitForFrame    ();
+            void    FramePresented  ();
+
+            double      Level       ();
+            double      Target      ();
+            BufferStats Stats       ();
+
+        private:
+            size_t      framesPerSegment;
+            size_t      resumeFrames;
+            double      segmentDuration;
+            double      target;
+            size_t      segmentsReserved;
+            size_t      segmentsFetched;
+            size_t      framesDecoded;
+            size_t      framesPresented;
+            bool        isEndOfStream;
+            BufferStats stats;
+
+            std::chrono::steady_clock::time_point   created;
+            std::mutex                              monitorMutex;
+            std::condition_variable                 levelChanged;
+            std::condition_variable                 frameAvailable;
+
+            double  Seconds             (size_t segments) const;
+            double  PresentedSeconds    () const;
+            double  LevelLocked         () const;
+    };
+}
+
+#endif /* SEGMENTBUFFER_H_ */
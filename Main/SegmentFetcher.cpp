@@ -0,0 +1,406 @@
+/*
+ * SegmentFetcher.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "SegmentFetcher.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace libdashtest;
+using namespace dash;
+using namespace dash::mpd;
+
+SegmentFetcher::SegmentFetcher      (const std::string &host, size_t port, size_t connectionCount, size_t splitThreshold) :
+                host                (host),
+                port                (port),
+                splitThreshold      (splitThreshold),
+                mpd                 (NULL),
+                live                (NULL),
+                metricsLog          (NULL),
+                nextConnection      (0),
+                lastThroughput      (0),
+                lastDownloadSeconds (0)
+{
+    this->manager = CreateDashManager();
+
+    this->connections.resize(connectionCount > 0 ? connectionCount : 1, NULL);
+    this->Reconnect();
+}
+SegmentFetcher::~SegmentFetcher     ()
+{
+    for(size_t i = 0; i < this->connections.size(); i++)
+        delete(this->connections.at(i));
+
+    for(size_t i = 0; i < this->requests.size(); i++)
+    {
+        this->DeleteParts(this->requests.at(i));
+        delete(this->requests.at(i));
+    }
+
+    delete(this->mpd);
+    delete(this->manager);
+}
+
+bool                                SegmentFetcher::Open                (const std::string &mpdPath)
+{
+    if(this->requests.size() > 0)
+        return false;
+
+    Request *request        = new Request();
+    request->path           = mpdPath;
+    request->name           = mpdPath;
+    request->representation = 0;
+    request->number         = 0;
+    request->expectedBytes  = 0;
+    request->type           = dash::metrics::MPD;
+
+    this->Send(request);
+    this->requests.push_back(request);
+
+    MediaSegment data;
+    if(!this->Receive(&data))
+        return false;
+
+    std::stringstream url;
+    url << "http://" << this->host << ":" << this->port << mpdPath;
+
+    this->mpd = this->manager->Open(data.data.data(), data.data.size(), url.str());
+    if(this->mpd == NULL)
+        return false;
+
+    this->mpdDocument.swap(data.data);
+
+    if(this->mpd->GetBaseUrls().size() > 0)
+        this->baseUrl = this->mpd->GetBaseUrls().at(0)->GetUrl();
+
+    return this->Representations().size() > 0;
+}
+void                                SegmentFetcher::SetLiveManager      (LiveMPDManager *live)
+{
+    this->live = live;
+}
+void                                SegmentFetcher::SetMetricsLog       (HTTPMetricsLog *log)
+{
+    this->metricsLog = log;
+
+    for(size_t i = 0; i < this->connections.size(); i++)
+        this->connections.at(i)->SetMetricsLog(log);
+}
+bool                                SegmentFetcher::Queue               (size_t representation, size_t number)
+{
+    if(this->mpd == NULL || representation >= this->Representations().size())
+        return false;
+
+    IRepresentation *rep  = this->Representations().at(representation);
+    std::string     media;
+
+    if(this->live != NULL)
+    {
+        if(!this->live->WaitForSegment(representation, number, LIVE_SEGMENT_TIMEOUT) ||
+           !this->live->SegmentMedia(representation, number, media))
+            return false;
+    }
+    else if(rep->GetSegmentList() != NULL)
+    {
+        ISegmentList *list = rep->GetSegmentList();
+        if(number >= list->GetSegmentURLs().size())
+            return false;
+
+        media = list->GetSegmentURLs().at(number)->GetMediaURI();
+    }
+    else
+    {
+        /* $Number$ templates count from @startNumber */
+        ISegmentTemplate *segmentTemplate = this->Template(representation);
+        if(segmentTemplate == NULL ||
+           !segmentTemplate->GetMediaURIFromNumber(media, rep->GetId(), rep->GetBandwidth(), segmentTemplate->GetStartNumber() + number))
+            return false;
+    }
+
+    std::string name = media.substr(media.find("/") + 1);
+
+    Request *request        = new Request();
+    request->path           = this->baseUrl + media;
+    request->name           = name.substr(0, name.rfind("."));
+    request->representation = representation;
+    request->number         = number;
+    request->expectedBytes  = (size_t) (rep->GetBandwidth() * this->SegmentDuration() / 8);
+    request->type           = dash::metrics::MediaSegment;
+
+    this->Send(request);
+    this->requests.push_back(request);
+
+    return true;
+}
+bool                                SegmentFetcher::Receive             (MediaSegment *segment)
+{
+    if(this->requests.empty())
+        return false;
+
+    Request *request = this->requests.front();
+
+    bool isOk = this->ReceiveData(request, segment->data);
+    if(!isOk)
+    {
+        /* a dropped connection stalls everything queued behind it */
+        std::cerr << "SegmentFetcher: reconnecting to " << this->host << std::endl;
+        this->Reconnect();
+        this->Resend();
+        isOk = this->ReceiveData(request, segment->data);
+    }
+
+    this->requests.pop_front();
+    if(!isOk)
+    {
+        this->Reconnect();
+        this->Resend();
+    }
+
+    std::chrono::steady_clock::time_point now   = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point start = request->sent > this->lastReceived ? request->sent : this->lastReceived;
+    std::chrono::duration<double> sec = now - start;
+
+    /* parts run in parallel, the slowest one decides; the connections
+       measure from the request, not from when the reader got to them */
+    double seconds = 0;
+    for(size_t i = 0; i < request->parts.size(); i++)
+        if(request->parts.at(i).seconds > seconds)
+            seconds = request->parts.at(i).seconds;
+
+    if(!isOk || seconds <= 0)
+        seconds = sec.count();
+
+    this->lastReceived          = now;
+    this->lastDownloadSeconds   = seconds;
+    this->lastThroughput        = seconds > 0 ? (segment->data.size() * 8) / seconds : 0;
+
+    segment->index              = request->number;
+    segment->representation     = request->representation;
+    segment->name               = request->name;
+
+    this->DeleteParts(request);
+    delete(request);
+
+    return isOk && segment->data.size() > 0;
+}
+bool                                SegmentFetcher::Fetch               (size_t representation, size_t number, MediaSegment *segment)
+{
+    if(this->requests.size() > 0 || !this->Queue(representation, number))
+        return false;
+
+    return this->Receive(segment);
+}
+size_t                              SegmentFetcher::Queued              () const
+{
+    return this->requests.size();
+}
+IMPD*                               SegmentFetcher::MPD                 ()
+{
+    return this->mpd;
+}
+const std::vector<uint8_t>&         SegmentFetcher::MPDDocument         () const
+{
+    return this->mpdDocument;
+}
+const std::vector<IRepresentation *>&   SegmentFetcher::Representations ()
+{
+    return this->mpd->GetPeriods().at(0)->GetAdaptationSets().at(0)->GetRepresentation();
+}
+double                              SegmentFetcher::SegmentDuration     ()
+{
+    IMultipleSegmentBase *segments = this->Representations().at(0)->GetSegmentList();
+    if(segments == NULL)
+        segments = this->Template(0);
+
+    if(segments == NULL || segments->GetDuration() == 0)
+        return 1;
+
+    uint32_t timescale = segments->GetTimescale() > 0 ? segments->GetTimescale() : 1;
+
+    return (double) segments->GetDuration() / timescale;
+}
+ISegmentTemplate*                   SegmentFetcher::Template            (size_t representation)
+{
+    if(this->Representations().at(representation)->GetSegmentTemplate())
+        return this->Representations().at(representation)->GetSegmentTemplate();
+
+    return this->mpd->GetPeriods().at(0)->GetAdaptationSets().at(0)->GetSegmentTemplate();
+}
+double                              SegmentFetcher::MinBufferTime       ()
+{
+    return LiveMPDManager::ParseDuration(this->mpd->GetMinBufferTime());
+}
+double                              SegmentFetcher::FrameRate           ()
+{
+    IRepresentation *rep  = this->Representations().at(0);
+    std::string     rate  = rep->GetFrameRate();
+
+    /* MPDs from older createContent.sh runs spell it framRate */
+    if(rate.empty())
+    {
+        std::map<std::string, std::string> attributes = rep->GetRawAttributes();
+        if(attributes.find("framRate") != attributes.end())
+            rate = attributes["framRate"];
+    }
+
+    /* "30" or "30000/1001" */
+    double  frameRate   = atof(rate.c_str());
+    size_t  slash       = rate.find('/');
+    if(slash != std::string::npos && atof(rate.substr(slash + 1).c_str()) > 0)
+        frameRate /= atof(rate.substr(slash + 1).c_str());
+
+    return frameRate;
+}
+double                              SegmentFetcher::LastThroughput      () const
+{
+    return this->lastThroughput;
+}
+double                              SegmentFetcher::LastDownloadSeconds () const
+{
+    return this->lastDownloadSeconds;
+}
+void                                SegmentFetcher::Send                (Request *request)
+{
+    size_t count = 1;
+    if(this->connections.size() > 1 && request->expectedBytes >= this->splitThreshold)
+        count = this->connections.size();
+
+    request->parts.resize(count);
+    for(size_t i = 0; i < count; i++)
+    {
+        Part &part = request->parts.at(i);
+
+        if(count == 1)
+        {
+            part.connection = this->nextConnection++ % this->connections.size();
+            part.chunk      = new TestChunk(this->host, this->port, request->path, 0, 0, false, request->type);
+        }
+        else
+        {
+            /* the last part is open-ended, so a size estimate that is too small still works */
+            size_t startByte    = request->expectedBytes * i / count;
+            size_t endByte      = i + 1 == count ? RANGE_TO_END : request->expectedBytes * (i + 1) / count - 1;
+
+            part.connection = i;
+            part.chunk      = new TestChunk(this->host, this->port, request->path, startByte, endByte, true, request->type);
+        }
+
+        PersistentHTTPConnection *connection = this->connections.at(part.connection);
+        if(connection->Init(part.chunk))
+            connection->Schedule(part.chunk);
+    }
+
+    request->sent = std::chrono::steady_clock::now();
+}
+bool                                SegmentFetcher::ReceiveData         (Request *request, std::vector<uint8_t> &data)
+{
+    std::vector<std::thread> readers;
+    for(size_t i = 1; i < request->parts.size(); i++)
+        readers.push_back(std::thread(&SegmentFetcher::ReadPart, this, &request->parts.at(i)));
+
+    this->ReadPart(&request->parts.at(0));
+
+    for(size_t i = 0; i < readers.size(); i++)
+        readers.at(i).join();
+
+    size_t total = 0;
+    for(size_t i = 0; i < request->parts.size(); i++)
+    {
+        Part &part = request->parts.at(i);
+
+        if(!part.isOk)
+            return false;
+
+        if(part.isWhole)
+        {
+            data.swap(part.data);
+            return true;
+        }
+
+        total += part.data.size();
+    }
+
+    if(request->parts.size() == 1)
+    {
+        data.swap(request->parts.at(0).data);
+        return true;
+    }
+
+    data.clear();
+    data.reserve(total);
+    for(size_t i = 0; i < request->parts.size(); i++)
+        data.insert(data.end(), request->parts.at(i).data.begin(), request->parts.at(i).data.end());
+
+    return true;
+}
+void                                SegmentFetcher::ReadPart            (Part *part)
+{
+    PersistentHTTPConnection *connection = this->connections.at(part->connection);
+
+    part->data.clear();
+    part->isWhole   = false;
+    part->isOk      = false;
+    part->seconds   = 0;
+
+    int     ret     = 0;
+    size_t  size    = 0;
+    do
+    {
+        part->data.resize(size + FETCH_READ_SIZE);
+        ret = connection->Read(part->data.data() + size, FETCH_READ_SIZE, part->chunk);
+        if(ret > 0)
+            size += ret;
+    }while(ret > 0);
+    part->data.resize(size);
+
+    /* never scheduled */
+    if(ret < 0)
+        return;
+
+    part->seconds = connection->LastTransferSeconds();
+
+    int status = connection->LastStatusCode();
+
+    /* range starts behind the end of a file smaller than expected */
+    if(status == 416)
+    {
+        part->data.clear();
+        part->isOk = true;
+        return;
+    }
+
+    if(status < 200 || status >= 300 || size != (size_t) connection->LastContentLength())
+        return;
+
+    part->isWhole   = status == 200;
+    part->isOk      = true;
+}
+void                                SegmentFetcher::Reconnect           ()
+{
+    for(size_t i = 0; i < this->connections.size(); i++)
+    {
+        delete(this->connections.at(i));
+        this->connections.at(i) = new PersistentHTTPConnection();
+        this->connections.at(i)->SetMetricsLog(this->metricsLog);
+    }
+}
+void                                SegmentFetcher::Resend              ()
+{
+    for(size_t i = 0; i < this->requests.size(); i++)
+    {
+        this->DeleteParts(this->requests.at(i));
+        this->Send(this->requests.at(i));
+    }
+}
+void                                SegmentFetcher::DeleteParts         (Request *request)
+{
+    for(size_t i = 0; i < request->parts.size(); i++)
+        delete(request->parts.at(i).chunk);
+
+    request->parts.clear();
+}
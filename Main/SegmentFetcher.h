@@ -0,0 +1,133 @@
+/*
+ * SegmentFetcher.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * In-process replacement for running libdash_mcnl_test per segment: the
+ * MPD is downloaded and parsed once, and segments are requested over a
+ * small pool of keep-alive PersistentHTTPConnections straight into
+ * MediaSegment buffers.
+ *
+ * Requests can be pipelined: Queue() sends a request without waiting and
+ * Receive() reads the responses back in queue order. Segments expected to
+ * be larger than the split threshold are requested as one Range: part per
+ * connection, read in parallel and reassembled into one buffer.
+ *****************************************************************************/
+
+#ifndef SEGMENTFETCHER_H_
+#define SEGMENTFETCHER_H_
+
+#include "libdash.h"
+#include "PersistentHTTPConnection.h"
+#include "TestChunk.h"
+#include "MediaSegment.h"
+#include "LiveMPDManager.h"
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#define FETCH_READ_SIZE         32768
+#define RANGE_SPLIT_THRESHOLD   (1024 * 1024)   /* expected segment size in bytes */
+#define LIVE_SEGMENT_TIMEOUT    10              /* seconds Queue() waits for a live segment */
+
+namespace libdashtest
+{
+    class SegmentFetcher
+    {
+        public:
+            SegmentFetcher          (const std::string &host, size_t port, size_t connectionCount = 1,
+                                     size_t splitThreshold = RANGE_SPLIT_THRESHOLD);
+            virtual ~SegmentFetcher ();
+
+            bool    Open    (const std::string &mpdPath);
+            /*
+             *  Takes segment URLs from a refreshed live MPD instead, Queue()
+             *  then waits until the segment is available.
+             */
+            void    SetLiveManager  (LiveMPDManager *live);
+            /*
+             *  Writes the HTTP metrics of every connection of the pool to
+             *  log, which has to outlive the fetcher.
+             */
+            void    SetMetricsLog   (HTTPMetricsLog *log);
+            /*
+             *  Sends the request for media segment number of the given
+             *  representation of the first adaptation set, behind any
+             *  requests still queued. Returns false only for an unknown
+             *  segment; transfer errors are reported by Receive().
+             */
+            bool    Queue   (size_t representation, size_t number);
+            /*
+             *  Reads the oldest queued segment into segment. If a connection
+             *  was dropped, the whole pool reconnects and every queued
+             *  request is sent again once.
+             */
+            bool    Receive (MediaSegment *segment);
+            bool    Fetch   (size_t representation, size_t number, MediaSegment *segment);
+            size_t  Queued  () const;
+
+            dash::mpd::IMPD*                                    MPD                 ();
+            const std::vector<uint8_t>&                         MPDDocument         () const;   /* as downloaded by Open() */
+            const std::vector<dash::mpd::IRepresentation *>&    Representations     ();
+            /*
+             *  The SegmentTemplate of the representation or of the first
+             *  adaptation set, NULL if segments are listed.
+             */
+            dash::mpd::ISegmentTemplate*                        Template            (size_t representation);
+            double                                              SegmentDuration     ();         /* seconds, from the SegmentList or SegmentTemplate */
+            double                                              MinBufferTime       ();         /* seconds, 0 if absent */
+            double                                              FrameRate           ();         /* frames/s, 0 if absent */
+            double                                              LastThroughput      () const;   /* bit/s */
+            double                                              LastDownloadSeconds () const;
+
+        private:
+            struct Part
+            {
+                TestChunk               *chunk;
+                size_t                  connection;
+                std::vector<uint8_t>    data;
+                bool                    isWhole;    /* the server ignored Range: and sent everything */
+                bool                    isOk;
+                double                  seconds;    /* transfer time measured by the connection */
+            };
+            struct Request
+            {
+                std::string                             path;
+                std::string                             name;
+                size_t                                  representation;
+                size_t                                  number;
+                size_t                                  expectedBytes;
+                dash::metrics::HTTPTransactionType      type;
+                std::vector<Part>                       parts;
+                std::chrono::steady_clock::time_point   sent;
+            };
+
+            std::string                             host;
+            size_t                                  port;
+            size_t                                  splitThreshold;
+            std::string                             baseUrl;
+            dash::IDASHManager                      *manager;
+            dash::mpd::IMPD                         *mpd;
+            std::vector<uint8_t>                    mpdDocument;
+            LiveMPDManager                          *live;
+            HTTPMetricsLog                          *metricsLog;
+            std::vector<PersistentHTTPConnection *> connections;
+            size_t                                  nextConnection;
+            std::deque<Request *>                   requests;
+            std::chrono::steady_clock::time_point   lastReceived;
+            double                                  lastThroughput;
+            double                                  lastDownloadSeconds;
+
+            void    Send        (Request *request);
+            bool    ReceiveData (Request *request, std::vector<uint8_t> &data);
+            void    ReadPart    (Part *part);
+            void    Reconnect   ();
+            void    Resend      ();
+            void    DeleteParts (Request *request);
+    };
+}
+
+#endif /* SEGMENTFETCHER_H_ */
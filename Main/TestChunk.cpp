@@ -10,18 +10,33 @@
  *****************************************************************************/
 
 #include "TestChunk.h"
+#include "PersistentHTTPConnection.h"
 
 using namespace dash::network;
 using namespace libdashtest;
 
-TestChunk::TestChunk        (std::string host, size_t port, std::string path, size_t startbyte, size_t endbyte, bool hasByteRange) :
+TestChunk::TestChunk        (std::string host, size_t port, std::string path, size_t startbyte, size_t endbyte, bool hasByteRange,
+                             dash::metrics::HTTPTransactionType type) :
            host             (host),
            port             (port),
            path             (path),
            startbyte        (startbyte),
            endbyte          (endbyte),
-           hasByteRange     (hasByteRange)
+           hasByteRange     (hasByteRange),
+           type             (type)
 {
+    std::stringstream uri;
+    uri << "http://" << host << ":" << port << path;
+    this->uri = uri.str();
+
+    if(hasByteRange)
+    {
+        std::stringstream range;
+        range << startbyte << "-";
+        if(endbyte != RANGE_TO_END)
+            range << endbyte;
+        this->range = range.str();
+    }
 }
 TestChunk::~TestChunk       ()
 {
@@ -61,5 +76,5 @@ std::string&    TestChunk::Range           ()
 }
 dash::metrics::HTTPTransactionType  TestChunk::GetType()
 {
-    return dash::metrics::Other;
+    return this->type;
 }
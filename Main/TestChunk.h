@@ -14,12 +14,15 @@
 
 #include "IChunk.h"
 
+#include <sstream>
+
 namespace libdashtest
 {
     class TestChunk : public dash::network::IChunk
     {
         public:
-            TestChunk           (std::string host, size_t port, std::string path, size_t startbyte, size_t endbyte, bool hasByteRange);
+            TestChunk           (std::string host, size_t port, std::string path, size_t startbyte, size_t endbyte, bool hasByteRange,
+                                 dash::metrics::HTTPTransactionType type = dash::metrics::Other);
             virtual ~TestChunk  ();
 
             virtual std::string&    AbsoluteURI     ();
@@ -41,6 +44,7 @@ namespace libdashtest
             size_t          startbyte;
             size_t          endbyte;
             bool            hasByteRange;
+            dash::metrics::HTTPTransactionType  type;
     };
 }
 
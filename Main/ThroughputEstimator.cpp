@@ -0,0 +1,96 @@
+/*
+ * ThroughputEstimator.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "ThroughputEstimator.h"
+
+#include <math.h>
+
+using namespace libdashtest;
+
+EWMAThroughputEstimator::EWMAThroughputEstimator    (double fastHalfLife, double slowHalfLife)
+{
+    this->fast.halfLife = fastHalfLife;
+    this->slow.halfLife = slowHalfLife;
+    this->Reset();
+}
+EWMAThroughputEstimator::~EWMAThroughputEstimator   ()
+{
+}
+
+void    EWMAThroughputEstimator::AddSample  (size_t bytes, double seconds)
+{
+    if(seconds <= 0)
+        return;
+
+    double throughput = (bytes * 8) / seconds;
+
+    Update(this->fast, throughput, seconds);
+    Update(this->slow, throughput, seconds);
+}
+double  EWMAThroughputEstimator::Estimate   () const
+{
+    double fast = Value(this->fast);
+    double slow = Value(this->slow);
+
+    return fast < slow ? fast : slow;
+}
+void    EWMAThroughputEstimator::Reset      ()
+{
+    this->fast.estimate     = 0;
+    this->fast.totalWeight  = 0;
+    this->slow.estimate     = 0;
+    this->slow.totalWeight  = 0;
+}
+void    EWMAThroughputEstimator::Update     (Average &average, double throughput, double seconds)
+{
+    double alpha = pow(0.5, seconds / average.halfLife);
+
+    average.estimate    = alpha * average.estimate + (1 - alpha) * throughput;
+    average.totalWeight += seconds;
+}
+double  EWMAThroughputEstimator::Value      (const Average &average)
+{
+    if(average.totalWeight <= 0)
+        return 0;
+
+    /* the average starts at zero, undo that bias for the first samples */
+    double zeroFactor = 1 - pow(0.5, average.totalWeight / average.halfLife);
+
+    return average.estimate / zeroFactor;
+}
+
+HarmonicMeanThroughputEstimator::HarmonicMeanThroughputEstimator    (size_t windowSize) :
+                                 windowSize                         (windowSize > 0 ? windowSize : 1)
+{
+}
+HarmonicMeanThroughputEstimator::~HarmonicMeanThroughputEstimator   ()
+{
+}
+
+void    HarmonicMeanThroughputEstimator::AddSample  (size_t bytes, double seconds)
+{
+    if(seconds <= 0 || bytes == 0)
+        return;
+
+    this->samples.push_back((bytes * 8) / seconds);
+    if(this->samples.size() > this->windowSize)
+        this->samples.pop_front();
+}
+double  HarmonicMeanThroughputEstimator::Estimate   () const
+{
+    if(this->samples.empty())
+        return 0;
+
+    double inverseSum = 0;
+    for(size_t i = 0; i < this->samples.size(); i++)
+        inverseSum += 1 / this->samples.at(i);
+
+    return this->samples.size() / inverseSum;
+}
+void    HarmonicMeanThroughputEstimator::Reset      ()
+{
+    this->samples.clear();
+}
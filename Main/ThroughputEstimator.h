@@ -0,0 +1,82 @@
+/*
+ * ThroughputEstimator.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Smoothed network throughput estimates for AbrController. Samples are
+ * whole segment downloads (bytes, seconds); estimates are in bit/s.
+ *****************************************************************************/
+
+#ifndef THROUGHPUTESTIMATOR_H_
+#define THROUGHPUTESTIMATOR_H_
+
+#include <deque>
+#include <stddef.h>
+
+namespace libdashtest
+{
+    class IThroughputEstimator
+    {
+        public:
+            virtual ~IThroughputEstimator () {}
+
+            virtual void    AddSample   (size_t bytes, double seconds)  = 0;
+            /*
+             *  Returns the current estimate in bit/s, 0 before the first sample.
+             */
+            virtual double  Estimate    () const                        = 0;
+            virtual void    Reset       ()                              = 0;
+    };
+
+    /*
+     *  Two exponentially weighted moving averages whose weights decay with
+     *  download time (half-lives in seconds). The estimate is the lower of
+     *  the fast and the slow average, so drops are followed quickly and
+     *  spikes slowly.
+     */
+    class EWMAThroughputEstimator : public IThroughputEstimator
+    {
+        public:
+            EWMAThroughputEstimator             (double fastHalfLife = 3.0, double slowHalfLife = 8.0);
+            virtual ~EWMAThroughputEstimator    ();
+
+            virtual void    AddSample   (size_t bytes, double seconds);
+            virtual double  Estimate    () const;
+            virtual void    Reset       ();
+
+        private:
+            struct Average
+            {
+                double  halfLife;
+                double  estimate;
+                double  totalWeight;
+            };
+
+            Average fast;
+            Average slow;
+
+            static void     Update      (Average &average, double throughput, double seconds);
+            static double   Value       (const Average &average);
+    };
+
+    /*
+     *  Harmonic mean of the last windowSize samples, which keeps a single
+     *  fast download from dominating the estimate.
+     */
+    class HarmonicMeanThroughputEstimator : public IThroughputEstimator
+    {
+        public:
+            HarmonicMeanThroughputEstimator             (size_t windowSize = 5);
+            virtual ~HarmonicMeanThroughputEstimator    ();
+
+            virtual void    AddSample   (size_t bytes, double seconds);
+            virtual double  Estimate    () const;
+            virtual void    Reset       ();
+
+        private:
+            size_t              windowSize;
+            std::deque<double>  samples;    /* bit/s */
+    };
+}
+
+#endif /* THROUGHPUTESTIMATOR_H_ */
@@ -0,0 +1,151 @@
+/*
+ * VPCCSegmentDecoder.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *****************************************************************************/
+
+#include "VPCCSegmentDecoder.h"
+
+#include "PCCGroupOfFrames.h"
+#include "PCCContext.h"
+#include "PCCFrameContext.h"
+#include "PCCDecoder.h"
+#include "PCCBitstreamReader.h"
+
+#include <iostream>
+#include <cstdlib>
+
+using namespace libdashtest;
+using namespace pcc;
+
+VPCCSegmentDecoder::VPCCSegmentDecoder  () :
+                    isInit              (false)
+{
+}
+VPCCSegmentDecoder::~VPCCSegmentDecoder ()
+{
+}
+
+bool    VPCCSegmentDecoder::Init        (const std::vector<std::string> &options)
+{
+    for(size_t i = 0; i < options.size(); i++)
+    {
+        std::string option = options.at(i);
+
+        if(option.compare(0, 2, "--"))
+            continue;
+
+        size_t pos = option.find('=');
+        if(pos == std::string::npos)
+            continue;
+
+        if(!this->SetOption(option.substr(2, pos - 2), option.substr(pos + 1)))
+            std::cerr << "VPCCSegmentDecoder: unknown option " << option << std::endl;
+    }
+
+    /* Same fix-ups as PCCDecoderParameters::check(), minus the stream path test */
+    if(!this->params.inverseColorSpaceConversionConfig_.empty())
+    {
+        this->params.colorTransform_ = COLOR_TRANSFORM_NONE;
+    }
+    else
+    {
+        this->params.colorSpaceConversionPath_ = "";
+    }
+
+    this->isInit = true;
+    return this->isInit;
+}
+bool    VPCCSegmentDecoder::SetOption   (const std::string &key, const std::string &value)
+{
+    if(key == "videoDecoderOccupancyPath")
+        this->params.videoDecoderOccupancyPath_ = value;
+    else if(key == "videoDecoderGeometryPath")
+        this->params.videoDecoderGeometryPath_ = value;
+    else if(key == "videoDecoderAttributePath")
+        this->params.videoDecoderAttributePath_ = value;
+    else if(key == "colorSpaceConversionPath")
+        this->params.colorSpaceConversionPath_ = value;
+    else if(key == "inverseColorSpaceConversionConfig")
+        this->params.inverseColorSpaceConversionConfig_ = value;
+    else if(key == "nbThread")
+        this->params.nbThread_ = (size_t) atoi(value.c_str());
+    else if(key == "parallelVideoDecoding")
+        this->params.parallelVideoDecoding_ = atoi(value.c_str()) != 0;
+    else if(key == "keepIntermediateFiles")
+        this->params.keepIntermediateFiles_ = atoi(value.c_str()) != 0;
+    else if(key == "patchColorSubsampling")
+        this->params.patchColorSubsampling_ = atoi(value.c_str()) != 0;
+    else if(key == "startFrameNumber")
+        this->params.startFrameNumber_ = (size_t) atoi(value.c_str());
+    else
+        return false;
+
+    return true;
+}
+bool    VPCCSegmentDecoder::Decode      (const std::string &name, std::vector<uint8_t> &segment, const FrameCallback &onFrame)
+{
+    if(!this->isInit || segment.empty())
+        return false;
+
+    PCCDecoderParameters    params  = this->params;
+    PCCBitstream            bitstream;
+    PCCBitstreamStat        bitstreamStat;
+    PCCLogger               logger;
+
+    params.compressedStreamPath_ = name + ".bin";
+    logger.initilalize(name, false);
+
+    if(!bitstream.initialize(segment))
+        return false;
+
+    bitstreamStat.setHeader(bitstream.size());
+
+    size_t frameCount = 0;
+
+    PCCDecoder decoder;
+    decoder.setLogger(logger);
+    decoder.setParameters(params);
+    decoder.setFrameCallback([&](PCCPointSet3 &frame, size_t) {
+        onFrame(frame);
+        frameCount++;
+    });
+
+    SampleStreamV3CUnit ssvu;
+    size_t headerSize = PCCBitstreamReader::read(bitstream, ssvu);
+    bitstreamStat.incrHeader(headerSize);
+
+    bool moreData = true;
+    while(moreData)
+    {
+        PCCGroupOfFrames    reconstructs;
+        PCCContext          context;
+        PCCBitstreamReader  bitstreamReader;
+
+        context.setBitstreamStat(bitstreamStat);
+        if(bitstreamReader.decode(ssvu, context) == 0)
+            break;
+
+        if(context.checkProfile() != 0)
+            return false;
+
+        params.setReconstructionParameters(context.getVps().getProfileTierLevel().getProfileReconstructionIdc());
+        decoder.setReconstructionParameters(params);
+
+        context.resizeAtlas(context.getVps().getAtlasCountMinus1() + 1);
+        for(uint32_t atlId = 0; atlId < context.getVps().getAtlasCountMinus1() + 1; atlId++)
+        {
+            context.getAtlas(atlId).allocateVideoFrames(context, 0);
+            context.setAtlasIndex(atlId);
+
+            if(decoder.decode(context, reconstructs, atlId) != 0)
+                return false;
+
+            reconstructs.clear();
+        }
+
+        moreData = (ssvu.getV3CUnitCount() > 0);
+    }
+
+    return frameCount > 0;
+}
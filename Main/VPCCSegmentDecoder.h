@@ -0,0 +1,61 @@
+/*
+ * VPCCSegmentDecoder.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - Client
+ *
+ * Decodes a downloaded V-PCC segment (.bin) in-process with PccLibDecoder
+ * instead of running PccAppDecoder and reading the PLY files back.
+ *****************************************************************************/
+
+#ifndef VPCCSEGMENTDECODER_H_
+#define VPCCSEGMENTDECODER_H_
+
+#include "PCCCommon.h"
+#include "PCCBitstream.h"
+#include "PCCDecoderParameters.h"
+#include "PCCPointSet.h"
+#include "PCCLogger.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace libdashtest
+{
+    class VPCCSegmentDecoder
+    {
+        public:
+            /*
+             *  Called on the decoding thread with each reconstructed frame, in
+             *  presentation order, as soon as it is complete. It may move the
+             *  frame away.
+             */
+            typedef std::function<void (pcc::PCCPointSet3 &frame)> FrameCallback;
+
+            VPCCSegmentDecoder          ();
+            virtual ~VPCCSegmentDecoder ();
+
+            /*
+             *  Options use the PccAppDecoder command line syntax, one per entry
+             *  (e.g. the lines of decOpt.txt: "--nbThread=4").
+             */
+            bool    Init    (const std::vector<std::string> &options);
+
+            /*
+             *  Decodes every GOF found in the segment bytes and hands every
+             *  frame to onFrame while the rest of its GOF is still being
+             *  decoded. name is used as the base name of the decoder's
+             *  intermediate and log files.
+             */
+            bool    Decode  (const std::string &name, std::vector<uint8_t> &segment, const FrameCallback &onFrame);
+
+        private:
+            pcc::PCCDecoderParameters   params;
+            bool                        isInit;
+
+            bool    SetOption   (const std::string &key, const std::string &value);
+    };
+}
+
+#endif /* VPCCSEGMENTDECODER_H_ */
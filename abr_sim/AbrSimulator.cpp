@@ -0,0 +1,204 @@
+/*
+ * AbrSimulator.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - ABR simulator
+ *****************************************************************************/
+
+#include "AbrSimulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <math.h>
+
+using namespace libdashtest;
+
+#define QOE_STALL_PENALTY   4.3
+
+NetworkTrace::NetworkTrace  () :
+              period        (0)
+{
+}
+NetworkTrace::~NetworkTrace ()
+{
+}
+
+bool    NetworkTrace::Load          (const std::string &path)
+{
+    std::ifstream file(path.c_str());
+    if(!file)
+        return false;
+
+    this->times.clear();
+    this->throughputs.clear();
+
+    double time, mbps;
+    while(file >> time >> mbps)
+    {
+        if(!this->times.empty() && time <= this->times.back())
+            continue;
+
+        this->times.push_back(time);
+        this->throughputs.push_back(mbps * 1000000);
+    }
+
+    if(this->times.empty() || *std::max_element(this->throughputs.begin(), this->throughputs.end()) <= 0)
+        return false;
+
+    /* the last sample lasts as long as the one before it */
+    double last = this->times.size() > 1 ? this->times.back() - this->times.at(this->times.size() - 2) : 1;
+    this->period = this->times.back() - this->times.front() + last;
+
+    return true;
+}
+double  NetworkTrace::TransferTime  (double time, double bits) const
+{
+    double start    = time;
+    double offset   = fmod(time, this->period);
+    size_t i        = std::upper_bound(this->times.begin(), this->times.end(), this->times.front() + offset) - this->times.begin();
+    i = i > 0 ? i - 1 : 0;
+
+    while(bits > 0)
+    {
+        double end      = i + 1 < this->times.size() ? this->times.at(i + 1) - this->times.front() : this->period;
+        double span     = end - offset;
+        double capacity = this->throughputs.at(i) * span;
+
+        if(capacity >= bits)
+        {
+            time += bits / this->throughputs.at(i);
+            break;
+        }
+
+        bits    -= capacity;
+        time    += span;
+        offset  = end;
+        if(++i == this->times.size())
+        {
+            i       = 0;
+            offset  = 0;
+        }
+    }
+
+    return time - start;
+}
+double  NetworkTrace::Duration      () const
+{
+    return this->period;
+}
+
+AbrSimulator::AbrSimulator  (const NetworkTrace &trace, const SimulationConfig &config) :
+              trace         (trace),
+              config        (config)
+{
+}
+AbrSimulator::~AbrSimulator ()
+{
+}
+
+SimulationResult    AbrSimulator::Run   (AbrController &controller)
+{
+    struct DecodeReport
+    {
+        double  finish;
+        size_t  representation;
+        double  seconds;
+    };
+
+    const SimulationConfig  &c = this->config;
+    SimulationResult        result;
+    std::vector<double>     playStart;
+    std::vector<double>     workerFree(c.decodeWorkers > 0 ? c.decodeWorkers : 1, 0);
+    std::vector<DecodeReport> reports;
+    double                  time        = 0;
+    double                  lastReady   = 0;
+    double                  bitrateSum  = 0;
+
+    result.switches     = 0;
+    result.stalls       = 0;
+    result.stallSeconds = 0;
+    result.qoe          = 0;
+
+    for(size_t k = 0; k < c.segmentCount; k++)
+    {
+        /* seconds fetched but not yet presented, as Main counts them */
+        double buffer;
+        while(true)
+        {
+            double played = 0;
+            for(size_t j = 0; j < playStart.size(); j++)
+                played += std::min(std::max(time - playStart.at(j), 0.0), c.segmentDuration);
+
+            buffer = k * c.segmentDuration - played;
+            if(buffer <= c.bufferCapacity - c.segmentDuration)
+                break;
+
+            /* the download stage blocks on the full segment queue */
+            time += buffer - (c.bufferCapacity - c.segmentDuration);
+        }
+
+        for(size_t i = 0; i < reports.size();)
+        {
+            if(reports.at(i).finish > time)
+            {
+                i++;
+                continue;
+            }
+            controller.AddDecode(reports.at(i).representation, reports.at(i).seconds);
+            reports.erase(reports.begin() + i);
+        }
+
+        size_t representation   = controller.Select(buffer, c.bufferCapacity, c.segmentDuration);
+        double bits             = (double) c.bandwidths.at(representation) * c.segmentDuration;
+        double download         = c.latency + this->trace.TransferTime(time + c.latency, bits);
+
+        time += download;
+        controller.AddDownload((size_t) (bits / 8), download);
+
+        std::vector<double>::iterator worker = std::min_element(workerFree.begin(), workerFree.end());
+        DecodeReport report;
+        report.seconds          = c.decodeSeconds.at(representation);
+        report.finish           = std::max(time, *worker) + report.seconds;
+        report.representation   = representation;
+        *worker = report.finish;
+        reports.push_back(report);
+
+        /* segments are presented in order, back to back once started */
+        double ready = std::max(report.finish, lastReady);
+        lastReady = ready;
+
+        double start = ready;
+        if(k > 0)
+        {
+            double previousEnd = playStart.back() + c.segmentDuration;
+            if(ready > previousEnd)
+            {
+                result.stalls++;
+                result.stallSeconds += ready - previousEnd;
+            }
+            else
+            {
+                start = previousEnd;
+            }
+        }
+        else
+        {
+            result.startupSeconds = ready;
+        }
+        playStart.push_back(start);
+
+        double mbps = c.bandwidths.at(representation) / 1000000.0;
+        bitrateSum  += c.bandwidths.at(representation);
+        result.qoe  += mbps;
+        if(k > 0 && representation != result.representations.back())
+        {
+            result.switches++;
+            result.qoe -= fabs(mbps - c.bandwidths.at(result.representations.back()) / 1000000.0);
+        }
+        result.representations.push_back(representation);
+    }
+
+    result.qoe              -= QOE_STALL_PENALTY * result.stallSeconds;
+    result.averageBitrate   = c.segmentCount > 0 ? bitrateSum / c.segmentCount : 0;
+
+    return result;
+}
@@ -0,0 +1,81 @@
+/*
+ * AbrSimulator.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - ABR simulator
+ *
+ * Replays a throughput trace against an AbrController, modelling the
+ * client's download -> decode workers -> playback pipeline, so that
+ * policies can be compared without a server.
+ *****************************************************************************/
+
+#ifndef ABRSIMULATOR_H_
+#define ABRSIMULATOR_H_
+
+#include "AbrController.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace libdashtest
+{
+    /*
+     *  One sample per line: "<time in seconds> <throughput in Mbit/s>". Each
+     *  sample holds until the next one; the trace repeats when it runs out.
+     */
+    class NetworkTrace
+    {
+        public:
+            NetworkTrace            ();
+            virtual ~NetworkTrace   ();
+
+            bool    Load            (const std::string &path);
+            /*
+             *  Seconds needed to receive bits when the transfer starts at time.
+             */
+            double  TransferTime    (double time, double bits) const;
+            double  Duration        () const;
+
+        private:
+            std::vector<double>     times;
+            std::vector<double>     throughputs;    /* bit/s */
+            double                  period;
+    };
+
+    struct SimulationConfig
+    {
+        std::vector<uint32_t>   bandwidths;         /* bit/s, MPD order */
+        std::vector<double>     decodeSeconds;      /* per representation, one segment on one worker */
+        size_t                  segmentCount;
+        double                  segmentDuration;    /* seconds */
+        double                  bufferCapacity;     /* seconds */
+        size_t                  decodeWorkers;
+        double                  latency;            /* request round trip, seconds */
+    };
+
+    struct SimulationResult
+    {
+        std::vector<size_t>     representations;    /* chosen per segment */
+        double                  averageBitrate;     /* bit/s */
+        size_t                  switches;
+        size_t                  stalls;
+        double                  stallSeconds;
+        double                  startupSeconds;
+        double                  qoe;                /* sum Mbit/s - 4.3 * stall s - sum |switch Mbit/s| */
+    };
+
+    class AbrSimulator
+    {
+        public:
+            AbrSimulator            (const NetworkTrace &trace, const SimulationConfig &config);
+            virtual ~AbrSimulator   ();
+
+            SimulationResult    Run (AbrController &controller);
+
+        private:
+            const NetworkTrace      &trace;
+            SimulationConfig        config;
+    };
+}
+
+#endif /* ABRSIMULATOR_H_ */
@@ -0,0 +1,164 @@
+/*
+ * abr_sim.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - ABR simulator
+ *
+ * Usage: abr_sim TRACE --bandwidths=B0,B1,.. --decode=D0,D1,.. [options]
+ *
+ *   --bandwidths=  representation @bandwidth in bit/s, MPD order
+ *   --decode=      decode time of one segment per representation in seconds
+ *   --segments=    number of segments (default: trace length)
+ *   --duration=    segment duration in seconds (default 1)
+ *   --buffer=      pipeline capacity in seconds (default 6)
+ *   --workers=     decode workers (default 1)
+ *   --latency=     request round trip in seconds (default 0.08)
+ *   --policy=      throughput | buffer | hybrid | all (default all)
+ *   --estimator=   ewma | harmonic | all (default all)
+ *****************************************************************************/
+
+#include "AbrSimulator.h"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+using namespace libdashtest;
+using namespace std;
+
+static vector<double> parse_list(const string &value)
+{
+	vector<double> list;
+	stringstream stream(value);
+	string item;
+
+	while(getline(stream, item, ','))
+		list.push_back(atof(item.c_str()));
+
+	return list;
+}
+
+static IAbrPolicy * create_policy(const string &name)
+{
+	if(name == "throughput")
+		return new ThroughputPolicy();
+	if(name == "buffer")
+		return new BufferPolicy();
+	if(name == "hybrid")
+		return new HybridPolicy();
+	return 0x0;
+}
+
+static IThroughputEstimator * create_estimator(const string &name)
+{
+	if(name == "ewma")
+		return new EWMAThroughputEstimator();
+	if(name == "harmonic")
+		return new HarmonicMeanThroughputEstimator();
+	return 0x0;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc < 2) {
+		cerr << "usage: abr_sim TRACE --bandwidths=B0,B1,.. --decode=D0,D1,.. [--segments=N] [--duration=S]"
+			<< " [--buffer=S] [--workers=N] [--latency=S] [--policy=NAME|all] [--estimator=NAME|all]\n";
+		return 1;
+	}
+
+	SimulationConfig config;
+	config.segmentCount = 0;
+	config.segmentDuration = 1;
+	config.bufferCapacity = 6;
+	config.decodeWorkers = 1;
+	config.latency = 0.08;
+	string policy = "all";
+	string estimator = "all";
+
+	for(int i = 2 ; i < argc ; i++) {
+		string arg = argv[i];
+		size_t eq = arg.find('=');
+		string key = arg.substr(0, eq);
+		string value = eq == string::npos ? "" : arg.substr(eq + 1);
+
+		if(key == "--bandwidths") {
+			vector<double> list = parse_list(value);
+			for(size_t j = 0 ; j < list.size() ; j++)
+				config.bandwidths.push_back((uint32_t) list.at(j));
+		}
+		else if(key == "--decode") config.decodeSeconds = parse_list(value);
+		else if(key == "--segments") config.segmentCount = atoi(value.c_str());
+		else if(key == "--duration") config.segmentDuration = atof(value.c_str());
+		else if(key == "--buffer") config.bufferCapacity = atof(value.c_str());
+		else if(key == "--workers") config.decodeWorkers = atoi(value.c_str());
+		else if(key == "--latency") config.latency = atof(value.c_str());
+		else if(key == "--policy") policy = value;
+		else if(key == "--estimator") estimator = value;
+		else {
+			cerr << "unknown option " << arg << "\n";
+			return 1;
+		}
+	}
+
+	NetworkTrace trace;
+	if(!trace.Load(argv[1])) {
+		cerr << "cannot read trace " << argv[1] << "\n";
+		return 1;
+	}
+	if(config.bandwidths.empty() || config.segmentDuration <= 0) {
+		cerr << "--bandwidths and a positive --duration are required\n";
+		return 1;
+	}
+	// Without measurements decoding is assumed to be free
+	config.decodeSeconds.resize(config.bandwidths.size(), 0);
+	if(config.segmentCount == 0)
+		config.segmentCount = (size_t) (trace.Duration() / config.segmentDuration);
+	if(config.bufferCapacity < 2 * config.segmentDuration)
+		config.bufferCapacity = 2 * config.segmentDuration;
+
+	vector<string> policies;
+	vector<string> estimators;
+	if(policy == "all") {
+		policies.push_back("throughput");
+		policies.push_back("buffer");
+		policies.push_back("hybrid");
+	}
+	else policies.push_back(policy);
+	if(estimator == "all") {
+		estimators.push_back("ewma");
+		estimators.push_back("harmonic");
+	}
+	else estimators.push_back(estimator);
+
+	cout << left << setw(12) << "policy" << setw(10) << "estimator"
+		<< right << setw(12) << "avg kbit/s" << setw(10) << "switches"
+		<< setw(8) << "stalls" << setw(10) << "stall s" << setw(10) << "startup"
+		<< setw(10) << "QoE" << "\n";
+
+	AbrSimulator simulator(trace, config);
+	for(size_t p = 0 ; p < policies.size() ; p++) {
+		for(size_t e = 0 ; e < estimators.size() ; e++) {
+			IAbrPolicy * abrPolicy = create_policy(policies.at(p));
+			IThroughputEstimator * abrEstimator = create_estimator(estimators.at(e));
+			if(abrPolicy == 0x0 || abrEstimator == 0x0) {
+				cerr << "unknown policy or estimator\n";
+				delete abrPolicy;
+				delete abrEstimator;
+				return 1;
+			}
+
+			AbrController controller(config.bandwidths, abrEstimator, abrPolicy, config.decodeWorkers);
+			SimulationResult result = simulator.Run(controller);
+
+			cout << left << setw(12) << policies.at(p) << setw(10) << estimators.at(e)
+				<< right << fixed << setprecision(1) << setw(12) << result.averageBitrate / 1000
+				<< setw(10) << result.switches << setw(8) << result.stalls
+				<< setprecision(2) << setw(10) << result.stallSeconds << setw(10) << result.startupSeconds
+				<< setw(10) << result.qoe << "\n";
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,540 @@
+/*
+ * async_check.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - AsyncConnectionManager check
+ *
+ * Usage: async_check
+ *
+ * Starts an HTTP/1.1 keep-alive server on a loopback port that writes every
+ * response in small pieces, so the event loops see partial headers, partial
+ * chunk lines and partial bodies, and downloads chunks through
+ * AbstractChunk::StartDownload(IConnection *) on Main's
+ * PersistentHTTPConnection, i.e. through the AsyncConnectionManager loops:
+ *
+ *   pipelined      dozens of chunks on one connection, started in reverse
+ *                  order, have to complete in the order they were sent
+ *   connections    four connections whose chunks are started interleaved
+ *                  and share the loops
+ *   abort          a response stalls half way; a chunk queued behind it and
+ *                  then the stalled one are aborted, and both have to end
+ *                  without another byte from the server
+ *
+ * Every chunk has its own byte pattern and has to arrive byte for byte.
+ * Exits with 1 when any case fails.
+ *****************************************************************************/
+
+#include "AbstractChunk.h"
+#include "PersistentHTTPConnection.h"
+#include "TestChunk.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dash::network;
+using namespace libdashtest;
+using namespace std;
+
+#if defined MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+static const size_t CHUNK_COUNT = 48;
+static const size_t PIECE_BYTES = 5000;     // bytes per write of the server
+static const size_t CHUNKED_BYTES = 4000;   // bytes per chunk of a Transfer-Encoding: chunked body
+static const size_t STALL_BYTES = 200000;
+static const size_t STALL_SENT = 60000;     // bytes of the stalled response sent before it stops
+static const int ABORT_LIMIT_MS = 1000;     // an abort on a silent socket has to end within this
+static const int WATCHDOG_S = 60;
+
+static const char *STALL_PATH = "/async/stall.bin";
+
+static map<string, string> files;
+static int listen_socket = -1;
+static int server_port = 0;
+static thread server_thread;
+static vector<thread> connection_threads;
+
+/* Server behaviour and counters of the running case */
+static atomic<bool> release(false);     // lets the stalled response go on
+static atomic<int> accepted(0);
+static atomic<int> open_connections(0);
+static atomic<int> requests(0);
+
+static string chunk_path(size_t number)
+{
+	return "/async/c" + to_string(number) + ".bin";
+}
+
+static string chunk_bytes(size_t number)
+{
+	string data(1000 + number * 1531, '\0');
+	for(size_t i = 0 ; i < data.size() ; i++)
+		data[i] = (char) ((i * 13 + number * 29) ^ (i >> 7));
+	return data;
+}
+
+static bool is_chunked(const string &path, const string &body)
+{
+	/* every third response has a chunked body */
+	return path != STALL_PATH && body.size() % 3 == 0;
+}
+
+static bool send_all(int socket, const string &data)
+{
+	size_t sent = 0;
+	while(sent < data.size()) {
+		ssize_t size = send(socket, data.data() + sent, data.size() - sent, SEND_FLAGS);
+		if(size <= 0)
+			return false;
+		sent += size;
+	}
+	return true;
+}
+
+/* "GET /path HTTP/1.1" */
+static string reply(const string &request)
+{
+	size_t start = request.find(' ') + 1;
+	string target = request.substr(start, request.find(' ', start) - start);
+
+	map<string, string>::const_iterator file = files.find(target);
+	if(file == files.end())
+		return "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+
+	const string &body = file->second;
+	stringstream response;
+	if(!is_chunked(target, body)) {
+		response << "HTTP/1.1 200 OK\r\nContent-Length: " << body.size() << "\r\n\r\n" << body;
+		return response.str();
+	}
+
+	response << "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n";
+	for(size_t offset = 0 ; offset < body.size() ; offset += CHUNKED_BYTES) {
+		size_t size = min(CHUNKED_BYTES, body.size() - offset);
+		response << hex << size << dec << "\r\n" << body.substr(offset, size) << "\r\n";
+	}
+	response << "0\r\n\r\n";
+	return response.str();
+}
+
+/* Writes the response in pieces, the first one ends inside the status line */
+static bool send_pieces(int socket, const string &response, size_t stop)
+{
+	size_t sent = 0;
+	while(sent < response.size()) {
+		if(sent >= stop) {
+			while(!release)
+				this_thread::sleep_for(chrono::milliseconds(1));
+			stop = response.size();
+		}
+
+		size_t size = sent == 0 ? 10 : min(PIECE_BYTES, stop - sent);
+		if(!send_all(socket, response.substr(sent, size)))
+			return false;
+		sent += size;
+
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+	return true;
+}
+
+static void serve_connection(int socket)
+{
+	string buffer;
+	char data[4096];
+
+	for(;;) {
+		size_t end;
+		while((end = buffer.find("\r\n\r\n")) == string::npos) {
+			ssize_t size = recv(socket, data, sizeof(data), 0);
+			if(size <= 0) {
+				close(socket);
+				open_connections--;
+				return;
+			}
+			buffer.append(data, size);
+		}
+
+		string request = buffer.substr(0, end + 4);
+		buffer.erase(0, end + 4);
+		requests++;
+
+		string response = reply(request);
+		size_t stop = request.find(STALL_PATH) != string::npos ? response.size() - (STALL_BYTES - STALL_SENT) : response.size();
+		if(!send_pieces(socket, response, stop))
+			break;
+	}
+
+	shutdown(socket, SHUT_RDWR);
+	close(socket);
+	open_connections--;
+}
+
+static void serve()
+{
+	for(;;) {
+		int socket = accept(listen_socket, 0x0, 0x0);
+		if(socket < 0)
+			return;
+
+		accepted++;
+		open_connections++;
+		connection_threads.push_back(thread(serve_connection, socket));
+	}
+}
+
+static bool start_server()
+{
+	listen_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+
+	socklen_t length = sizeof(addr);
+	if(listen_socket < 0 || bind(listen_socket, (sockaddr *) &addr, sizeof(addr)) != 0 ||
+	   listen(listen_socket, 16) != 0 || getsockname(listen_socket, (sockaddr *) &addr, &length) != 0)
+		return false;
+
+	server_port = ntohs(addr.sin_port);
+
+	for(size_t c = 0 ; c < CHUNK_COUNT ; c++)
+		files[chunk_path(c)] = chunk_bytes(c);
+	files[STALL_PATH] = string(STALL_BYTES, 's');
+
+	server_thread = thread(serve);
+	return true;
+}
+
+static void stop_server()
+{
+	release = true;
+
+	shutdown(listen_socket, SHUT_RDWR);
+	close(listen_socket);
+	server_thread.join();
+
+	/* the connections are gone, so every connection thread has ended or will by now */
+	for(size_t i = 0 ; i < connection_threads.size() ; i++)
+		connection_threads[i].join();
+}
+
+static void reset_server()
+{
+	/* connections of the previous case may still be writing what was queued on them */
+	while(open_connections > 0)
+		this_thread::sleep_for(chrono::milliseconds(1));
+
+	release = false;
+	accepted = 0;
+	requests = 0;
+}
+
+/* The order in which the loops ended the downloads */
+static mutex finished_lock;
+static vector<size_t> finished;
+
+class CheckChunk : public AbstractChunk, public IDownloadObserver
+{
+	public:
+		CheckChunk(const string &path, size_t number) :
+			test("127.0.0.1", server_port, path, 0, 0, false), number(number), state(NOT_STARTED)
+		{
+			this->AttachDownloadObserver(this);
+		}
+
+		string &AbsoluteURI() { return this->test.AbsoluteURI(); }
+		string &Host() { return this->test.Host(); }
+		size_t Port() { return this->test.Port(); }
+		string &Path() { return this->test.Path(); }
+		string &Range() { return this->test.Range(); }
+		size_t StartByte() { return this->test.StartByte(); }
+		size_t EndByte() { return this->test.EndByte(); }
+		bool HasByteRange() { return this->test.HasByteRange(); }
+		dash::metrics::HTTPTransactionType GetType() { return this->test.GetType(); }
+
+		void OnDownloadRateChanged(uint64_t) {}
+		void OnDownloadStateChanged(DownloadState state)
+		{
+			this->state = state;
+			if(state == COMPLETED || state == ABORTED) {
+				lock_guard<mutex> lock(finished_lock);
+				finished.push_back(this->number);
+			}
+		}
+
+		TestChunk test;
+		size_t number;
+		atomic<int> state;
+};
+
+static void reset_finished()
+{
+	lock_guard<mutex> lock(finished_lock);
+	finished.clear();
+}
+
+static vector<size_t> finished_order()
+{
+	lock_guard<mutex> lock(finished_lock);
+	return finished;
+}
+
+/* Reads the chunk up to its end and compares it with what was served */
+static bool receive(CheckChunk *chunk, string &error)
+{
+	string data;
+	uint8_t buffer[8192];
+	int size;
+	while((size = chunk->Read(buffer, sizeof(buffer))) > 0)
+		data.append((const char *) buffer, size);
+
+	const string &expected = files[chunk->test.Path()];
+	if(chunk->state != COMPLETED) {
+		error = "chunk " + to_string(chunk->number) + " ended in state " + to_string((int) chunk->state);
+		return false;
+	}
+	if(data != expected) {
+		error = "chunk " + to_string(chunk->number) + " came back with " + to_string(data.size()) + " of "
+			+ to_string(expected.size()) + " bytes";
+		if(data.size() == expected.size())
+			error += ", content differs";
+		return false;
+	}
+	return true;
+}
+
+/* Sends the request of the chunk on the connection, the download itself is started by the caller */
+static bool schedule(PersistentHTTPConnection *connection, CheckChunk *chunk, string &error)
+{
+	if(!connection->Init(chunk) || !connection->Schedule(chunk)) {
+		error = "cannot send the request of chunk " + to_string(chunk->number);
+		return false;
+	}
+	return true;
+}
+
+static bool start(PersistentHTTPConnection *connection, CheckChunk *chunk, string &error)
+{
+	if(!chunk->StartDownload(connection)) {
+		error = "cannot start chunk " + to_string(chunk->number);
+		return false;
+	}
+	return true;
+}
+
+static bool check_pipelined(string &error)
+{
+	reset_server();
+	reset_finished();
+
+	PersistentHTTPConnection *connection = new PersistentHTTPConnection();
+	vector<CheckChunk *> chunks;
+	for(size_t c = 0 ; c < CHUNK_COUNT ; c++)
+		chunks.push_back(new CheckChunk(chunk_path(c), c));
+
+	bool ok = true;
+	for(size_t c = 0 ; c < CHUNK_COUNT && ok ; c++)
+		ok = schedule(connection, chunks[c], error);
+
+	/* the loop has to follow the order on the wire, not the one the downloads were added in */
+	for(size_t c = CHUNK_COUNT ; c > 0 && ok ; c--)
+		ok = start(connection, chunks[c - 1], error);
+
+	for(size_t c = 0 ; c < CHUNK_COUNT && ok ; c++)
+		ok = receive(chunks[c], error);
+
+	if(ok) {
+		vector<size_t> order = finished_order();
+		for(size_t i = 0 ; i < order.size() && ok ; i++)
+			if(order[i] != i) {
+				error = "chunk " + to_string(order[i]) + " completed as number " + to_string(i);
+				ok = false;
+			}
+		if(ok && accepted != 1) {
+			error = to_string(accepted) + " connections instead of one";
+			ok = false;
+		}
+	}
+
+	delete connection;
+	for(size_t c = 0 ; c < chunks.size() ; c++)
+		delete chunks[c];
+	return ok;
+}
+
+static bool check_connections(string &error)
+{
+	reset_server();
+	reset_finished();
+
+	static const size_t CONNECTIONS = 4;
+
+	vector<PersistentHTTPConnection *> connections;
+	vector<CheckChunk *> chunks;
+	for(size_t i = 0 ; i < CONNECTIONS ; i++)
+		connections.push_back(new PersistentHTTPConnection());
+	for(size_t c = 0 ; c < CHUNK_COUNT ; c++)
+		chunks.push_back(new CheckChunk(chunk_path(c), c));
+
+	/* chunk c goes to connection c % CONNECTIONS, so the downloads of all of them are added interleaved */
+	bool ok = true;
+	for(size_t c = 0 ; c < CHUNK_COUNT && ok ; c++)
+		ok = schedule(connections[c % CONNECTIONS], chunks[c], error) && start(connections[c % CONNECTIONS], chunks[c], error);
+
+	for(size_t c = 0 ; c < CHUNK_COUNT && ok ; c++)
+		ok = receive(chunks[c], error);
+
+	if(ok) {
+		/* within one connection the chunks complete in order */
+		vector<size_t> order = finished_order();
+		vector<size_t> last(CONNECTIONS, (size_t) -1);
+		for(size_t i = 0 ; i < order.size() && ok ; i++) {
+			size_t on = order[i] % CONNECTIONS;
+			if(last[on] != (size_t) -1 && order[i] != last[on] + CONNECTIONS) {
+				error = "chunk " + to_string(order[i]) + " completed after chunk " + to_string(last[on]);
+				ok = false;
+			}
+			last[on] = order[i];
+		}
+		if(ok && accepted != (int) CONNECTIONS) {
+			error = to_string(accepted) + " connections instead of " + to_string(CONNECTIONS);
+			ok = false;
+		}
+	}
+
+	for(size_t i = 0 ; i < connections.size() ; i++)
+		delete connections[i];
+	for(size_t c = 0 ; c < chunks.size() ; c++)
+		delete chunks[c];
+	return ok;
+}
+
+/* Aborts the chunk and checks it ends in time as ABORTED */
+static bool abort_chunk(CheckChunk *chunk, string &error)
+{
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	chunk->AbortDownload();
+	chrono::duration<double, milli> took = chrono::steady_clock::now() - start;
+
+	if(chunk->state != ABORTED) {
+		error = "chunk " + to_string(chunk->number) + " ended in state " + to_string((int) chunk->state) + " when aborted";
+		return false;
+	}
+	if(took.count() > ABORT_LIMIT_MS) {
+		error = "the abort of chunk " + to_string(chunk->number) + " took " + to_string((int) took.count()) + " ms";
+		return false;
+	}
+	return true;
+}
+
+static bool check_abort(string &error)
+{
+	reset_server();
+	reset_finished();
+
+	PersistentHTTPConnection *connection = new PersistentHTTPConnection();
+	vector<CheckChunk *> chunks;
+	chunks.push_back(new CheckChunk(chunk_path(0), 0));
+	chunks.push_back(new CheckChunk(STALL_PATH, 1));
+	chunks.push_back(new CheckChunk(chunk_path(2), 2));
+	chunks.push_back(new CheckChunk(chunk_path(3), 3));
+
+	bool ok = true;
+	for(size_t c = 0 ; c < chunks.size() && ok ; c++)
+		ok = schedule(connection, chunks[c], error) && start(connection, chunks[c], error);
+
+	ok = ok && receive(chunks[0], error);
+
+	/* everything before the stall has arrived, the socket is silent from now on */
+	uint8_t byte;
+	if(ok && chunks[1]->Peek(&byte, 1, STALL_SENT - 1) != 1) {
+		error = "the stalled chunk ended before it stalled";
+		ok = false;
+	}
+
+	/* queued behind the stalled one, then the stalled one itself, whose socket stays silent */
+	ok = ok && abort_chunk(chunks[3], error);
+	if(ok && chunks[1]->state != IN_PROGRESS) {
+		error = "aborting a queued chunk ended the one being received";
+		ok = false;
+	}
+	ok = ok && abort_chunk(chunks[1], error) && abort_chunk(chunks[2], error);
+
+	if(ok) {
+		uint8_t buffer[8192];
+		size_t received = 0;
+		int size;
+		while((size = chunks[1]->Read(buffer, sizeof(buffer))) > 0)
+			received += size;
+
+		if(received != STALL_SENT) {
+			error = "the aborted chunk kept " + to_string(received) + " bytes";
+			ok = false;
+		}
+	}
+
+	release = true;
+
+	delete connection;
+	for(size_t c = 0 ; c < chunks.size() ; c++)
+		delete chunks[c];
+	return ok;
+}
+
+/* A download that never ends would keep the check from reporting anything */
+static void watchdog()
+{
+	this_thread::sleep_for(chrono::seconds(WATCHDOG_S));
+	cerr << "no result after " << WATCHDOG_S << " s\n";
+	_exit(1);
+}
+
+int main()
+{
+	if(!start_server()) {
+		cerr << "cannot listen on a loopback port\n";
+		return 1;
+	}
+
+	thread(watchdog).detach();
+
+	struct {
+		const char *name;
+		bool (*run)(string &error);
+	} checks[] = {
+		{ "pipelined", check_pipelined },
+		{ "connections", check_connections },
+		{ "abort", check_abort },
+	};
+
+	bool ok = true;
+	for(size_t i = 0 ; i < sizeof(checks) / sizeof(checks[0]) ; i++) {
+		string error;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		bool passed = checks[i].run(error);
+		chrono::duration<double, milli> took = chrono::steady_clock::now() - start;
+
+		cout << checks[i].name << ": " << (passed ? "ok" : "FAILED, " + error)
+			<< " (" << accepted << " connections, " << requests << " requests, "
+			<< finished_order().size() << " downloads ended, " << (int) took.count() << " ms)\n";
+		ok = ok && passed;
+	}
+
+	stop_server();
+
+	return ok ? 0 : 1;
+}
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <iomanip>
 #include <assert.h>
+#include <mutex>
 #include "TComDataCU.h"
 #include "Debug.h"
 namespace pcc_hm {
@@ -232,9 +233,19 @@ UChar g_getMsbP1Idx(UInt uiVal)
   return idx+g_ucMsbP1Idx[uiVal];
 }
 
+// the tables are shared by all decoder and encoder instances, which may run on several threads:
+// initROM() and destroyROM() are reference counted and only the first and last call touch the tables
+static std::mutex g_romMutex;
+static Int        g_romUsers = 0;
+
 // initialize ROM variables
 Void initROM()
 {
+  std::lock_guard<std::mutex> lock( g_romMutex );
+  if ( g_romUsers++ > 0 )
+  {
+    return;
+  }
   Int i, c;
 
   // g_aucConvertToBit[ x ]: log2(x/4), if x=4 -> 0, x=8 -> 1, x=16 -> 2, ...
@@ -320,6 +331,11 @@ Void initROM()
 
 Void destroyROM()
 {
+  std::lock_guard<std::mutex> lock( g_romMutex );
+  if ( --g_romUsers > 0 )
+  {
+    return;
+  }
   for(UInt groupTypeIndex = 0; groupTypeIndex < SCAN_NUMBER_OF_GROUP_TYPES; groupTypeIndex++)
   {
     for (UInt scanOrderIndex = 0; scanOrderIndex < SCAN_NUMBER_OF_TYPES; scanOrderIndex++)
@@ -0,0 +1,465 @@
+/*
+ * fetch_check.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - SegmentFetcher check
+ *
+ * Usage: fetch_check
+ *
+ * Starts an HTTP/1.1 keep-alive server with Range support on a loopback
+ * port and runs Main's SegmentFetcher against it:
+ *
+ *   pipelined      one connection, several requests on the wire at once,
+ *                  responses have to come back in queue order
+ *   range split    four connections and a low split threshold, with size
+ *                  estimates that are right, too small and too large
+ *   mid-pipeline   the server closes the connection after two responses
+ *                  while more requests are queued on it
+ *   idle close     the server closes a keep-alive connection between
+ *                  requests and the next ones are sent on the dead socket
+ *   bad coding     segments come with a Transfer-Encoding list that ends
+ *                  in ',', the fetcher has to fail them and go on
+ *
+ * Every segment has its own byte pattern and has to arrive byte for byte.
+ * Exits with 1 when any case fails.
+ *****************************************************************************/
+
+#include "SegmentFetcher.h"
+
+#include <poll.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libdashtest;
+using namespace std;
+
+#if defined MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+static const char *MPD_PATH = "/video/check/check.mpd";
+static const size_t SEGMENT_COUNT = 8;
+static const int RESPONSE_DELAY_MS = 5; // lets pipelined requests reach the server before the reply
+
+/* Sizes in bytes per representation: what @bandwidth promises and what is served */
+static const size_t EXPECTED_BYTES[] = { 300000, 100000, 400000 };
+static const size_t ACTUAL_BYTES[] = { 300017, 250003, 90001 };
+static const char *NAMES[] = { "high", "mid", "low" };
+static const size_t REPRESENTATIONS = 3;
+
+static map<string, string> files;
+static int listen_socket = -1;
+static int server_port = 0;
+static thread server_thread;
+static vector<thread> connection_threads;
+
+/* Server behaviour and counters of the running case */
+static atomic<int> drop_after(0);   // responses after which one connection is closed
+static atomic<int> drops_left(0);
+static atomic<int> accepted(0);
+static atomic<int> open_connections(0);
+static atomic<int> pipelined(0);    // requests that were waiting while an earlier one was answered
+static atomic<int> partial(0);      // 206 replies
+static atomic<int> unsatisfiable(0);// 416 replies
+static atomic<bool> bad_coding(false);  // segment replies name no last transfer coding
+
+static string segment_path(size_t representation, size_t number)
+{
+	return string("/video/check/") + NAMES[representation] + "/" + NAMES[representation] + "_s" + to_string(number + 1) + ".bin";
+}
+
+static string segment_bytes(size_t representation, size_t number)
+{
+	string data(ACTUAL_BYTES[representation] + number, '\0');
+	for(size_t i = 0 ; i < data.size() ; i++)
+		data[i] = (char) ((i * 31 + number * 7 + representation * 101) ^ (i >> 8));
+	return data;
+}
+
+static string mpd_text()
+{
+	stringstream mpd;
+	mpd << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		<< "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\" minBufferTime=\"PT0H0M1.0000S\" type=\"static\""
+		<< " mediaPresentationDuration=\"PT0H0M" << SEGMENT_COUNT << "S\" maxSegmentDuration=\"PT0H0M1.0000S\""
+		<< " profiles=\"urn:mpeg:dash:profile:full:2011\">\n"
+		<< "  <BaseURL>http://127.0.0.1:" << server_port << "/video/check/</BaseURL>\n"
+		<< "    <Period duration=\"PT0H0M" << SEGMENT_COUNT << "S\">\n"
+		<< "      <AdaptationSet sgmentAlignment=\"true\" maxWidth=\"1024\" maxHeight=\"1024\" maxFrameRate=\"30\">\n";
+
+	for(size_t r = 0 ; r < REPRESENTATIONS ; r++) {
+		mpd << "    \t  <Representation id=\"" << r << "\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\""
+			<< " height=\"1024\" frameRate=\"30\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"" << EXPECTED_BYTES[r] * 8 << "\">\n"
+			<< "\t\t\t<SegmentList duration=\"1\">\n";
+		for(size_t s = 0 ; s < SEGMENT_COUNT ; s++)
+			mpd << "\t\t\t  <SegmentURL media=\"" << NAMES[r] << "/" << NAMES[r] << "_s" << s + 1 << ".bin\"/>\n";
+		mpd << "\t\t\t</SegmentList>\n"
+			<< "\t\t  </Representation>\n";
+	}
+
+	mpd << "      </AdaptationSet>\n"
+		<< "    </Period>\n"
+		<< "</MPD>\n";
+
+	return mpd.str();
+}
+
+static bool send_all(int socket, const string &data)
+{
+	size_t sent = 0;
+	while(sent < data.size()) {
+		ssize_t size = send(socket, data.data() + sent, data.size() - sent, SEND_FLAGS);
+		if(size <= 0)
+			return false;
+		sent += size;
+	}
+	return true;
+}
+
+/* "GET http://host:port/path HTTP/1.1" or "GET /path HTTP/1.1", with an optional "Range: bytes=a-[b]" */
+static string reply(const string &request)
+{
+	size_t start = request.find(' ') + 1;
+	string target = request.substr(start, request.find(' ', start) - start);
+	if(target.find("://") != string::npos)
+		target = target.substr(target.find('/', target.find("://") + 3));
+
+	map<string, string>::const_iterator file = files.find(target);
+	if(file == files.end())
+		return "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+
+	const string &body = file->second;
+	size_t range = request.find("\r\nRange: bytes=");
+	if(range == string::npos) {
+		stringstream header;
+		header << "HTTP/1.1 200 OK\r\nContent-Length: " << body.size() << "\r\n";
+		if(bad_coding && target != MPD_PATH)
+			header << "Transfer-Encoding: gzip,\r\n";
+		header << "\r\n";
+		return header.str() + body;
+	}
+
+	const char *spec = request.c_str() + range + 15;
+	char *end = 0x0;
+	size_t first = strtoul(spec, &end, 10);
+	size_t last = body.size() - 1;
+	if(*end == '-' && end[1] >= '0' && end[1] <= '9')
+		last = min(last, (size_t) strtoul(end + 1, 0x0, 10));
+
+	stringstream header;
+	if(first >= body.size()) {
+		unsatisfiable++;
+		header << "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */" << body.size()
+			<< "\r\nContent-Length: 0\r\n\r\n";
+		return header.str();
+	}
+
+	partial++;
+	header << "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes " << first << "-" << last << "/" << body.size()
+		<< "\r\nContent-Length: " << last - first + 1 << "\r\n\r\n";
+	return header.str() + body.substr(first, last - first + 1);
+}
+
+static void serve_connection(int socket)
+{
+	string buffer;
+	char data[4096];
+	int served = 0;
+
+	for(;;) {
+		size_t end;
+		while((end = buffer.find("\r\n\r\n")) == string::npos) {
+			ssize_t size = recv(socket, data, sizeof(data), 0);
+			if(size <= 0) {
+				close(socket);
+				open_connections--;
+				return;
+			}
+			buffer.append(data, size);
+		}
+
+		string request = buffer.substr(0, end + 4);
+		buffer.erase(0, end + 4);
+
+		this_thread::sleep_for(chrono::milliseconds(RESPONSE_DELAY_MS));
+
+		/* whatever arrived meanwhile was sent before this reply could be read */
+		pollfd ready = { socket, POLLIN, 0 };
+		while(poll(&ready, 1, 0) > 0 && (ready.revents & POLLIN)) {
+			ssize_t size = recv(socket, data, sizeof(data), 0);
+			if(size <= 0)
+				break;
+			buffer.append(data, size);
+		}
+		if(buffer.find("\r\n\r\n") != string::npos)
+			pipelined++;
+
+		if(!send_all(socket, reply(request)))
+			break;
+
+		if(++served == drop_after && --drops_left >= 0)
+			break;
+	}
+
+	shutdown(socket, SHUT_RDWR);
+	close(socket);
+	open_connections--;
+}
+
+static void serve()
+{
+	for(;;) {
+		int socket = accept(listen_socket, 0x0, 0x0);
+		if(socket < 0)
+			return;
+
+		accepted++;
+		open_connections++;
+		connection_threads.push_back(thread(serve_connection, socket));
+	}
+}
+
+static bool start_server()
+{
+	listen_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+
+	socklen_t length = sizeof(addr);
+	if(listen_socket < 0 || bind(listen_socket, (sockaddr *) &addr, sizeof(addr)) != 0 ||
+	   listen(listen_socket, 16) != 0 || getsockname(listen_socket, (sockaddr *) &addr, &length) != 0)
+		return false;
+
+	server_port = ntohs(addr.sin_port);
+
+	files[MPD_PATH] = mpd_text();
+	for(size_t r = 0 ; r < REPRESENTATIONS ; r++)
+		for(size_t s = 0 ; s < SEGMENT_COUNT ; s++)
+			files[segment_path(r, s)] = segment_bytes(r, s);
+
+	server_thread = thread(serve);
+	return true;
+}
+
+static void stop_server()
+{
+	shutdown(listen_socket, SHUT_RDWR);
+	close(listen_socket);
+	server_thread.join();
+
+	/* the fetchers are gone, so every connection has been closed by now */
+	for(size_t i = 0 ; i < connection_threads.size() ; i++)
+		connection_threads[i].join();
+}
+
+static void reset_server(int responses)
+{
+	/* connections of the previous case may still be answering what was queued on them */
+	while(open_connections > 0)
+		this_thread::sleep_for(chrono::milliseconds(1));
+
+	drop_after = responses;
+	drops_left = responses > 0 ? 1 : 0;
+	bad_coding = false;
+	accepted = 0;
+	pipelined = 0;
+	partial = 0;
+	unsatisfiable = 0;
+}
+
+/* Checks the segment the fetcher handed out against the one queued as the next */
+static bool receive(SegmentFetcher &fetcher, size_t representation, size_t number, string &error)
+{
+	MediaSegment segment;
+	if(!fetcher.Receive(&segment)) {
+		error = "segment " + to_string(number) + " of representation " + to_string(representation) + " failed";
+		return false;
+	}
+
+	string expected = segment_bytes(representation, number);
+	if(segment.representation != representation || segment.index != number ||
+	   segment.data.size() != expected.size() || memcmp(segment.data.data(), expected.data(), expected.size()) != 0) {
+		error = "segment " + to_string(number) + " of representation " + to_string(representation)
+			+ " came back as segment " + to_string(segment.index) + " of representation " + to_string(segment.representation)
+			+ ", " + to_string(segment.data.size()) + " bytes";
+		if(segment.data.size() == expected.size())
+			error += ", content differs";
+		return false;
+	}
+	return true;
+}
+
+/* Fetches segments [first, last) keeping depth requests on the wire */
+static bool fetch(SegmentFetcher &fetcher, size_t representation, size_t first, size_t last, size_t depth, string &error)
+{
+	size_t requested = first;
+	for(size_t number = first ; number < last ; number++) {
+		while(requested < last && requested < number + depth)
+			if(!fetcher.Queue(representation, requested++)) {
+				error = "cannot queue segment " + to_string(requested - 1);
+				return false;
+			}
+
+		if(!receive(fetcher, representation, number, error))
+			return false;
+	}
+	return true;
+}
+
+static bool check_pipelined(string &error)
+{
+	reset_server(0);
+	SegmentFetcher fetcher("127.0.0.1", server_port, 1);
+	if(!fetcher.Open(MPD_PATH)) {
+		error = "cannot open the MPD";
+		return false;
+	}
+
+	if(!fetch(fetcher, 0, 0, SEGMENT_COUNT, 3, error))
+		return false;
+
+	if(accepted != 1)
+		error = to_string(accepted) + " connections instead of one kept alive";
+	else if(pipelined == 0)
+		error = "no request reached the server before the previous response";
+	return error.empty();
+}
+
+static bool check_range_split(string &error)
+{
+	reset_server(0);
+	SegmentFetcher fetcher("127.0.0.1", server_port, 4, 64 * 1024);
+	if(!fetcher.Open(MPD_PATH)) {
+		error = "cannot open the MPD";
+		return false;
+	}
+
+	/* estimate right, too small (open-ended last part) and too large (parts past the end) */
+	for(size_t r = 0 ; r < REPRESENTATIONS ; r++)
+		if(!fetch(fetcher, r, 0, SEGMENT_COUNT, 2, error))
+			return false;
+
+	if(partial == 0)
+		error = "no Range request was sent";
+	else if(unsatisfiable == 0)
+		error = "no part was past the end of a file";
+	else if(accepted != 4)
+		error = to_string(accepted) + " connections instead of 4 kept alive";
+	return error.empty();
+}
+
+static bool check_mid_pipeline(string &error)
+{
+	reset_server(2);
+	SegmentFetcher fetcher("127.0.0.1", server_port, 1);
+	if(!fetcher.Open(MPD_PATH)) {
+		error = "cannot open the MPD";
+		return false;
+	}
+
+	/* the MPD was the first response, the first segment the second */
+	if(!fetch(fetcher, 0, 0, SEGMENT_COUNT, 4, error))
+		return false;
+
+	if(accepted < 2)
+		error = "the fetcher did not reconnect";
+	return error.empty();
+}
+
+static bool check_idle_close(string &error)
+{
+	reset_server(3);
+	SegmentFetcher fetcher("127.0.0.1", server_port, 1);
+	if(!fetcher.Open(MPD_PATH)) {
+		error = "cannot open the MPD";
+		return false;
+	}
+
+	if(!fetch(fetcher, 1, 0, 2, 1, error))
+		return false;
+
+	/* the server has closed the connection by now, the next requests go to a dead socket */
+	this_thread::sleep_for(chrono::milliseconds(50));
+	if(!fetch(fetcher, 1, 2, SEGMENT_COUNT, 3, error))
+		return false;
+
+	if(accepted < 2)
+		error = "the fetcher did not reconnect";
+	return error.empty();
+}
+
+static bool check_bad_coding(string &error)
+{
+	reset_server(0);
+	SegmentFetcher fetcher("127.0.0.1", server_port, 1);
+	if(!fetcher.Open(MPD_PATH)) {
+		error = "cannot open the MPD";
+		return false;
+	}
+
+	bad_coding = true;
+	MediaSegment segment;
+	if(!fetcher.Queue(0, 0))
+		error = "cannot queue segment 0";
+	else if(fetcher.Receive(&segment))
+		error = "a segment without a last transfer coding was accepted";
+	if(!error.empty())
+		return false;
+
+	/* the server is fixed, the next segment has to arrive on a new connection */
+	bad_coding = false;
+	if(!fetch(fetcher, 0, 1, 2, 1, error))
+		return false;
+
+	if(accepted < 2)
+		error = "the fetcher did not reconnect";
+	return error.empty();
+}
+
+int main()
+{
+	if(!start_server()) {
+		cerr << "cannot listen on a loopback port\n";
+		return 1;
+	}
+
+	struct {
+		const char *name;
+		bool (*run)(string &error);
+	} checks[] = {
+		{ "pipelined", check_pipelined },
+		{ "range split", check_range_split },
+		{ "mid-pipeline", check_mid_pipeline },
+		{ "idle close", check_idle_close },
+		{ "bad coding", check_bad_coding },
+	};
+
+	bool ok = true;
+	for(size_t i = 0 ; i < sizeof(checks) / sizeof(checks[0]) ; i++) {
+		string error;
+		bool passed = checks[i].run(error);
+
+		cout << checks[i].name << ": " << (passed ? "ok" : "FAILED, " + error)
+			<< " (" << accepted << " connections, " << pipelined << " pipelined, "
+			<< partial << " ranges, " << unsatisfiable << " past the end)\n";
+		ok = ok && passed;
+	}
+
+	stop_server();
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+/**
+ *  @class      dash::network::IAsyncConnection
+ *  @brief      An external connection that can be read without blocking.
+ *  @details    Chunks downloaded through such a connection are served by an event loop that waits on the
+ *              connection's socket, so many chunks share a few threads instead of one thread per chunk.
+ *              A connection is either read this way or through dash::network::IConnection::Read, never both at once.
+ *  @see        dash::network::IConnection
+ *
+ *  @author     MCNL-ARstreaming Capstone Project
+ */
+
+#ifndef IASYNCCONNECTION_H_
+#define IASYNCCONNECTION_H_
+
+#include "config.h"
+
+#include "IConnection.h"
+
+namespace dash
+{
+    namespace network
+    {
+        enum AsyncReadResult
+        {
+            READ_FAILED         = -1,
+            READ_WOULD_BLOCK    = -2
+        };
+        class IAsyncConnection : public virtual IConnection
+        {
+            public:
+                virtual ~IAsyncConnection(){}
+
+                /**
+                 *  Returns the socket the data of the scheduled chunks arrives on.
+                 *  @return     a socket descriptor that can be waited on for readability
+                 */
+                virtual int Descriptor      ()                                          = 0;
+
+                /**
+                 *  This function should read a block of bytes from the specified chunk without waiting for the network.
+                 *  Data that is already buffered or received has to be returned before dash::network::READ_WOULD_BLOCK.
+                 *  @param      data    pointer to a block of memory
+                 *  @param      len     size of the memory block that can be used by the method
+                 *  @param      chunk   the dash::network::IChunk object from which data should be read
+                 *  @return     amount of data that has been read, 0 at the end of the chunk,
+                 *              dash::network::READ_WOULD_BLOCK if nothing can be read for the chunk right now
+                 *              or dash::network::READ_FAILED
+                 */
+                virtual int ReadNonBlocking (uint8_t *data, size_t len, IChunk *chunk)  = 0;
+        };
+    }
+}
+
+#endif /* IASYNCCONNECTION_H_ */
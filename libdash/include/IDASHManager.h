@@ -2,6 +2,7 @@
  *  @class      dash::IDASHManager
  *  @brief      This interface is needed for generating an IMPD object from the information found in a MPD file
  *  @details    By invoking the method Open(char *path) all the information found in the MPD file specified by \em path is mapped to corresponding IMPD objects.
+ *              An MPD that has already been downloaded can be passed to Open(const uint8_t *data, size_t len, const std::string &baseUrl) instead.
  *  @see        dash::mpd::IMPD
  *
  *  @author     bitmovin Softwareentwicklung OG \n
@@ -35,6 +36,36 @@ namespace dash
              */
             virtual mpd::IMPD* Open (char *path) = 0;
 
+            /**
+             *  Returns a pointer to dash::mpd::IMPD object representing the information found in the MPD held in memory. \n
+             *  The parser is kept by the manager, so opening a refreshed MPD again only costs the parse.
+             *  @param      data    the MPD document, it is not referenced after the call returns
+             *  @param      len     length of \em data in bytes
+             *  @param      baseUrl the URL the MPD was retrieved from, relative <tt><b>BaseURL</b></tt>s are resolved against its directory
+             *  @return     a pointer to an dash::mpd::IMPD object, or NULL if \em data could not be parsed
+             */
+            virtual mpd::IMPD* Open (const uint8_t *data, size_t len, const std::string &baseUrl) = 0;
+
+            /**
+             *  Applies an MPD Patch document, as retrieved from a <tt><b>PatchLocation</b></tt>, to an MPD returned by Open(). \n
+             *  Details on the MPD patch document are available in subclause 5.15. of <em>ISO/IEC 23009-1</em>.
+             *  Supported are adding elements and attributes, replacing attributes and removing
+             *  <tt><b>Period</b></tt>, <tt><b>AdaptationSet</b></tt>, <tt><b>Representation</b></tt>, <tt><b>S</b></tt>, <tt><b>SegmentURL</b></tt> and <tt><b>Event</b></tt> elements.
+             *  @param      mpd     an MPD returned by this manager
+             *  @param      data    the patch document
+             *  @param      len     length of \em data in bytes
+             *  @return     false if the patch does not apply to \em mpd or could not be applied,
+             *              \em mpd may then be partially patched and has to be replaced by a full MPD
+             */
+            virtual bool        Patch   (mpd::IMPD *mpd, const uint8_t *data, size_t len) = 0;
+
+            /**
+             *  Switches the libcurl trace (<tt>CURLOPT_VERBOSE</tt>) of segment downloads through internal connections on or off. \n
+             *  It is off by default and applies to downloads started afterwards; the trace is written to stderr.
+             *  @param      enable  true to trace downloads
+             */
+            virtual void        EnableDownloadTracing   (bool enable) = 0;
+
             /**
              *  Frees allocated memory and deletes the DashManager
              */
@@ -45,6 +45,7 @@ namespace dash
                 virtual const std::string&                              Range                   () const = 0;
                 virtual const std::string&                              RequestSentTime         () const = 0;
                 virtual const std::string&                              ResponseReceivedTime    () const = 0;
+                virtual const std::string&                              ResponseFinishedTime    () const = 0;
                 virtual uint16_t                                        ResponseCode            () const = 0;
                 virtual uint64_t                                        Interval                () const = 0;
                 virtual const std::vector<IThroughputMeasurement *>&    ThroughputTrace         () const = 0;
@@ -141,6 +141,28 @@ namespace dash
                  *  @return     a pointer to a dash::mpd::ISegment object
                  */
                 virtual ISegment*           GetIndexSegmentFromTime     (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t time) const = 0;
+
+                /**
+                 *  Writes the Media Segment URL of segment <em>number</em>, relative to the BaseURLs, into <em>uri</em>.
+                 *  The template is compiled when it is set and <em>uri</em> keeps its buffer,
+                 *  so resolving URLs into the same string does not allocate once it is large enough.
+                 *  With a <tt><b>SegmentTimeline</b></tt> the identifier \em \$Time\$ is replaced with the start time of that Segment.
+                 *  @param      uri                 receives the URL
+                 *  @param      representationID    a string containing the representation ID that will replace the identifier \em \$RepresentationID\$ in the Media template.
+                 *  @param      bandwidth           an integer specifying the bandwidth that will replace the identifier \em \$Bandwidth\$ in the Media template.
+                 *  @param      number              the Segment number, counted from \c \@startNumber, that will replace the identifier \em \$Number\$ in the Media template.
+                 *  @return     false if <em>number</em> is before \c \@startNumber or not described by the <tt><b>SegmentTimeline</b></tt>
+                 */
+                virtual bool                GetMediaURIFromNumber       (std::string& uri, const std::string& representationID, uint32_t bandwidth, uint32_t number) const = 0;
+
+                /**
+                 *  Returns the number of the Segment containing <em>time</em>: in O(log n) through the index of the <tt><b>SegmentTimeline</b></tt>,
+                 *  otherwise from the \c \@duration attribute.
+                 *  @param      time                a presentation time in \c \@timescale units, relative to the start of the Period if there is no <tt><b>SegmentTimeline</b></tt>
+                 *  @param      number              receives the Segment number, counted from \c \@startNumber
+                 *  @return     false if no Segment contains <em>time</em>
+                 */
+                virtual bool                GetSegmentNumberFromTime    (uint64_t time, uint32_t& number) const = 0;
         };
     }
 }
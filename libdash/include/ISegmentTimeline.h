@@ -43,6 +43,29 @@ namespace dash
                  *  @return     a reference to vector of pointers to dash::mpd::ITimeline objects
                  */
                 virtual std::vector<ITimeline *>&   GetTimelines ()  const = 0;
+
+                /**
+                 *  Returns the number of Segments described by all <b><tt>S</tt></b> elements, with their repeat counts expanded.
+                 *  @return     the number of Segments, or \c UINT32_MAX if the last <b><tt>S</tt></b> element repeats until the end of the Period (\c \@r of -1)
+                 */
+                virtual uint32_t                    GetSegmentCount ()  const = 0;
+
+                /**
+                 *  Looks up the <em>index</em>-th Segment of the timeline, counted from 0, in O(log n) of the number of <b><tt>S</tt></b> elements.
+                 *  @param      index       the position of the Segment, i.e. its \c \@startNumber relative number
+                 *  @param      startTime   receives the earliest presentation time of the Segment in \c \@timescale units
+                 *  @param      duration    receives the duration of the Segment in \c \@timescale units
+                 *  @return     false if the timeline describes fewer Segments
+                 */
+                virtual bool                        GetSegment      (uint32_t index, uint64_t &startTime, uint32_t &duration)  const = 0;
+
+                /**
+                 *  Looks up the Segment containing <em>time</em> in O(log n) of the number of <b><tt>S</tt></b> elements.
+                 *  @param      time        a presentation time in \c \@timescale units
+                 *  @param      index       receives the position of the Segment, counted from 0
+                 *  @return     false if <em>time</em> lies before the first Segment, after the last one or in a gap of the timeline
+                 */
+                virtual bool                        GetSegmentIndex (uint64_t time, uint32_t &index)  const = 0;
         };
     }
 }
@@ -0,0 +1,54 @@
+/*
+ * Block.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#include "Block.h"
+#include "BlockPool.h"
+
+namespace dash
+{
+    namespace helpers
+    {
+        block_t*    AllocBlock      (size_t len)
+        {
+            BlockPool   &pool   = BlockPool::Instance();
+            slab_t      *slab   = pool.AcquireSlab(len);
+
+            slab->used = len;
+
+            return pool.AcquireBlock(slab, 0, len);
+        }
+        void        DeleteBlock     (block_t *block)
+        {
+            if(block)
+            {
+                BlockPool &pool = BlockPool::Instance();
+
+                pool.ReleaseSlab(block->slab);
+                pool.ReleaseBlock(block);
+            }
+        }
+        block_t*    DuplicateBlock  (const block_t *block)
+        {
+            block_t *ret = AllocBlock(block->len);
+            ret->millisec = block->millisec;
+
+            memcpy(ret->data, block->data, ret->len);
+
+            return ret;
+        }
+        block_t*    SliceBlock      (const block_t *block, size_t offset, size_t len)
+        {
+            BlockPool &pool = BlockPool::Instance();
+
+            pool.RetainSlab(block->slab);
+
+            block_t *ret = pool.AcquireBlock(block->slab, (block->data - block->slab->data) + offset, len);
+            ret->millisec = block->millisec;
+
+            return ret;
+        }
+    }
+}
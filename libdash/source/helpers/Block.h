@@ -14,47 +14,67 @@
 
 #include "config.h"
 
+#include <atomic>
+
 namespace dash
 {
     namespace helpers
     {
+        /*
+         * Reference counted backing store of one or more blocks. Slabs of
+         * BlockPool::SLAB_SIZE bytes are recycled by the BlockPool, others
+         * are freed with their last reference.
+         */
+        struct slab_t
+        {
+            uint8_t                 *data;
+            size_t                  size;
+            size_t                  used;           /* bytes already handed out to blocks */
+            std::atomic<uint32_t>   references;
+            bool                    isPooled;
+        };
+
+        /*
+         * A slice of a slab. data points to the first unread byte and len is
+         * the number of unread bytes; offset counts the bytes consumed from
+         * the front since the slice was created.
+         */
         struct block_t
         {
             uint8_t *data;
             size_t  len;
             float   millisec;
             size_t  offset;
+            slab_t  *slab;
         };
 
-        static inline block_t*  AllocBlock      (size_t len)
-        {
-            block_t *block  = (block_t *)malloc(sizeof(block_t));
-            block->data     = new uint8_t[len];
-            block->len      = len;
-            block->millisec = 0;
-            block->offset   = 0;
-      
-            return block;
-        }
-        static inline void      DeleteBlock     (block_t *block)
+        /*
+         * Scatter/gather view of a stream; valid until the bytes are consumed.
+         */
+        struct block_slice_t
         {
-            if(block)
-            {
-                delete [] block->data;
-                free(block);
-                block = NULL;
-            }
-        }
-        static inline block_t*  DuplicateBlock  (block_t *block)
-        {
-            block_t *ret = AllocBlock(block->len);
-            ret->offset  = block->offset;
+            const uint8_t   *data;
+            size_t          len;
+        };
 
-            memcpy(ret->data, block->data, ret->len);
+        block_t*    AllocBlock      (size_t len);
+        void        DeleteBlock     (block_t *block);
+        block_t*    DuplicateBlock  (const block_t *block);
+        /*
+         * Returns a new block sharing len bytes at offset of block's slab.
+         */
+        block_t*    SliceBlock      (const block_t *block, size_t offset, size_t len);
+
+        static inline void      ConsumeBlock    (block_t *block, size_t len)
+        {
+            if(len > block->len)
+                len = block->len;
 
-            return block;
+            block->data     += len;
+            block->len      -= len;
+            block->offset   += len;
         }
     }
 }
 
-#endif
\ No newline at end of file
+#endif
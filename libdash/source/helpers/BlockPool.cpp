@@ -0,0 +1,88 @@
+/*
+ * BlockPool.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#include "BlockPool.h"
+
+#include <new>
+
+using namespace dash::helpers;
+
+const size_t BlockPool::SLAB_SIZE;
+const size_t BlockPool::MAX_FREE_SLABS;
+const size_t BlockPool::MAX_FREE_BLOCKS;
+
+BlockPool::BlockPool    ()
+{
+}
+BlockPool::~BlockPool   ()
+{
+}
+
+BlockPool&  BlockPool::Instance     ()
+{
+    static BlockPool pool;
+    return pool;
+}
+slab_t*     BlockPool::AcquireSlab  (size_t size)
+{
+    slab_t *slab = NULL;
+
+    /* small one-off blocks are not worth a whole slab */
+    if(size <= SLAB_SIZE && size > SLAB_SIZE / 4)
+    {
+        slab = this->freeSlabs.Take();
+        size = SLAB_SIZE;
+    }
+
+    /* header and data in one allocation */
+    if(slab == NULL)
+    {
+        slab            = new (malloc(sizeof(slab_t) + size)) slab_t;
+        slab->data      = (uint8_t *) (slab + 1);
+        slab->size      = size;
+        slab->isPooled  = size == SLAB_SIZE;
+    }
+
+    slab->used = 0;
+    slab->references.store(1, std::memory_order_relaxed);
+
+    return slab;
+}
+void        BlockPool::RetainSlab   (slab_t *slab)
+{
+    slab->references.fetch_add(1, std::memory_order_relaxed);
+}
+void        BlockPool::ReleaseSlab  (slab_t *slab)
+{
+    /* acq_rel: whoever recycles the slab sees every write done through the other references */
+    if(slab->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if(slab->isPooled && this->freeSlabs.Put(slab))
+        return;
+
+    free(slab);
+}
+block_t*    BlockPool::AcquireBlock (slab_t *slab, size_t offset, size_t len)
+{
+    block_t *block = this->freeBlocks.Take();
+
+    if(block == NULL)
+        block = (block_t *) malloc(sizeof(block_t));
+
+    block->data     = slab->data + offset;
+    block->len      = len;
+    block->millisec = 0;
+    block->offset   = 0;
+    block->slab     = slab;
+
+    return block;
+}
+void        BlockPool::ReleaseBlock (block_t *block)
+{
+    if(!this->freeBlocks.Put(block))
+        free(block);
+}
@@ -0,0 +1,127 @@
+/*
+ * BlockPool.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#ifndef __BLOCKPOOL_H__
+#define __BLOCKPOOL_H__
+
+#include "config.h"
+
+#include "Block.h"
+
+#include <atomic>
+
+namespace dash
+{
+    namespace helpers
+    {
+        /*
+         * Bounded lock-free free list. Every slot holds one free object or
+         * NULL; Take() and Put() move an object with a single exchange or
+         * compare-exchange on its slot, so each object has exactly one owner
+         * and there is no ABA. count only tells whether a scan is worth it.
+         */
+        template <typename T, size_t N>
+        class FreeSlots
+        {
+            public:
+                FreeSlots   () :
+                    count   (0),
+                    cursor  (0)
+                {
+                    for(size_t i = 0; i < N; i++)
+                        this->slots[i].store(NULL, std::memory_order_relaxed);
+                }
+                ~FreeSlots  ()
+                {
+                    for(size_t i = 0; i < N; i++)
+                        free(this->slots[i].load(std::memory_order_relaxed));
+                }
+
+                T*      Take    ()
+                {
+                    if(this->count.load(std::memory_order_relaxed) == 0)
+                        return NULL;
+
+                    /* backwards from the slot filled last, its memory is most likely cached */
+                    size_t start = this->cursor.load(std::memory_order_relaxed);
+                    for(size_t i = 0; i < N; i++)
+                    {
+                        std::atomic<T *> &slot = this->slots[(start + N - i) % N];
+                        if(slot.load(std::memory_order_relaxed) == NULL)
+                            continue;
+
+                        T *item = slot.exchange(NULL, std::memory_order_acquire);
+                        if(item)
+                        {
+                            this->count.fetch_sub(1, std::memory_order_relaxed);
+                            return item;
+                        }
+                    }
+                    return NULL;
+                }
+                bool    Put     (T *item)
+                {
+                    if(this->count.load(std::memory_order_relaxed) >= N)
+                        return false;
+
+                    size_t start = this->cursor.load(std::memory_order_relaxed);
+                    for(size_t i = 1; i <= N; i++)
+                    {
+                        size_t  index       = (start + i) % N;
+                        T       *expected   = NULL;
+                        if(this->slots[index].load(std::memory_order_relaxed) == NULL &&
+                           this->slots[index].compare_exchange_strong(expected, item, std::memory_order_release, std::memory_order_relaxed))
+                        {
+                            this->count.fetch_add(1, std::memory_order_relaxed);
+                            this->cursor.store(index, std::memory_order_relaxed);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+            private:
+                std::atomic<T *>    slots[N];
+                std::atomic<size_t> count;
+                std::atomic<size_t> cursor;
+        };
+
+        /*
+         * Recycles slabs and block headers for all streams of the process.
+         * Nothing takes a lock: slab references are atomic and the free
+         * lists are FreeSlots, so downloads and readers on different threads
+         * do not serialize on the pool.
+         */
+        class BlockPool
+        {
+            public:
+                static const size_t SLAB_SIZE       = 65536;
+                static const size_t MAX_FREE_SLABS  = 64;
+                static const size_t MAX_FREE_BLOCKS = 256;
+
+                static BlockPool&   Instance        ();
+
+                /*
+                 * Returns an empty slab holding one reference. Sizes between a
+                 * quarter of and SLAB_SIZE get a recycled SLAB_SIZE slab.
+                 */
+                slab_t*     AcquireSlab     (size_t size = SLAB_SIZE);
+                void        RetainSlab      (slab_t *slab);
+                void        ReleaseSlab     (slab_t *slab);
+                block_t*    AcquireBlock    (slab_t *slab, size_t offset, size_t len);
+                void        ReleaseBlock    (block_t *block);
+
+            private:
+                BlockPool           ();
+                virtual ~BlockPool  ();
+
+                FreeSlots<slab_t, MAX_FREE_SLABS>   freeSlabs;
+                FreeSlots<block_t, MAX_FREE_BLOCKS> freeBlocks;
+        };
+    }
+}
+
+#endif // __BLOCKPOOL_H__
@@ -48,7 +48,19 @@ const block_t*  BlockStream::GetBytes               (uint32_t len)
     if(this->length < len)
         return NULL;
 
-    block_t *block = AllocBlock(len);
+    block_t *front = this->blockqueue.front();
+    block_t *block = NULL;
+
+    /* the front block covers the request: hand out a slice of it */
+    if(front->len >= len)
+    {
+        block = SliceBlock(front, 0, len);
+        this->EraseFront(len);
+
+        return block;
+    }
+
+    block = AllocBlock(len);
     this->BlockQueueGetBytes(block->data, block->len);
 
     this->length -= len;
@@ -80,8 +92,8 @@ size_t          BlockStream::PeekBytes              (uint8_t *data, size_t len)
 size_t          BlockStream::PeekBytes              (uint8_t *data, size_t len, size_t offset)
 {
     /* Performance Intensive */
-    if(len > this->length)
-        len = (size_t) this->length;
+    if(offset >= this->length)
+        return 0;
 
     if (offset + len > this->length)
         len = (size_t) (this->length - offset);
@@ -124,14 +136,7 @@ bool            BlockStream::BlockQueueGetBytes     (uint8_t *data, uint32_t len
         if((len - pos) < (block->len))
         {
             memcpy(data + pos, block->data, len - pos);
-
-            this->blockqueue.pop_front();
-
-            block_t* newfront = AllocBlock(block->len - (len - pos));
-            memcpy(newfront->data, block->data + (len - pos), newfront->len);
-
-            DeleteBlock(block);
-            this->blockqueue.push_front(newfront);
+            ConsumeBlock(block, len - pos);
 
             return true;
         }
@@ -150,28 +155,27 @@ bool            BlockStream::BlockQueueGetBytes     (uint8_t *data, uint32_t len
 bool            BlockStream::BlockQueuePeekBytes    (uint8_t *data, uint32_t len, size_t offset)
 {
     uint32_t pos = 0;
-    int      cnt = 0;
-
-    const block_t *block = NULL;
 
-    while(pos < len)
+    for(size_t i = 0; i < this->blockqueue.size() && pos < len; i++)
     {
-        block = this->blockqueue.at(cnt);
-        if((offset + len - pos) < (block->len))
-        {
-            memcpy(data + pos, block->data + offset, len - pos - offset);
-            return true;
-        }
-        else
+        const block_t *block = this->blockqueue.at(i);
+
+        if(offset >= block->len)
         {
-            memcpy(data + pos, block->data + offset, block->len - offset);
-            pos += block->len;
+            offset -= block->len;
+            continue;
         }
 
-        cnt++;
+        size_t n = block->len - offset;
+        if(n > len - pos)
+            n = len - pos;
+
+        memcpy(data + pos, block->data + offset, n);
+        pos    += (uint32_t) n;
+        offset  = 0;
     }
 
-    return false;
+    return pos == len;
 }
 uint8_t         BlockStream::ByteAt                 (uint64_t position) const
 {
@@ -233,16 +237,11 @@ void            BlockStream::EraseFront             (uint64_t len)
         }
         else
         {
-            uint32_t diff       = (uint32_t) (len - actLen);
-            this->length       -= diff;
-            actLen             += diff;
-            block_t* newfront   = AllocBlock(front->len - diff);
-
-            memcpy(newfront->data, front->data + diff, newfront->len);
+            size_t diff     = (size_t) (len - actLen);
+            this->length   -= diff;
+            actLen         += diff;
 
-            DeleteBlock(front);
-            this->blockqueue.pop_front();
-            this->blockqueue.push_front(newfront);
+            ConsumeBlock(front, diff);
         }
     }
 }
@@ -269,22 +268,41 @@ BlockStream*    BlockStream::GetBlocks              (uint64_t len)
         }
         else
         {
-            uint32_t diff       = (uint32_t) (len - actLen);
-            this->length       -= diff;
-            actLen             += diff;
-            block_t *block      = AllocBlock(diff);
-            block_t* newfront   = AllocBlock(front->len - diff);
+            size_t diff     = (size_t) (len - actLen);
+            this->length   -= diff;
+            actLen         += diff;
 
-            memcpy(block->data, front->data, diff);
-            blocks->PushBack(block);
+            blocks->PushBack(SliceBlock(front, 0, diff));
+            ConsumeBlock(front, diff);
+        }
+    }
 
-            memcpy(newfront->data, front->data+ diff, newfront->len);
+    return blocks;
+}
+size_t          BlockStream::Slices                 (std::vector<block_slice_t> &slices, uint64_t offset, uint64_t len) const
+{
+    size_t ret = 0;
 
-            DeleteBlock(front);
-            this->blockqueue.pop_front();
-            this->blockqueue.push_front(newfront);
+    for(size_t i = 0; i < this->blockqueue.size() && ret < len; i++)
+    {
+        const block_t *block = this->blockqueue.at(i);
+
+        if(offset >= block->len)
+        {
+            offset -= block->len;
+            continue;
         }
+
+        block_slice_t slice;
+        slice.data  = block->data + offset;
+        slice.len   = block->len - (size_t) offset;
+        if(slice.len > len - ret)
+            slice.len = (size_t) (len - ret);
+
+        slices.push_back(slice);
+        ret    += slice.len;
+        offset  = 0;
     }
 
-    return blocks;
-}
\ No newline at end of file
+    return ret;
+}
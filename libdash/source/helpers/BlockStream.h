@@ -41,6 +41,11 @@ namespace dash
                 virtual void            EraseFront          (uint64_t len);
                 virtual BlockStream*    GetBlocks           (uint64_t len);
                 virtual void            PopAndDeleteFront   ();
+                /*
+                 * Appends views of len bytes starting at offset to slices
+                 * without copying and returns the number of bytes covered.
+                 */
+                virtual size_t          Slices              (std::vector<block_slice_t> &slices, uint64_t offset, uint64_t len) const;
 
             protected:
                 uint64_t                length;
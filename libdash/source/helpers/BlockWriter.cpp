@@ -0,0 +1,65 @@
+/*
+ * BlockWriter.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#include "BlockWriter.h"
+
+using namespace dash::helpers;
+
+const size_t BlockWriter::MIN_RESERVE;
+
+BlockWriter::BlockWriter    (BlockStream *stream) :
+             stream         (stream),
+             slab           (NULL)
+{
+}
+BlockWriter::~BlockWriter   ()
+{
+    if(this->slab)
+        BlockPool::Instance().ReleaseSlab(this->slab);
+}
+
+uint8_t*    BlockWriter::Reserve    (size_t &len)
+{
+    if(this->slab == NULL || this->slab->size - this->slab->used < MIN_RESERVE)
+    {
+        if(this->slab)
+            BlockPool::Instance().ReleaseSlab(this->slab);
+
+        this->slab = BlockPool::Instance().AcquireSlab();
+    }
+
+    len = this->slab->size - this->slab->used;
+
+    return this->slab->data + this->slab->used;
+}
+void        BlockWriter::Commit     (size_t len)
+{
+    if(len == 0)
+        return;
+
+    BlockPool &pool = BlockPool::Instance();
+
+    pool.RetainSlab(this->slab);
+    block_t *block = pool.AcquireBlock(this->slab, this->slab->used, len);
+
+    this->slab->used += len;
+    this->stream->PushBack(block);
+}
+void        BlockWriter::Write      (const uint8_t *data, size_t len)
+{
+    while(len > 0)
+    {
+        size_t  free    = 0;
+        uint8_t *dst    = this->Reserve(free);
+        size_t  n       = len < free ? len : free;
+
+        memcpy(dst, data, n);
+        this->Commit(n);
+
+        data    += n;
+        len     -= n;
+    }
+}
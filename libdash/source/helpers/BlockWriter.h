@@ -0,0 +1,47 @@
+/*
+ * BlockWriter.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#ifndef __BLOCKWRITER_H__
+#define __BLOCKWRITER_H__
+
+#include "config.h"
+
+#include "BlockPool.h"
+#include "BlockStream.h"
+
+namespace dash
+{
+    namespace helpers
+    {
+        /*
+         * Fills pooled slabs back to back and pushes each committed range to
+         * the stream as a slice, so many small network reads share one slab
+         * and are never copied again.
+         */
+        class BlockWriter
+        {
+            public:
+                static const size_t MIN_RESERVE = 4096;
+
+                BlockWriter             (BlockStream *stream);
+                virtual ~BlockWriter    ();
+
+                /*
+                 * Returns the free tail of the current slab and its size in
+                 * len, at least MIN_RESERVE bytes.
+                 */
+                uint8_t*    Reserve (size_t &len);
+                void        Commit  (size_t len);
+                void        Write   (const uint8_t *data, size_t len);
+
+            private:
+                BlockStream *stream;
+                slab_t      *slab;
+        };
+    }
+}
+
+#endif // __BLOCKWRITER_H__
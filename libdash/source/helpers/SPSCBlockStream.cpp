@@ -0,0 +1,233 @@
+/*
+ * SPSCBlockStream.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#include "SPSCBlockStream.h"
+
+using namespace dash::helpers;
+
+SPSCBlockStream::SPSCBlockStream    () :
+                 eos                (false),
+                 parked             (false)
+{
+    node_t *dummy = new node_t;
+    dummy->next.store(NULL, std::memory_order_relaxed);
+    dummy->block = NULL;
+
+    this->head.store(dummy, std::memory_order_relaxed);
+    this->tail      = dummy;
+    this->first     = dummy;
+    this->headCopy  = dummy;
+
+    InitializeConditionVariable (&this->full);
+    InitializeCriticalSection   (&this->monitorMutex);
+}
+SPSCBlockStream::~SPSCBlockStream   ()
+{
+    this->Drain();
+
+    /* nodes from first up to head are spent, head is the current dummy */
+    node_t *node = this->first;
+    while(node)
+    {
+        node_t *next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+
+    DeleteConditionVariable(&this->full);
+    DeleteCriticalSection(&this->monitorMutex);
+}
+
+void            SPSCBlockStream::PushBack           (block_t *block)
+{
+    node_t *node = this->AllocNode();
+    node->next.store(NULL, std::memory_order_relaxed);
+    node->block = block;
+
+    this->tail->next.store(node, std::memory_order_release);
+    this->tail = node;
+
+    this->Wake();
+}
+void            SPSCBlockStream::SetEOS             (bool value)
+{
+    this->eos.store(value, std::memory_order_release);
+
+    this->Wake();
+}
+void            SPSCBlockStream::PushFront          (block_t *block)
+{
+    BlockStream::PushFront(block);
+}
+const block_t*  SPSCBlockStream::GetBytes           (uint32_t len)
+{
+    if(!this->WaitFor(0))
+        return NULL;
+
+    return BlockStream::GetBytes(len);
+}
+size_t          SPSCBlockStream::GetBytes           (uint8_t *data, size_t len)
+{
+    if(!this->WaitFor(0))
+        return 0;
+
+    return BlockStream::GetBytes(data, len);
+}
+size_t          SPSCBlockStream::PeekBytes          (uint8_t *data, size_t len)
+{
+    if(!this->WaitFor(0))
+        return 0;
+
+    return BlockStream::PeekBytes(data, len);
+}
+size_t          SPSCBlockStream::PeekBytes          (uint8_t *data, size_t len, size_t offset)
+{
+    if(!this->WaitFor(offset))
+        return 0;
+
+    return BlockStream::PeekBytes(data, len, offset);
+}
+const block_t*  SPSCBlockStream::GetFront           ()
+{
+    if(!this->WaitFor(0))
+        return NULL;
+
+    return BlockStream::GetFront();
+}
+const block_t*  SPSCBlockStream::Front              () const
+{
+    if(!this->WaitFor(0))
+        return NULL;
+
+    return BlockStream::Front();
+}
+uint64_t        SPSCBlockStream::Length             () const
+{
+    this->Drain();
+
+    return BlockStream::Length();
+}
+uint8_t         SPSCBlockStream::ByteAt             (uint64_t position) const
+{
+    if(!this->WaitFor(position))
+        return 0;
+
+    return BlockStream::ByteAt(position);
+}
+const block_t*  SPSCBlockStream::ToBlock            ()
+{
+    if(!this->WaitFor(0))
+        return NULL;
+
+    return BlockStream::ToBlock();
+}
+void            SPSCBlockStream::Clear              ()
+{
+    this->Drain();
+
+    BlockStream::Clear();
+}
+void            SPSCBlockStream::EraseFront         (uint64_t len)
+{
+    this->Drain();
+
+    BlockStream::EraseFront(len);
+}
+BlockStream*    SPSCBlockStream::GetBlocks          (uint64_t len)
+{
+    if(!this->WaitFor(0))
+        return NULL;
+
+    return BlockStream::GetBlocks(len < this->length ? len : this->length);
+}
+void            SPSCBlockStream::PopAndDeleteFront  ()
+{
+    this->Drain();
+
+    BlockStream::PopAndDeleteFront();
+}
+size_t          SPSCBlockStream::Slices             (std::vector<block_slice_t> &slices, uint64_t offset, uint64_t len) const
+{
+    this->Drain();
+
+    return BlockStream::Slices(slices, offset, len);
+}
+SPSCBlockStream::node_t*    SPSCBlockStream::AllocNode  ()
+{
+    /* reuse nodes the consumer has moved past */
+    if(this->first != this->headCopy)
+    {
+        node_t *node = this->first;
+        this->first = this->first->next.load(std::memory_order_relaxed);
+        return node;
+    }
+
+    this->headCopy = this->head.load(std::memory_order_acquire);
+    if(this->first != this->headCopy)
+    {
+        node_t *node = this->first;
+        this->first = this->first->next.load(std::memory_order_relaxed);
+        return node;
+    }
+
+    return new node_t;
+}
+void            SPSCBlockStream::Wake               ()
+{
+    /* pairs with the fence in WaitFor: either the consumer sees the new
+       node or we see it parked */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if(!this->parked.load(std::memory_order_relaxed))
+        return;
+
+    EnterCriticalSection(&this->monitorMutex);
+    WakeAllConditionVariable(&this->full);
+    LeaveCriticalSection(&this->monitorMutex);
+}
+void            SPSCBlockStream::Drain              () const
+{
+    SPSCBlockStream *self = const_cast<SPSCBlockStream *>(this);
+    node_t          *node = this->head.load(std::memory_order_relaxed);
+    node_t          *next = node->next.load(std::memory_order_acquire);
+
+    while(next)
+    {
+        self->BlockStream::PushBack(next->block);
+        next->block = NULL;
+
+        node = next;
+        next = node->next.load(std::memory_order_acquire);
+    }
+
+    this->head.store(node, std::memory_order_release);
+}
+bool            SPSCBlockStream::WaitFor            (uint64_t min) const
+{
+    this->Drain();
+
+    if(this->length <= min && !this->eos.load(std::memory_order_acquire))
+    {
+        EnterCriticalSection(&this->monitorMutex);
+        this->parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        this->Drain();
+        while(this->length <= min && !this->eos.load(std::memory_order_acquire))
+        {
+            SleepConditionVariableCS(&this->full, &this->monitorMutex, INFINITE);
+            this->Drain();
+        }
+
+        this->parked.store(false, std::memory_order_relaxed);
+        LeaveCriticalSection(&this->monitorMutex);
+    }
+
+    /* blocks pushed right before EOS */
+    this->Drain();
+
+    return this->length > min;
+}
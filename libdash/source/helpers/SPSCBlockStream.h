@@ -0,0 +1,85 @@
+/*
+ * SPSCBlockStream.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#ifndef __SPSCBLOCKSTREAM_H__
+#define __SPSCBLOCKSTREAM_H__
+
+#include "config.h"
+
+#include <atomic>
+
+#include "BlockStream.h"
+#include "../portable/MultiThreading.h"
+
+namespace dash
+{
+    namespace helpers
+    {
+        /*
+         * Block stream for exactly one producer thread, which calls PushBack
+         * and SetEOS, and one consumer thread, which calls everything else.
+         * Blocks are handed over through a lock-free linked queue whose nodes
+         * are recycled by the producer; the consumer moves them into the
+         * BlockStream it inherits. The mutex is only taken to park the
+         * consumer while the stream is empty and to wake it again.
+         */
+        class SPSCBlockStream : public BlockStream
+        {
+            public:
+                SPSCBlockStream             ();
+                virtual ~SPSCBlockStream    ();
+
+                virtual void            PushBack            (block_t *block);
+                virtual void            PushFront           (block_t *block);
+                virtual const block_t*  GetBytes            (uint32_t len);
+                virtual size_t          GetBytes            (uint8_t *data, size_t len);
+                virtual size_t          PeekBytes           (uint8_t *data, size_t len);
+                virtual size_t          PeekBytes           (uint8_t *data, size_t len, size_t offset);
+                virtual const block_t*  GetFront            ();
+                virtual const block_t*  Front               ()                  const;
+                virtual uint64_t        Length              ()                  const;
+                virtual uint8_t         ByteAt              (uint64_t position) const;
+                virtual const block_t*  ToBlock             ();
+                virtual void            Clear               ();
+                virtual void            EraseFront          (uint64_t len);
+                virtual BlockStream*    GetBlocks           (uint64_t len);
+                virtual void            PopAndDeleteFront   ();
+                virtual size_t          Slices              (std::vector<block_slice_t> &slices, uint64_t offset, uint64_t len) const;
+                virtual void            SetEOS              (bool value);
+
+            private:
+                struct node_t
+                {
+                    std::atomic<node_t *>   next;
+                    block_t                 *block;
+                };
+
+                /* consumer */
+                mutable std::atomic<node_t *>   head;
+                /* producer */
+                node_t                          *tail;
+                node_t                          *first;
+                node_t                          *headCopy;
+
+                std::atomic<bool>               eos;
+                mutable std::atomic<bool>       parked;
+
+                mutable CRITICAL_SECTION        monitorMutex;
+                mutable CONDITION_VARIABLE      full;
+
+                node_t*     AllocNode   ();
+                void        Wake        ();
+                void        Drain       ()                  const;
+                /*
+                 * Blocks until more than min bytes are buffered or the
+                 * producer signalled EOS; false if that is all there is.
+                 */
+                bool        WaitFor     (uint64_t min)      const;
+        };
+    }
+}
+
+#endif // __SPSCBLOCKSTREAM_H__
@@ -234,11 +234,21 @@ BlockStream*    SyncedBlockStream::GetBlocks          (uint64_t len)
         return NULL;
     }
 
-    BlockStream *stream = BlockStream::GetBlocks(len);
+    BlockStream *stream = BlockStream::GetBlocks(len < this->length ? len : this->length);
     LeaveCriticalSection(&this->monitorMutex);
 
     return stream;
 }
+size_t          SyncedBlockStream::Slices             (std::vector<block_slice_t> &slices, uint64_t offset, uint64_t len) const
+{
+    EnterCriticalSection(&this->monitorMutex);
+
+    size_t ret = BlockStream::Slices(slices, offset, len);
+
+    LeaveCriticalSection(&this->monitorMutex);
+
+    return ret;
+}
 void            SyncedBlockStream::SetEOS             (bool value)
 {
     EnterCriticalSection(&this->monitorMutex);
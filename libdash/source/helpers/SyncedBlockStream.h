@@ -42,6 +42,7 @@ namespace dash
                 virtual void            EraseFront          (uint64_t len);
                 virtual BlockStream*    GetBlocks           (uint64_t len);
                 virtual void            PopAndDeleteFront   ();
+                virtual size_t          Slices              (std::vector<block_slice_t> &slices, uint64_t offset, uint64_t len) const;
                 virtual void            SetEOS              (bool value);
 
             private:
@@ -11,6 +11,9 @@
 
 #include "Time.h"
 
+#include <chrono>
+#include <stdio.h>
+
 using namespace dash::helpers;
 
 uint32_t    Time::GetCurrentUTCTimeInSec   ()
@@ -24,6 +27,19 @@ std::string Time::GetCurrentUTCTimeStr   ()
 
     return std::string(timeString);
 }
+std::string Time::GetCurrentUTCTimeStrMs ()
+{
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+    time_t  rawTime         = std::chrono::system_clock::to_time_t(now);
+    int     milliseconds    = (int) (std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000);
+    char    timeString[40];
+
+    size_t length = strftime(timeString, 30, "%Y-%m-%dT%H:%M:%S", gmtime(&rawTime));
+    snprintf(timeString + length, sizeof(timeString) - length, ".%03dZ", milliseconds);
+
+    return std::string(timeString);
+}
 struct tm*  Time::GetCurrentUTCTime     ()
 {
     time_t      rawTime;
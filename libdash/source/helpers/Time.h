@@ -24,6 +24,11 @@ namespace dash
             public:
                 static uint32_t     GetCurrentUTCTimeInSec  ();
                 static std::string  GetCurrentUTCTimeStr    ();
+                /*
+                 * xs:dateTime with milliseconds, as the metrics of ISO/IEC
+                 * 23009-1 Annex D are reported.
+                 */
+                static std::string  GetCurrentUTCTimeStrMs  ();
 
             private:
                 static struct tm*   GetCurrentUTCTime       ();
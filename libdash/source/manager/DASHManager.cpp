@@ -23,21 +23,46 @@ using namespace dash::helpers;
 
 DASHManager::DASHManager            ()
 {
+    InitializeCriticalSection(&this->monitorMutex);
 }
 DASHManager::~DASHManager           ()
 {
+    DeleteCriticalSection(&this->monitorMutex);
 }
 IMPD*           DASHManager::Open   (char *path)
 {
-    DOMParser parser(path);
+    uint32_t fetchTime = Time::GetCurrentUTCTimeInSec();
+
+    EnterCriticalSection(&this->monitorMutex);
+    MPD* mpd = this->reader.Read(path);
+    LeaveCriticalSection(&this->monitorMutex);
 
+    return this->Finish(mpd, fetchTime);
+}
+IMPD*           DASHManager::Open   (const uint8_t *data, size_t len, const std::string &baseUrl)
+{
     uint32_t fetchTime = Time::GetCurrentUTCTimeInSec();
 
-    if (!parser.Parse())
-        return NULL;
+    EnterCriticalSection(&this->monitorMutex);
+    MPD* mpd = this->reader.Read(data, len, baseUrl);
+    LeaveCriticalSection(&this->monitorMutex);
 
-    MPD* mpd = parser.GetRootNode()->ToMPD();
+    return this->Finish(mpd, fetchTime);
+}
+bool            DASHManager::Patch  (IMPD *mpd, const uint8_t *data, size_t len)
+{
+    EnterCriticalSection(&this->monitorMutex);
+    bool isPatched = this->reader.Patch(dynamic_cast<MPD *>(mpd), data, len);
+    LeaveCriticalSection(&this->monitorMutex);
 
+    return isPatched;
+}
+void            DASHManager::EnableDownloadTracing  (bool enable)
+{
+    CurlTransferPool::Instance()->SetTracing(enable);
+}
+IMPD*           DASHManager::Finish (MPD *mpd, uint32_t fetchTime)
+{
     if (mpd)
         mpd->SetFetchTime(fetchTime);
 
@@ -15,9 +15,11 @@
 #include "config.h"
 
 #include "../xml/Node.h"
-#include "../xml/DOMParser.h"
+#include "../xml/MPDReader.h"
 #include "IDASHManager.h"
 #include "../helpers/Time.h"
+#include "../portable/MultiThreading.h"
+#include "../network/CurlTransferPool.h"
 
 namespace dash
 {
@@ -28,7 +30,16 @@ namespace dash
             virtual ~DASHManager    ();
 
             mpd::IMPD*  Open    (char *path);
+            mpd::IMPD*  Open    (const uint8_t *data, size_t len, const std::string &baseUrl);
+            bool        Patch   (mpd::IMPD *mpd, const uint8_t *data, size_t len);
+            void        EnableDownloadTracing   (bool enable);
             void        Delete  ();
+
+        private:
+            xml::MPDReader              reader;
+            CRITICAL_SECTION            monitorMutex;
+
+            mpd::IMPD*  Finish  (mpd::MPD *mpd, uint32_t fetchTime);
     };
 }
 
@@ -23,6 +23,7 @@ HTTPTransaction::HTTPTransaction () :
                  range           (""),
                  tRequest        (""),
                  tResponse       (""),
+                 tFinish         (""),
                  httpHeader      ("")
 {
 }
@@ -88,6 +89,14 @@ void                                            HTTPTransaction::SetResponseRece
 {
     this->tResponse = tResponse;
 }
+const std::string&                              HTTPTransaction::ResponseFinishedTime       () const
+{
+    return this->tFinish;
+}
+void                                            HTTPTransaction::SetResponseFinishedTime    (std::string tFinish)
+{
+    this->tFinish = tFinish;
+}
 uint16_t                                        HTTPTransaction::ResponseCode               () const
 {
     return this->responseCode;
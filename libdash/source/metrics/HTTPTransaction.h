@@ -32,6 +32,7 @@ namespace dash
                 const std::string&                              Range                   () const;
                 const std::string&                              RequestSentTime         () const;
                 const std::string&                              ResponseReceivedTime    () const;
+                const std::string&                              ResponseFinishedTime    () const;
                 uint16_t                                        ResponseCode            () const;
                 uint64_t                                        Interval                () const;
                 const std::vector<IThroughputMeasurement *>&    ThroughputTrace         () const;
@@ -44,6 +45,7 @@ namespace dash
                 void    SetRange                    (const std::string& range);
                 void    SetRequestSentTime          (std::string tRequest);
                 void    SetResponseReceivedTime     (std::string tResponse);
+                void    SetResponseFinishedTime     (std::string tFinish);
                 void    SetResponseCode             (uint16_t respCode);
                 void    SetInterval                 (uint64_t interval);
                 void    AddThroughputMeasurement    (ThroughputMeasurement *throuputEntry);
@@ -57,6 +59,7 @@ namespace dash
                 std::string                             range;
                 std::string                             tRequest;
                 std::string                             tResponse;
+                std::string                             tFinish;
                 uint16_t                                responseCode;
                 uint64_t                                interval;
                 std::vector<ThroughputMeasurement *>    trace;
@@ -37,5 +37,5 @@ void                                        AbstractMPDElement::AddAdditionalSub
 }
 void                                        AbstractMPDElement::AddRawAttributes        (std::map<std::string, std::string> attributes)
 {
-    this->rawAttributes = attributes;
+    this->rawAttributes.swap(attributes);
 }
\ No newline at end of file
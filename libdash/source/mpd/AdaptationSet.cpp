@@ -148,6 +148,20 @@ void                                    AdaptationSet::AddRepresentation
 {
     this->representation.push_back(representation);
 }
+bool                                    AdaptationSet::RemoveRepresentation             (Representation *representation)
+{
+    for(size_t i = 0; i < this->representation.size(); i++)
+    {
+        if(this->representation.at(i) == representation)
+        {
+            this->representation.erase(this->representation.begin() + i);
+            delete(representation);
+            return true;
+        }
+    }
+
+    return false;
+}
 const std::string&                      AdaptationSet::GetXlinkHref                     ()  const
 {
     return this->xlinkHref;
@@ -83,6 +83,7 @@ namespace dash
                 void    SetSegmentList              (SegmentList *segmentList);
                 void    SetSegmentTemplate          (SegmentTemplate *segmentTemplate);
                 void    AddRepresentation           (Representation* representation);
+                bool    RemoveRepresentation        (Representation* representation);
                 void    SetXlinkHref                (const std::string& xlinkHref);
                 void    SetXlinkActuate             (const std::string& xlinkActuate);
                 void    SetXlinkType                (const std::string& xlinkType);
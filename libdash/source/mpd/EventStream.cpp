@@ -36,6 +36,20 @@ void                           EventStream::AddEvent                   (Event *e
 {
     this->events.push_back(event);
 }
+bool                           EventStream::RemoveEvent                (Event *event)
+{
+    for(size_t i = 0; i < this->events.size(); i++)
+    {
+        if(this->events.at(i) == event)
+        {
+            this->events.erase(this->events.begin() + i);
+            delete(event);
+            return true;
+        }
+    }
+
+    return false;
+}
 const std::string&             EventStream::GetXlinkHref               ()  const
 {
     return this->xlinkHref;
@@ -37,6 +37,7 @@ namespace dash
                 uint64_t                     GetPresentationTimeOffset ()  const;
 
                 void    AddEvent                    (Event *event);
+                bool    RemoveEvent                 (Event *event);
                 void    SetXlinkHref                (const std::string& xlinkHref);
                 void    SetXlinkActuate             (const std::string& xlinkActuate);
                 void    SetSchemeIdUri              (const std::string& schemeIdUri);
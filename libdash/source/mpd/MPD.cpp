@@ -53,6 +53,8 @@ MPD::~MPD   ()
         delete(this->periods.at(i));
     for(size_t i = 0; i < this->baseUrls.size(); i++)
         delete(this->baseUrls.at(i));
+    for(size_t i = 0; i < this->patchLocations.size(); i++)
+        delete(this->patchLocations.at(i));
     for(size_t i = 0; i < this->serviceDescriptions.size(); i++)
         delete(this->serviceDescriptions.at(i));
     for(size_t i = 0; i < this->initializationSets.size(); i++)
@@ -147,6 +149,20 @@ void                                        MPD::AddPeriod
 {
     this->periods.push_back(period);
 }
+bool                                        MPD::RemovePeriod                       (Period *period)
+{
+    for(size_t i = 0; i < this->periods.size(); i++)
+    {
+        if(this->periods.at(i) == period)
+        {
+            this->periods.erase(this->periods.begin() + i);
+            delete(period);
+            return true;
+        }
+    }
+
+    return false;
+}
 const std::vector<IMetrics *>&              MPD::GetMetrics                         () const 
 {
     return (std::vector<IMetrics *> &) this->metrics;
@@ -90,6 +90,7 @@ namespace dash
                 void    AddInitializationPresentation   (UIntVWithID* initializationPresentation);
                 void    AddContentProtection            (ContentProtection *contentProtection);
                 void    AddPeriod                       (Period *period);
+                bool    RemovePeriod                    (Period *period);
                 void    AddMetrics                      (Metrics *metrics);
                 void    AddEssentialProperty            (Descriptor *essentialProperty);
                 void    AddSupplementalProperty         (Descriptor *supplementalProperty);
@@ -131,6 +131,20 @@ void                                        Period::AddAdaptationSet
     if(adaptationSet != NULL)
         this->adaptationSets.push_back(adaptationSet);
 }
+bool                                        Period::RemoveAdaptationSet          (AdaptationSet *adaptationSet)
+{
+    for(size_t i = 0; i < this->adaptationSets.size(); i++)
+    {
+        if(this->adaptationSets.at(i) == adaptationSet)
+        {
+            this->adaptationSets.erase(this->adaptationSets.begin() + i);
+            delete(adaptationSet);
+            return true;
+        }
+    }
+
+    return false;
+}
 const std::vector<ISubset *>&               Period::GetSubsets                   () const
 {
     return (std::vector<ISubset *> &) this->subsets;
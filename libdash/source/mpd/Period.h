@@ -74,6 +74,7 @@ namespace dash
                 void    AddServiceDescription       (ServiceDescription* serviceDescription);
                 void    AddContentProtection        (ContentProtection *contentProtection);
                 void    AddAdaptationSet            (AdaptationSet *AdaptationSet);
+                bool    RemoveAdaptationSet         (AdaptationSet *adaptationSet);
                 void    AddSubset                   (Subset *subset);
                 void    AddSupplementalProperty     (Descriptor *supplementalProperty);
                 void    AddGroupLabel               (Label *groupLabel);
@@ -38,6 +38,20 @@ void                            SegmentList::AddSegmentURL      (SegmentURL *seg
 {
     this->segmentURLs.push_back(segmentURL);
 }
+bool                            SegmentList::RemoveSegmentURL   (SegmentURL *segmentURL)
+{
+    for(size_t i = 0; i < this->segmentURLs.size(); i++)
+    {
+        if(this->segmentURLs.at(i) == segmentURL)
+        {
+            this->segmentURLs.erase(this->segmentURLs.begin() + i);
+            delete(segmentURL);
+            return true;
+        }
+    }
+
+    return false;
+}
 const std::string&              SegmentList::GetXlinkHref       ()  const
 {
     return this->xlinkHref;
@@ -39,6 +39,7 @@ namespace dash
                 const std::string&                  GetXlinkShow    ()  const;
 
                 void    AddSegmentURL   (SegmentURL *segmetURL);
+                bool    RemoveSegmentURL (SegmentURL *segmentURL);
                 void    SetXlinkHref    (const std::string& xlinkHref);
                 void    SetXlinkActuate (const std::string& xlinkActuate);
                 void    SetXlinkType    (const std::string& xlinkType);
@@ -11,6 +11,8 @@
 
 #include "SegmentTemplate.h"
 
+#include <stdlib.h>
+
 using namespace dash::mpd;
 using namespace dash::metrics;
 
@@ -32,6 +34,7 @@ const std::string&  SegmentTemplate::Getmedia                       ()  const
 void                SegmentTemplate::SetMedia                       (const std::string& media)
 {
     this->media = media;
+    this->Compile(this->media, this->mediaParts);
 }
 const std::string&  SegmentTemplate::Getindex                       ()  const
 {
@@ -40,6 +43,7 @@ const std::string&  SegmentTemplate::Getindex                       ()  const
 void                SegmentTemplate::SetIndex                       (const std::string& index)
 {
     this->index = index;
+    this->Compile(this->index, this->indexParts);
 }
 const std::string&  SegmentTemplate::Getinitialization              ()  const
 {
@@ -48,6 +52,7 @@ const std::string&  SegmentTemplate::Getinitialization              ()  const
 void                SegmentTemplate::SetInitialization              (const std::string& initialization)
 {
     this->initialization = initialization;
+    this->Compile(this->initialization, this->initializationParts);
 }
 const std::string&  SegmentTemplate::GetbitstreamSwitching          ()  const
 {
@@ -56,97 +61,191 @@ const std::string&  SegmentTemplate::GetbitstreamSwitching          ()  const
 void                SegmentTemplate::SetBitstreamSwitching          (const std::string& bitstreamSwitching)
 {
     this->bitstreamSwitching = bitstreamSwitching;
+    this->Compile(this->bitstreamSwitching, this->bitstreamSwitchingParts);
 }
 ISegment*           SegmentTemplate::ToInitializationSegment        (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth) const
 {
-    return ToSegment(this->initialization, baseurls, representationID, bandwidth, dash::metrics::InitializationSegment);
+    return ToSegment(this->initializationParts, baseurls, representationID, bandwidth, dash::metrics::InitializationSegment);
 }
 ISegment*           SegmentTemplate::ToBitstreamSwitchingSegment    (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth) const
 {
-    return ToSegment(this->bitstreamSwitching, baseurls, representationID, bandwidth, dash::metrics::BitstreamSwitchingSegment);
+    return ToSegment(this->bitstreamSwitchingParts, baseurls, representationID, bandwidth, dash::metrics::BitstreamSwitchingSegment);
 }
 ISegment*           SegmentTemplate::GetMediaSegmentFromNumber      (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t number) const
 {
-    return ToSegment(this->media, baseurls, representationID, bandwidth, dash::metrics::MediaSegment, number);
+    return ToSegment(this->mediaParts, baseurls, representationID, bandwidth, dash::metrics::MediaSegment, number, this->SegmentTime(number));
 }
 ISegment*           SegmentTemplate::GetIndexSegmentFromNumber      (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t number) const
 {
-    return ToSegment(this->index, baseurls, representationID, bandwidth, dash::metrics::IndexSegment, number);
+    return ToSegment(this->indexParts, baseurls, representationID, bandwidth, dash::metrics::IndexSegment, number, this->SegmentTime(number));
 }
 ISegment*           SegmentTemplate::GetMediaSegmentFromTime        (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t time) const
 {
-    return ToSegment(this->media, baseurls, representationID, bandwidth, dash::metrics::MediaSegment, 0, time);
+    uint32_t number = 0;
+    this->GetSegmentNumberFromTime(time, number);
+
+    return ToSegment(this->mediaParts, baseurls, representationID, bandwidth, dash::metrics::MediaSegment, number, time);
 }
 ISegment*           SegmentTemplate::GetIndexSegmentFromTime        (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t time) const
 {
-    return ToSegment(this->index, baseurls, representationID, bandwidth, dash::metrics::IndexSegment, 0, time);
+    uint32_t number = 0;
+    this->GetSegmentNumberFromTime(time, number);
+
+    return ToSegment(this->indexParts, baseurls, representationID, bandwidth, dash::metrics::IndexSegment, number, time);
 }
-std::string         SegmentTemplate::ReplaceParameters              (const std::string& uri, const std::string& representationID, uint32_t bandwidth, uint32_t number, uint32_t time) const
+bool                SegmentTemplate::GetMediaURIFromNumber          (std::string& uri, const std::string& representationID, uint32_t bandwidth, uint32_t number) const
 {
-    std::vector<std::string> chunks;
-    std::string replacedUri = "";
+    uint64_t startTime  = 0;
+    uint32_t duration   = 0;
 
-    dash::helpers::String::Split(uri, '$', chunks);
+    if(number < this->GetStartNumber())
+        return false;
+
+    if(this->GetSegmentTimeline() && !this->GetSegmentTimeline()->GetSegment(number - this->GetStartNumber(), startTime, duration))
+        return false;
+
+    uri.clear();
+    this->ReplaceParameters(this->mediaParts, representationID, bandwidth, number, startTime, uri);
+    return true;
+}
+bool                SegmentTemplate::GetSegmentNumberFromTime       (uint64_t time, uint32_t& number) const
+{
+    uint32_t index = 0;
 
-    if (chunks.size() > 1) 
+    if(this->GetSegmentTimeline())
+    {
+        if(!this->GetSegmentTimeline()->GetSegmentIndex(time, index))
+            return false;
+    }
+    else
     {
-        for(size_t i = 0; i < chunks.size(); i++) 
+        if(this->GetDuration() == 0)
+            return false;
+
+        index = (uint32_t) (time / this->GetDuration());
+    }
+
+    number = this->GetStartNumber() + index;
+    return true;
+}
+void                SegmentTemplate::Compile                        (const std::string& uri, std::vector<TemplatePart>& parts)
+{
+    parts.clear();
+
+    TemplatePart literal;
+    literal.identifier  = Literal;
+    literal.width       = 0;
+
+    size_t pos = 0;
+    while(pos < uri.size())
+    {
+        size_t begin    = uri.find('$', pos);
+        size_t end      = begin == std::string::npos ? std::string::npos : uri.find('$', begin + 1);
+
+        /* an unpaired $ is kept as text */
+        if(end == std::string::npos)
+        {
+            literal.text.append(uri, pos, std::string::npos);
+            break;
+        }
+
+        literal.text.append(uri, pos, begin - pos);
+        pos = end + 1;
+
+        std::string name    = uri.substr(begin + 1, end - begin - 1);
+        size_t      format  = name.find("%0");
+
+        TemplatePart part;
+        part.identifier = Literal;
+        part.width      = format == std::string::npos ? 0 : (uint32_t) strtoul(name.c_str() + format + 2, NULL, 10);
+
+        if(name.empty())
         {
-            if ( chunks.at(i) == "RepresentationID") {
-                chunks.at(i) = representationID;
-                continue;
-            }
-
-            if (chunks.at(i).find("Bandwidth") == 0)
-            {
-                FormatChunk(chunks.at(i), bandwidth);
-                continue;
-            }
-
-            if (chunks.at(i).find("Number") == 0)
-            {
-                FormatChunk(chunks.at(i), number);
-                continue;
-            }
-
-            if (chunks.at(i).find("Time") == 0)
-            {
-                FormatChunk(chunks.at(i), time);
-                continue;
-            }
+            literal.text.push_back('$');
+            continue;
         }
 
-        for(size_t i = 0; i < chunks.size(); i++) 
-            replacedUri += chunks.at(i);
+        if(name == "RepresentationID")
+            part.identifier = RepresentationID;
+        else if(name.compare(0, 9, "Bandwidth") == 0)
+            part.identifier = Bandwidth;
+        else if(name.compare(0, 6, "Number") == 0)
+            part.identifier = Number;
+        else if(name.compare(0, 4, "Time") == 0)
+            part.identifier = Time;
+
+        /* unknown identifiers are not replaced */
+        if(part.identifier == Literal)
+        {
+            literal.text.append(uri, begin, end - begin + 1);
+            continue;
+        }
 
-        return replacedUri;
+        if(!literal.text.empty())
+        {
+            parts.push_back(literal);
+            literal.text.clear();
+        }
+        parts.push_back(part);
     }
-    else
+
+    if(!literal.text.empty())
+        parts.push_back(literal);
+}
+void                SegmentTemplate::ReplaceParameters              (const std::vector<TemplatePart>& parts, const std::string& representationID, uint32_t bandwidth, uint32_t number, uint64_t time, std::string& uri) const
+{
+    for(size_t i = 0; i < parts.size(); i++)
     {
-        replacedUri = uri;
-        return replacedUri;
+        const TemplatePart &part = parts[i];
+
+        switch(part.identifier)
+        {
+            case Literal:           uri.append(part.text);                      break;
+            case RepresentationID:  uri.append(representationID);               break;
+            case Bandwidth:         AppendNumber(uri, bandwidth, part.width);   break;
+            case Number:            AppendNumber(uri, number, part.width);      break;
+            case Time:              AppendNumber(uri, time, part.width);        break;
+        }
     }
 }
-void                SegmentTemplate::FormatChunk                    (std::string& uri, uint32_t number) const
+uint64_t            SegmentTemplate::SegmentTime                    (uint32_t number) const
 {
-    char formattedNumber [50];
-    size_t pos = 0;
-    std::string formatTag = "%01d";
+    uint64_t startTime  = 0;
+    uint32_t duration   = 0;
 
-    if ( (pos = uri.find("%0")) != std::string::npos)
-        formatTag = uri.substr(pos).append("d");
+    if(this->GetSegmentTimeline() && number >= this->GetStartNumber())
+        this->GetSegmentTimeline()->GetSegment(number - this->GetStartNumber(), startTime, duration);
 
-    sprintf(formattedNumber, formatTag.c_str(), number);
-    uri = formattedNumber;
+    return startTime;
 }
-ISegment*           SegmentTemplate::ToSegment                      (const std::string& uri, const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, HTTPTransactionType type, uint32_t number, uint32_t time) const
+void                SegmentTemplate::AppendNumber                   (std::string& uri, uint64_t number, uint32_t width)
 {
-    Segment *seg = new Segment();
+    char    digits[20];
+    size_t  count = 0;
+
+    do
+    {
+        digits[count++] = '0' + number % 10;
+        number /= 10;
+    }while(number > 0);
+
+    if(width > count)
+        uri.append(width - count, '0');
 
-    if(seg->Init(baseurls, ReplaceParameters(uri, representationID, bandwidth, number, time), "", type))
+    while(count > 0)
+        uri.push_back(digits[--count]);
+}
+ISegment*           SegmentTemplate::ToSegment                      (const std::vector<TemplatePart>& parts, const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, HTTPTransactionType type, uint32_t number, uint64_t time) const
+{
+    Segment     *seg = new Segment();
+    std::string uri;
+
+    this->ReplaceParameters(parts, representationID, bandwidth, number, time, uri);
+
+    if(seg->Init(baseurls, uri, "", type))
         return seg;
 
     delete(seg);
 
     return NULL;
-}
\ No newline at end of file
+}
@@ -16,7 +16,6 @@
 
 #include "ISegmentTemplate.h"
 #include "MultipleSegmentBase.h"
-#include "../helpers/String.h"
 
 namespace dash
 {
@@ -38,6 +37,8 @@ namespace dash
                 ISegment*           GetIndexSegmentFromNumber   (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t number) const;
                 ISegment*           GetMediaSegmentFromTime     (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t time) const;
                 ISegment*           GetIndexSegmentFromTime     (const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, uint32_t time) const;
+                bool                GetMediaURIFromNumber       (std::string& uri, const std::string& representationID, uint32_t bandwidth, uint32_t number) const;
+                bool                GetSegmentNumberFromTime    (uint64_t time, uint32_t& number) const;
 
                 void    SetMedia                (const std::string& media);
                 void    SetIndex                (const std::string& index);
@@ -45,15 +46,43 @@ namespace dash
                 void    SetBitstreamSwitching   (const std::string& bitstreamSwichting);
 
             private:
-                std::string ReplaceParameters   (const std::string& uri, const std::string& representationID, uint32_t bandwidth, uint32_t number, uint32_t time) const;
-                void        FormatChunk         (std::string& uri, uint32_t number) const;
-                ISegment*   ToSegment           (const std::string& uri, const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, 
-                                                 dash::metrics::HTTPTransactionType type, uint32_t number = 0, uint32_t time = 0) const;
+                /*
+                 * A template split at its $ identifiers once when it is set.
+                 * Literal parts hold the text between identifiers, $$
+                 * included as a single $.
+                 */
+                enum Identifier
+                {
+                    Literal,
+                    RepresentationID,
+                    Bandwidth,
+                    Number,
+                    Time
+                };
+                struct TemplatePart
+                {
+                    Identifier  identifier;
+                    std::string text;
+                    uint32_t    width;      /* minimum digits from a %0<width>d format tag */
+                };
+
+                void        Compile             (const std::string& uri, std::vector<TemplatePart>& parts);
+                void        ReplaceParameters   (const std::vector<TemplatePart>& parts, const std::string& representationID, uint32_t bandwidth, uint32_t number, uint64_t time, std::string& uri) const;
+                uint64_t    SegmentTime         (uint32_t number) const;
+                ISegment*   ToSegment           (const std::vector<TemplatePart>& parts, const std::vector<IBaseUrl *>& baseurls, const std::string& representationID, uint32_t bandwidth, 
+                                                 dash::metrics::HTTPTransactionType type, uint32_t number = 0, uint64_t time = 0) const;
+
+                static void AppendNumber        (std::string& uri, uint64_t number, uint32_t width);
 
                 std::string media;
                 std::string index;
                 std::string initialization;
                 std::string bitstreamSwitching;
+
+                std::vector<TemplatePart>   mediaParts;
+                std::vector<TemplatePart>   indexParts;
+                std::vector<TemplatePart>   initializationParts;
+                std::vector<TemplatePart>   bitstreamSwitchingParts;
         };
     }
 }
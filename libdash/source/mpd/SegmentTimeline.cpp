@@ -11,6 +11,8 @@
 
 #include "SegmentTimeline.h"
 
+#include <algorithm>
+
 using namespace dash::mpd;
 
 SegmentTimeline::SegmentTimeline    ()
@@ -26,7 +28,112 @@ std::vector<ITimeline *>&   SegmentTimeline::GetTimelines   ()  const
 {
     return (std::vector<ITimeline*> &) this->timelines;
 }
+uint32_t                    SegmentTimeline::GetSegmentCount()  const
+{
+    if(this->runs.empty())
+        return 0;
+
+    const Run &last = this->runs.back();
+    if(last.count == OPEN_COUNT)
+        return UINT32_MAX;
+
+    return last.firstIndex + last.count;
+}
+bool                        SegmentTimeline::IsBeforeIndex  (uint32_t index, const Run &run)
+{
+    return index < run.firstIndex;
+}
+bool                        SegmentTimeline::IsBeforeTime   (uint64_t time, const Run &run)
+{
+    return time < run.startTime;
+}
+bool                        SegmentTimeline::GetSegment     (uint32_t index, uint64_t &startTime, uint32_t &duration)  const
+{
+    std::vector<Run>::const_iterator it = std::upper_bound(this->runs.begin(), this->runs.end(), index, IsBeforeIndex);
+    if(it == this->runs.begin())
+        return false;
+
+    const Run   &run    = *(--it);
+    uint32_t    offset  = index - run.firstIndex;
+    if(run.count != OPEN_COUNT && offset >= run.count)
+        return false;
+
+    startTime   = run.startTime + (uint64_t) offset * run.duration;
+    duration    = run.duration;
+    return true;
+}
+bool                        SegmentTimeline::GetSegmentIndex(uint64_t time, uint32_t &index)  const
+{
+    std::vector<Run>::const_iterator it = std::upper_bound(this->runs.begin(), this->runs.end(), time, IsBeforeTime);
+    if(it == this->runs.begin())
+        return false;
+
+    const Run &run = *(--it);
+    if(run.duration == 0)
+        return false;
+
+    /* past the last segment of the run is either a gap or behind the timeline */
+    uint64_t offset = (time - run.startTime) / run.duration;
+    if(run.count != OPEN_COUNT ? offset >= run.count : offset >= (uint64_t) (UINT32_MAX - run.firstIndex))
+        return false;
+
+    index = run.firstIndex + (uint32_t) offset;
+    return true;
+}
 void                        SegmentTimeline::AddTimeline    (Timeline *timeline)
 {
     this->timelines.push_back(timeline);
-}
\ No newline at end of file
+    this->Index(timeline);
+}
+bool                        SegmentTimeline::RemoveTimeline (Timeline *timeline)
+{
+    for(size_t i = 0; i < this->timelines.size(); i++)
+    {
+        if(this->timelines.at(i) == timeline)
+        {
+            this->timelines.erase(this->timelines.begin() + i);
+            delete(timeline);
+            this->Reindex();
+            return true;
+        }
+    }
+
+    return false;
+}
+void                        SegmentTimeline::Reindex        ()
+{
+    this->runs.clear();
+
+    for(size_t i = 0; i < this->timelines.size(); i++)
+        this->Index(this->timelines.at(i));
+}
+void                        SegmentTimeline::Index          (const ITimeline *timeline)
+{
+    Run run;
+    run.startTime   = timeline->GetStartTime();
+    run.duration    = timeline->GetDuration();
+    run.firstIndex  = 0;
+    /* @r of -1 is read as UINT32_MAX */
+    run.count       = timeline->GetRepeatCount() == UINT32_MAX ? OPEN_COUNT : timeline->GetRepeatCount() + 1;
+
+    if(!this->runs.empty())
+    {
+        Run &last = this->runs.back();
+
+        /* @r of -1 repeats up to the next S */
+        if(last.count == OPEN_COUNT)
+        {
+            uint64_t span = run.startTime > last.startTime ? run.startTime - last.startTime : 0;
+            last.count = last.duration > 0 ? (uint32_t) ((span + last.duration - 1) / last.duration) : 0;
+        }
+
+        /* without @t an S continues where the previous one ended */
+        uint64_t end = last.startTime + (uint64_t) last.count * last.duration;
+        if(run.startTime < end)
+            run.startTime = end;
+
+        run.firstIndex = last.firstIndex + last.count;
+    }
+
+    this->runs.push_back(run);
+}
@@ -29,10 +29,40 @@ namespace dash
                 virtual ~SegmentTimeline    ();
 
                 std::vector<ITimeline *>&   GetTimelines    ()  const;
+                uint32_t                    GetSegmentCount ()  const;
+                bool                        GetSegment      (uint32_t index, uint64_t &startTime, uint32_t &duration)  const;
+                bool                        GetSegmentIndex (uint64_t time, uint32_t &index)  const;
+
                 void                        AddTimeline     (Timeline *timeline);
+                bool                        RemoveTimeline  (Timeline *timeline);
+                /*
+                 * Rebuilds the index after S attributes were changed in place.
+                 */
+                void                        Reindex         ();
 
             private:
+                /*
+                 * One S element: count segments of the same duration from
+                 * startTime on, the first one being segment firstIndex. The
+                 * runs are sorted by both startTime and firstIndex.
+                 */
+                struct Run
+                {
+                    uint64_t    startTime;
+                    uint32_t    duration;
+                    uint32_t    firstIndex;
+                    uint32_t    count;      /* OPEN_COUNT while @r is -1 and no S follows */
+                };
+
+                static const uint32_t       OPEN_COUNT = UINT32_MAX;
+
                 std::vector<ITimeline *>    timelines;
+                std::vector<Run>            runs;
+
+                void                        Index           (const ITimeline *timeline);
+
+                static bool                 IsBeforeIndex   (uint32_t index, const Run &run);
+                static bool                 IsBeforeTime    (uint64_t time, const Run &run);
         };
     }
 }
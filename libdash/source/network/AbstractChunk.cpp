@@ -10,17 +10,23 @@
  *****************************************************************************/
 
 #include "AbstractChunk.h"
+#include "AsyncConnectionManager.h"
+#include "CurlTransferPool.h"
 
 using namespace dash::network;
 using namespace dash::helpers;
 using namespace dash::metrics;
 
-uint32_t AbstractChunk::BLOCKSIZE = 32768;
+uint32_t AbstractChunk::BLOCKSIZE   = 32768;
+uint32_t AbstractChunk::NOTIFYSIZE  = 262144;
 
 AbstractChunk::AbstractChunk        ()  :
-               connection           (NULL),
                dlThread             (NULL),
-               bytesDownloaded      (0)
+               connection           (NULL),
+               asyncConnection      (NULL),
+               blockWriter          (&blockStream),
+               bytesDownloaded      (0),
+               bytesNotified        (0)
 {
 }
 AbstractChunk::~AbstractChunk       ()
@@ -40,35 +46,37 @@ bool    AbstractChunk::StartDownload                ()
     if(this->stateManager.State() != NOT_STARTED)
         return false;
 
-    curl_global_init(CURL_GLOBAL_ALL);
-
-    this->curl = curl_easy_init();
-    curl_easy_setopt(this->curl, CURLOPT_URL, this->AbsoluteURI().c_str());
-    curl_easy_setopt(this->curl, CURLOPT_WRITEFUNCTION, CurlResponseCallback);
-    curl_easy_setopt(this->curl, CURLOPT_WRITEDATA, (void *)this);
-    /* Debug Callback */
-    curl_easy_setopt(this->curl, CURLOPT_VERBOSE, 1L);
-    curl_easy_setopt(this->curl, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
-    curl_easy_setopt(this->curl, CURLOPT_DEBUGDATA, (void *)this);
-    curl_easy_setopt(this->curl, CURLOPT_FAILONERROR, true);
-
-    if(this->HasByteRange())
-        curl_easy_setopt(this->curl, CURLOPT_RANGE, this->Range().c_str());
-
-    this->dlThread = CreateThreadPortable (DownloadInternalConnection, this);
+    this->stateManager.State(IN_PROGRESS);
 
-    if(this->dlThread == NULL)
-        return false;
+    if(CurlTransferPool::Instance()->Add(this))
+        return true;
 
-    this->stateManager.State(IN_PROGRESS);
+    this->stateManager.State(NOT_STARTED);
 
-    return true;
+    return false;
 }
 bool    AbstractChunk::StartDownload                (IConnection *connection)
 {
     if(this->stateManager.State() != NOT_STARTED)
         return false;
 
+#if defined __linux__
+    /* served by an event loop instead of a thread of its own */
+    IAsyncConnection *asyncConnection = dynamic_cast<IAsyncConnection *>(connection);
+    if(asyncConnection != NULL)
+    {
+        this->connection        = connection;
+        this->asyncConnection   = asyncConnection;
+        this->stateManager.State(IN_PROGRESS);
+
+        if(AsyncConnectionManager::Instance()->Add(this, asyncConnection))
+            return true;
+
+        this->asyncConnection   = NULL;
+        this->stateManager.State(NOT_STARTED);
+    }
+#endif
+
     this->dlThread = CreateThreadPortable (DownloadExternalConnection, this);
 
     if(this->dlThread == NULL)
@@ -91,6 +99,10 @@ int     AbstractChunk::Peek                         (uint8_t *data, size_t len,
 {
     return this->blockStream.PeekBytes(data, len, offset);
 }
+BlockStream*    AbstractChunk::ReadBlocks           (size_t len)
+{
+    return this->blockStream.GetBlocks(len);
+}
 void    AbstractChunk::AttachDownloadObserver       (IDownloadObserver *observer)
 {
     this->observers.push_back(observer);
@@ -112,57 +124,102 @@ void    AbstractChunk::DetachDownloadObserver       (IDownloadObserver *observer
 void*   AbstractChunk::DownloadExternalConnection   (void *abstractchunk)
 {
     AbstractChunk   *chunk  = (AbstractChunk *) abstractchunk;
-    block_t         *block  = AllocBlock(chunk->BLOCKSIZE);
     int             ret     = 0;
 
     do
     {
-        ret = chunk->connection->Read(block->data, block->len, chunk);
+        /* read straight into the tail of a pooled slab */
+        size_t  len     = 0;
+        uint8_t *data   = chunk->blockWriter.Reserve(len);
+
+        if(len > chunk->BLOCKSIZE)
+            len = chunk->BLOCKSIZE;
+
+        ret = chunk->connection->Read(data, len, chunk);
         if(ret > 0)
         {
-            block_t *streamblock = AllocBlock(ret);
-            memcpy(streamblock->data, block->data, ret);
-            chunk->blockStream.PushBack(streamblock);
-            chunk->bytesDownloaded += ret;
-
-            chunk->NotifyDownloadRateChanged();
+            chunk->blockWriter.Commit(ret);
+            chunk->DownloadedBytes(ret);
         }
         if(chunk->stateManager.State() == REQUEST_ABORT)
             ret = 0;
 
     }while(ret);
 
-    DeleteBlock(block);
-
-    if(chunk->stateManager.State() == REQUEST_ABORT)
-        chunk->stateManager.State(ABORTED);
-    else
-        chunk->stateManager.State(COMPLETED);
-
-    chunk->blockStream.SetEOS(true);
+    chunk->FinishDownload();
 
     return NULL;
 }
-void*   AbstractChunk::DownloadInternalConnection   (void *abstractchunk)
+int     AbstractChunk::DownloadAvailable            ()
 {
-    AbstractChunk *chunk  = (AbstractChunk *) abstractchunk;
+    int ret = 0;
+
+    do
+    {
+        if(this->stateManager.State() == REQUEST_ABORT)
+            return 0;
 
-    chunk->response = curl_easy_perform(chunk->curl);
+        size_t  len     = 0;
+        uint8_t *data   = this->blockWriter.Reserve(len);
 
-    curl_easy_cleanup(chunk->curl);
-    curl_global_cleanup();
+        if(len > BLOCKSIZE)
+            len = BLOCKSIZE;
 
-    if(chunk->stateManager.State() == REQUEST_ABORT)
-        chunk->stateManager.State(ABORTED);
+        ret = this->asyncConnection->ReadNonBlocking(data, len, this);
+        if(ret > 0)
+        {
+            this->blockWriter.Commit(ret);
+            this->DownloadedBytes(ret);
+        }
+    }while(ret > 0);
+
+    return ret == READ_WOULD_BLOCK ? READ_WOULD_BLOCK : 0;
+}
+void    AbstractChunk::FinishDownload               ()
+{
+    if(this->bytesNotified != this->bytesDownloaded)
+        this->NotifyDownloadRateChanged();
+
+    if(this->stateManager.State() == REQUEST_ABORT)
+        this->stateManager.State(ABORTED);
     else
-        chunk->stateManager.State(COMPLETED);
+        this->stateManager.State(COMPLETED);
 
-    chunk->blockStream.SetEOS(true);
+    this->blockStream.SetEOS(true);
+}
+void    AbstractChunk::SetupTransfer                (CURL *curl)
+{
+    curl_easy_setopt(curl, CURLOPT_URL, this->AbsoluteURI().c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CurlResponseCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)this);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, CurlHeaderCallback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)this);
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, CurlProgressCallback);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, (void *)this);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
 
-    return NULL;
+    if(this->HasByteRange())
+        curl_easy_setopt(curl, CURLOPT_RANGE, this->Range().c_str());
+
+    this->HandleHeaderOutCallback();
+}
+void    AbstractChunk::FinishTransfer               (CURLcode response)
+{
+    this->response = response;
+    this->FinishDownload();
+}
+void    AbstractChunk::DownloadedBytes              (size_t len)
+{
+    this->bytesDownloaded += len;
+
+    if(this->bytesDownloaded - this->bytesNotified >= NOTIFYSIZE)
+        this->NotifyDownloadRateChanged();
 }
 void    AbstractChunk::NotifyDownloadRateChanged    ()
 {
+    this->bytesNotified = this->bytesDownloaded;
+
     for(size_t i = 0; i < this->observers.size(); i++)
         this->observers.at(i)->OnDownloadRateChanged(this->bytesDownloaded);
 }
@@ -174,35 +231,26 @@ size_t  AbstractChunk::CurlResponseCallback         (void *contents, size_t size
     if(chunk->stateManager.State() == REQUEST_ABORT)
         return 0;
 
-    block_t *block = AllocBlock(realsize);
+    chunk->blockWriter.Write((const uint8_t *) contents, realsize);
+    chunk->DownloadedBytes(realsize);
 
-    memcpy(block->data, contents, realsize);
-    chunk->blockStream.PushBack(block);
+    return realsize;
+}
+size_t  AbstractChunk::CurlHeaderCallback           (void *headerData, size_t size, size_t nmemb, void *userdata)
+{
+    size_t realsize = size * nmemb;
+    AbstractChunk *chunk = (AbstractChunk *)userdata;
 
-    chunk->bytesDownloaded += realsize;
-    chunk->NotifyDownloadRateChanged();
+    chunk->HandleHeaderInCallback(std::string((const char *) headerData, realsize));
 
     return realsize;
 }
-size_t  AbstractChunk::CurlDebugCallback            (CURL *url, curl_infotype infoType, char * data, size_t length, void *userdata)
-{
-    AbstractChunk   *chunk      = (AbstractChunk *)userdata;
-
-    switch (infoType) {
-        case CURLINFO_TEXT:
-            break;
-        case CURLINFO_HEADER_OUT:
-            chunk->HandleHeaderOutCallback();
-            break;
-        case CURLINFO_HEADER_IN:
-            chunk->HandleHeaderInCallback(std::string(data));
-            break;
-        case CURLINFO_DATA_IN:
-            break;
-        default:
-            return 0;
-    }
-    return 0;
+int     AbstractChunk::CurlProgressCallback         (void *userdata, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+{
+    AbstractChunk *chunk = (AbstractChunk *)userdata;
+
+    /* also ends aborted transfers that receive nothing */
+    return chunk->stateManager.State() == REQUEST_ABORT ? 1 : 0;
 }
 void    AbstractChunk::HandleHeaderOutCallback      ()
 {
@@ -219,10 +267,11 @@ void    AbstractChunk::HandleHeaderInCallback       (std::string data)
 {
     HTTPTransaction *httpTransaction = this->httpTransactions.at(this->httpTransactions.size()-1);
 
-    if (data.substr(0,4) == "HTTP")
+    /* HTTP/1.1 200 OK, HTTP/2 200 */
+    if (data.substr(0,4) == "HTTP" && data.find(' ') != std::string::npos)
     {
         httpTransaction->SetResponseReceivedTime(Time::GetCurrentUTCTimeStr());
-        httpTransaction->SetResponseCode(strtoul(data.substr(9,3).c_str(), NULL, 10));
+        httpTransaction->SetResponseCode(strtoul(data.substr(data.find(' ') + 1).c_str(), NULL, 10));
     }
 
     httpTransaction->AddHTTPHeaderLine(data);
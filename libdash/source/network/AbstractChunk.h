@@ -15,8 +15,10 @@
 #include "config.h"
 
 #include "IDownloadableChunk.h"
+#include "IAsyncConnection.h"
 #include "DownloadStateManager.h"
-#include "../helpers/SyncedBlockStream.h"
+#include "../helpers/SPSCBlockStream.h"
+#include "../helpers/BlockWriter.h"
 #include "../portable/Networking.h"
 #include <curl/curl.h>
 #include "../metrics/HTTPTransaction.h"
@@ -58,9 +60,31 @@ namespace dash
                 virtual void    AttachDownloadObserver  (IDownloadObserver *observer);
                 virtual void    DetachDownloadObserver  (IDownloadObserver *observer);
                 /*
-                 * Observer Notification
+                 * Zero-copy read: moves up to len downloaded bytes into a new
+                 * stream owned by the caller, whose Slices() gives a scatter/
+                 * gather view of them. Blocks until data arrives, NULL at EOS.
+                 */
+                helpers::BlockStream*   ReadBlocks      (size_t len);
+                /*
+                 * Observer Notification, batched to one call per NOTIFYSIZE
+                 * bytes; the final count is always reported.
                  */
                 void NotifyDownloadRateChanged ();
+                /*
+                 * Event loop side of a download through an IAsyncConnection:
+                 * reads whatever is available without blocking and returns
+                 * READ_WOULD_BLOCK, or 0 once the download has to be ended
+                 * with FinishDownload().
+                 */
+                int     DownloadAvailable   ();
+                void    FinishDownload      ();
+                /*
+                 * CurlTransferPool side of an internal download: sets the
+                 * request options of a pooled easy handle and ends the
+                 * download with the transfer's result.
+                 */
+                void    SetupTransfer       (CURL *curl);
+                void    FinishTransfer      (CURLcode response);
                 /*
                  * IDASHMetrics
                  */
@@ -71,24 +95,27 @@ namespace dash
                 std::vector<IDownloadObserver *>    observers;
                 THREAD_HANDLE                       dlThread;
                 IConnection                         *connection;
-                helpers::SyncedBlockStream          blockStream;
-                CURL                                *curl;
+                IAsyncConnection                    *asyncConnection;
+                helpers::SPSCBlockStream            blockStream;
+                helpers::BlockWriter                blockWriter;
                 CURLcode                            response;
                 uint64_t                            bytesDownloaded;
+                uint64_t                            bytesNotified;
                 DownloadStateManager                stateManager;
 
                 std::vector<dash::metrics::TCPConnection *>     tcpConnections;
                 std::vector<dash::metrics::HTTPTransaction *>   httpTransactions;
 
                 static uint32_t BLOCKSIZE;
+                static uint32_t NOTIFYSIZE;
 
                 static void*    DownloadExternalConnection  (void *chunk);
-                static void*    DownloadInternalConnection  (void *chunk);
                 static size_t   CurlResponseCallback        (void *contents, size_t size, size_t nmemb, void *userp);
                 static size_t   CurlHeaderCallback          (void *headerData, size_t size, size_t nmemb, void *userdata);
-                static size_t   CurlDebugCallback           (CURL *url, curl_infotype infoType, char * data, size_t length, void *userdata);
+                static int      CurlProgressCallback        (void *userdata, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
                 void            HandleHeaderOutCallback     ();
                 void            HandleHeaderInCallback      (std::string data);
+                void            DownloadedBytes             (size_t len);
         };
     }
 }
@@ -0,0 +1,218 @@
+/*
+ * AsyncConnectionManager.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#include "AsyncConnectionManager.h"
+
+#if defined __linux__
+
+#include "AbstractChunk.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace dash::network;
+
+AsyncConnectionManager::AsyncConnectionManager  (size_t loopCount)
+{
+    for(size_t i = 0; i < loopCount; i++)
+    {
+        Loop *loop = new Loop();
+
+        loop->epoll     = epoll_create1(EPOLL_CLOEXEC);
+        loop->wakeUp    = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        loop->isRunning = true;
+        loop->isStopped = false;
+        InitializeCriticalSection   (&loop->lock);
+        InitializeConditionVariable (&loop->stopped);
+
+        struct epoll_event event;
+        event.events    = EPOLLIN;
+        event.data.fd   = loop->wakeUp;
+        epoll_ctl(loop->epoll, EPOLL_CTL_ADD, loop->wakeUp, &event);
+
+        loop->thread = CreateThreadPortable(Run, loop);
+        if(loop->thread == NULL)
+            loop->isStopped = true;
+
+        this->loops.push_back(loop);
+    }
+}
+AsyncConnectionManager::~AsyncConnectionManager ()
+{
+    for(size_t i = 0; i < this->loops.size(); i++)
+    {
+        Loop        *loop   = this->loops.at(i);
+        uint64_t    one     = 1;
+
+        EnterCriticalSection(&loop->lock);
+        loop->isRunning = false;
+
+        if(write(loop->wakeUp, &one, sizeof(one)) == sizeof(one))
+            while(!loop->isStopped)
+                SleepConditionVariableCS(&loop->stopped, &loop->lock, INFINITE);
+
+        LeaveCriticalSection(&loop->lock);
+
+        close(loop->wakeUp);
+        close(loop->epoll);
+        DestroyThreadPortable   (loop->thread);
+        DeleteConditionVariable (&loop->stopped);
+        DeleteCriticalSection   (&loop->lock);
+        delete(loop);
+    }
+}
+
+AsyncConnectionManager* AsyncConnectionManager::Instance    ()
+{
+    static AsyncConnectionManager manager(ASYNC_LOOP_COUNT);
+
+    return &manager;
+}
+bool                    AsyncConnectionManager::Add         (AbstractChunk *chunk, IAsyncConnection *connection)
+{
+    int socket = connection->Descriptor();
+
+    if(socket < 0 || this->loops.size() == 0)
+        return false;
+
+    Loop *loop = this->loops.at(socket % this->loops.size());
+
+    if(loop->isStopped)
+        return false;
+
+    Download download;
+    download.chunk      = chunk;
+    download.connection = connection;
+
+    EnterCriticalSection(&loop->lock);
+    loop->added.push_back(download);
+    LeaveCriticalSection(&loop->lock);
+
+    uint64_t one = 1;
+    return write(loop->wakeUp, &one, sizeof(one)) == sizeof(one);
+}
+void*                   AsyncConnectionManager::Run         (void *data)
+{
+    Loop                                    *loop       = (Loop *) data;
+    struct epoll_event                      events[ASYNC_MAX_EVENTS];
+    std::chrono::steady_clock::time_point   lastSweep   = std::chrono::steady_clock::now();
+
+    while(true)
+    {
+        int count = epoll_wait(loop->epoll, events, ASYNC_MAX_EVENTS, ASYNC_LOOP_TIMEOUT);
+
+        std::vector<Download>   added;
+        std::vector<int>        ready;
+
+        EnterCriticalSection(&loop->lock);
+        bool isRunning = loop->isRunning;
+        added.swap(loop->added);
+        LeaveCriticalSection(&loop->lock);
+
+        if(!isRunning)
+            break;
+
+        for(size_t i = 0; i < added.size(); i++)
+            Watch(loop, added.at(i), ready);
+
+        for(int i = 0; i < count; i++)
+        {
+            if(events[i].data.fd == loop->wakeUp)
+            {
+                uint64_t value;
+                if(read(loop->wakeUp, &value, sizeof(value)) < 0)
+                    continue;
+            }
+            else
+            {
+                ready.push_back(events[i].data.fd);
+            }
+        }
+
+        /* edge triggered: a socket has to be read until it would block */
+        std::sort(ready.begin(), ready.end());
+        ready.erase(std::unique(ready.begin(), ready.end()), ready.end());
+
+        for(size_t i = 0; i < ready.size(); i++)
+            Serve(loop, ready.at(i));
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(now - lastSweep >= std::chrono::milliseconds(ASYNC_LOOP_TIMEOUT))
+        {
+            Sweep(loop);
+            lastSweep = now;
+        }
+    }
+
+    EnterCriticalSection(&loop->lock);
+    loop->isStopped = true;
+    WakeAllConditionVariable(&loop->stopped);
+    LeaveCriticalSection(&loop->lock);
+
+    return NULL;
+}
+void                    AsyncConnectionManager::Watch       (Loop *loop, const Download &download, std::vector<int> &ready)
+{
+    int socket = download.connection->Descriptor();
+
+    /* a socket closed and reopened under the same number is no longer in the epoll set */
+    struct epoll_event event;
+    event.events    = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    event.data.fd   = socket;
+    epoll_ctl(loop->epoll, EPOLL_CTL_ADD, socket, &event);
+
+    loop->sockets[socket].push_back(download);
+
+    /* its data may already be buffered by the connection */
+    ready.push_back(socket);
+}
+void                    AsyncConnectionManager::Serve       (Loop *loop, int socket)
+{
+    std::map<int, std::vector<Download> >::iterator it = loop->sockets.find(socket);
+    if(it == loop->sockets.end())
+        return;
+
+    std::vector<Download>   &downloads  = it->second;
+    bool                    isFinished  = true;
+
+    /* the end of one response can make the next one readable */
+    while(isFinished)
+    {
+        isFinished = false;
+
+        for(size_t i = 0; i < downloads.size() && !isFinished; i++)
+        {
+            if(downloads.at(i).chunk->DownloadAvailable() == READ_WOULD_BLOCK)
+                continue;
+
+            AbstractChunk *chunk = downloads.at(i).chunk;
+            downloads.erase(downloads.begin() + i);
+            chunk->FinishDownload();
+            isFinished = true;
+        }
+    }
+
+    if(downloads.empty())
+    {
+        epoll_ctl(loop->epoll, EPOLL_CTL_DEL, socket, NULL);
+        loop->sockets.erase(it);
+    }
+}
+void                    AsyncConnectionManager::Sweep       (Loop *loop)
+{
+    /* aborted downloads on sockets without traffic */
+    std::vector<int> sockets;
+    for(std::map<int, std::vector<Download> >::iterator it = loop->sockets.begin(); it != loop->sockets.end(); ++it)
+        sockets.push_back(it->first);
+
+    for(size_t i = 0; i < sockets.size(); i++)
+        Serve(loop, sockets.at(i));
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,81 @@
+/*
+ * AsyncConnectionManager.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#ifndef ASYNCCONNECTIONMANAGER_H_
+#define ASYNCCONNECTIONMANAGER_H_
+
+#include "config.h"
+
+#if defined __linux__
+
+#include "IAsyncConnection.h"
+#include "../portable/MultiThreading.h"
+
+#include <map>
+
+#define ASYNC_LOOP_COUNT    2       /* event loop threads of the shared manager */
+#define ASYNC_LOOP_TIMEOUT  100     /* ms between checks for aborted downloads on idle sockets */
+#define ASYNC_MAX_EVENTS    64
+
+namespace dash
+{
+    namespace network
+    {
+        class AbstractChunk;
+
+        /*
+         * Downloads chunks through IAsyncConnections on a few epoll event
+         * loops instead of one thread per chunk. All chunks read from one
+         * socket are served by the same loop, in the order they were added;
+         * a chunk that is not at the head of its connection just gets
+         * READ_WOULD_BLOCK until the ones before it are complete.
+         */
+        class AsyncConnectionManager
+        {
+            public:
+                AsyncConnectionManager          (size_t loopCount);
+                virtual ~AsyncConnectionManager ();
+
+                static AsyncConnectionManager*  Instance    ();
+
+                /*
+                 * The chunk has to be IN_PROGRESS already, the loop ends the
+                 * download through AbstractChunk::FinishDownload().
+                 */
+                bool    Add     (AbstractChunk *chunk, IAsyncConnection *connection);
+
+            private:
+                struct Download
+                {
+                    AbstractChunk       *chunk;
+                    IAsyncConnection    *connection;
+                };
+                struct Loop
+                {
+                    int                                     epoll;
+                    int                                     wakeUp;     /* eventfd for Add() and shutdown */
+                    THREAD_HANDLE                           thread;
+                    CRITICAL_SECTION                        lock;
+                    CONDITION_VARIABLE                      stopped;
+                    bool                                    isRunning;
+                    bool                                    isStopped;
+                    std::vector<Download>                   added;      /* guarded by lock */
+                    std::map<int, std::vector<Download> >   sockets;    /* owned by the loop thread */
+                };
+
+                std::vector<Loop *> loops;
+
+                static void*    Run     (void *loop);
+                static void     Watch   (Loop *loop, const Download &download, std::vector<int> &ready);
+                static void     Serve   (Loop *loop, int socket);
+                static void     Sweep   (Loop *loop);
+        };
+    }
+}
+
+#endif /* __linux__ */
+
+#endif /* ASYNCCONNECTIONMANAGER_H_ */
@@ -0,0 +1,187 @@
+/*
+ * CurlTransferPool.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#include "CurlTransferPool.h"
+#include "AbstractChunk.h"
+
+#include <algorithm>
+
+using namespace dash::network;
+
+CurlTransferPool::CurlTransferPool  () :
+                  isRunning         (true),
+                  isStopped         (false),
+                  isTracing         (false)
+{
+    InitializeCriticalSection   (&this->lock);
+    InitializeConditionVariable (&this->stopped);
+
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    this->multi = curl_multi_init();
+    curl_multi_setopt(this->multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(this->multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long) CURL_MAX_HOST_CONNECTIONS);
+
+    /* the multi handle caches connections, the share handle DNS results and TLS sessions */
+    this->share = curl_share_init();
+    curl_share_setopt(this->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(this->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    this->thread = CreateThreadPortable(Run, this);
+    if(this->thread == NULL)
+        this->isStopped = true;
+}
+CurlTransferPool::~CurlTransferPool ()
+{
+    EnterCriticalSection(&this->lock);
+    this->isRunning = false;
+    curl_multi_wakeup(this->multi);
+
+    while(!this->isStopped)
+        SleepConditionVariableCS(&this->stopped, &this->lock, INFINITE);
+
+    LeaveCriticalSection(&this->lock);
+
+    for(size_t i = 0; i < this->busy.size(); i++)
+    {
+        curl_multi_remove_handle(this->multi, this->busy.at(i));
+        curl_easy_cleanup(this->busy.at(i));
+    }
+    for(size_t i = 0; i < this->idle.size(); i++)
+        curl_easy_cleanup(this->idle.at(i));
+
+    curl_multi_cleanup(this->multi);
+    curl_share_cleanup(this->share);
+    curl_global_cleanup();
+
+    DestroyThreadPortable   (this->thread);
+    DeleteConditionVariable (&this->stopped);
+    DeleteCriticalSection   (&this->lock);
+}
+
+CurlTransferPool*   CurlTransferPool::Instance      ()
+{
+    static CurlTransferPool pool;
+
+    return &pool;
+}
+bool                CurlTransferPool::Add           (AbstractChunk *chunk)
+{
+    EnterCriticalSection(&this->lock);
+
+    bool isAdded = !this->isStopped;
+    if(isAdded)
+        this->added.push_back(chunk);
+
+    LeaveCriticalSection(&this->lock);
+
+    if(isAdded)
+        curl_multi_wakeup(this->multi);
+
+    return isAdded;
+}
+void                CurlTransferPool::SetTracing    (bool enable)
+{
+    EnterCriticalSection(&this->lock);
+    this->isTracing = enable;
+    LeaveCriticalSection(&this->lock);
+}
+void*               CurlTransferPool::Run           (void *data)
+{
+    CurlTransferPool *pool = (CurlTransferPool *) data;
+
+    while(true)
+    {
+        std::vector<AbstractChunk *> added;
+
+        EnterCriticalSection(&pool->lock);
+        bool isRunning = pool->isRunning;
+        bool isTracing = pool->isTracing;
+        added.swap(pool->added);
+        LeaveCriticalSection(&pool->lock);
+
+        if(!isRunning)
+            break;
+
+        for(size_t i = 0; i < added.size(); i++)
+            pool->Start(added.at(i), isTracing);
+
+        int active = 0;
+        curl_multi_perform(pool->multi, &active);
+        pool->Finish();
+
+        curl_multi_poll(pool->multi, NULL, 0, CURL_POLL_TIMEOUT, NULL);
+    }
+
+    EnterCriticalSection(&pool->lock);
+    pool->isStopped = true;
+    WakeAllConditionVariable(&pool->stopped);
+    LeaveCriticalSection(&pool->lock);
+
+    return NULL;
+}
+void                CurlTransferPool::Start         (AbstractChunk *chunk, bool isTracing)
+{
+    CURL *curl = NULL;
+
+    /* a reset handle keeps its DNS cache and session IDs */
+    if(this->idle.size() > 0)
+    {
+        curl = this->idle.back();
+        this->idle.pop_back();
+        curl_easy_reset(curl);
+    }
+    else
+    {
+        curl = curl_easy_init();
+    }
+
+    if(curl == NULL)
+    {
+        chunk->FinishTransfer(CURLE_OUT_OF_MEMORY);
+        return;
+    }
+
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, (void *) chunk);
+    curl_easy_setopt(curl, CURLOPT_SHARE, this->share);
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long) CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(curl, CURLOPT_VERBOSE, isTracing ? 1L : 0L);
+
+    chunk->SetupTransfer(curl);
+
+    if(curl_multi_add_handle(this->multi, curl) != CURLM_OK)
+    {
+        this->idle.push_back(curl);
+        chunk->FinishTransfer(CURLE_FAILED_INIT);
+        return;
+    }
+
+    this->busy.push_back(curl);
+}
+void                CurlTransferPool::Finish        ()
+{
+    CURLMsg *message    = NULL;
+    int     left        = 0;
+
+    while((message = curl_multi_info_read(this->multi, &left)) != NULL)
+    {
+        if(message->msg != CURLMSG_DONE)
+            continue;
+
+        CURL            *curl       = message->easy_handle;
+        CURLcode        response    = message->data.result;
+        AbstractChunk   *chunk      = NULL;
+
+        curl_easy_getinfo(curl, CURLINFO_PRIVATE, (char **) &chunk);
+        curl_multi_remove_handle(this->multi, curl);
+
+        this->busy.erase(std::find(this->busy.begin(), this->busy.end(), curl));
+        this->idle.push_back(curl);
+
+        chunk->FinishTransfer(response);
+    }
+}
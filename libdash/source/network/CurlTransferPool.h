@@ -0,0 +1,70 @@
+/*
+ * CurlTransferPool.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#ifndef CURLTRANSFERPOOL_H_
+#define CURLTRANSFERPOOL_H_
+
+#include "config.h"
+
+#include "../portable/MultiThreading.h"
+#include <curl/curl.h>
+
+#define CURL_POLL_TIMEOUT           100     /* ms curl_multi_poll() waits without being woken */
+#define CURL_MAX_HOST_CONNECTIONS   6       /* per host, HTTP/2 streams share one of them */
+
+namespace dash
+{
+    namespace network
+    {
+        class AbstractChunk;
+
+        /*
+         * Runs all internal chunk downloads on one curl multi handle driven
+         * by a single thread. Connections, DNS results and TLS sessions are
+         * cached across downloads, HTTP/2 requests to the same host are
+         * multiplexed onto one connection and finished easy handles are
+         * reset and reused. curl_global_init() runs once for the process.
+         */
+        class CurlTransferPool
+        {
+            public:
+                CurlTransferPool            ();
+                virtual ~CurlTransferPool   ();
+
+                static CurlTransferPool*    Instance    ();
+
+                /*
+                 * The chunk has to be IN_PROGRESS already, the pool ends the
+                 * download through AbstractChunk::FinishTransfer().
+                 */
+                bool    Add         (AbstractChunk *chunk);
+                /*
+                 * CURLOPT_VERBOSE output on stderr for downloads started
+                 * afterwards, off by default.
+                 */
+                void    SetTracing  (bool enable);
+
+            private:
+                CURLM                           *multi;
+                CURLSH                          *share;
+                THREAD_HANDLE                   thread;
+                CRITICAL_SECTION                lock;
+                CONDITION_VARIABLE              stopped;
+                bool                            isRunning;
+                bool                            isStopped;
+                bool                            isTracing;
+                std::vector<AbstractChunk *>    added;      /* guarded by lock */
+                std::vector<CURL *>             busy;       /* owned by the pool thread */
+                std::vector<CURL *>             idle;
+
+                static void*    Run     (void *pool);
+                void            Start   (AbstractChunk *chunk, bool isTracing);
+                void            Finish  ();
+        };
+    }
+}
+
+#endif /* CURLTRANSFERPOOL_H_ */
@@ -9,6 +9,7 @@
 #else
 
 #include <sys/socket.h>
+#include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netinet/ip.h> /* superset of previous */ 
 #include <netdb.h>
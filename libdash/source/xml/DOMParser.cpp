@@ -22,7 +22,6 @@ DOMParser::DOMParser    (std::string url) :
 }
 DOMParser::~DOMParser   ()
 {
-    xmlCleanupParser();
     delete(this->root);
 }
 
@@ -105,8 +104,7 @@ Node*   DOMParser::ProcessNode              ()
            Node *node = new Node();
            node->SetType(type);
            node->SetText(text);
-           std::cout << "   " << text << std::endl;
-           delete text;
+           xmlFree((xmlChar *) text);
            return node;
        }
     }
@@ -114,8 +112,6 @@ Node*   DOMParser::ProcessNode              ()
 }
 void    DOMParser::AddAttributesToNode      (Node *node)
 {
-    std::stringstream ss; // Parsed values
-    ss << node->GetName() << ":" << std::endl;
     if(xmlTextReaderHasAttributes(this->reader))
     {
         while(xmlTextReaderMoveToNextAttribute(this->reader))
@@ -123,10 +119,8 @@ void    DOMParser::AddAttributesToNode      (Node *node)
             std::string key      = (const char *) xmlTextReaderConstName(this->reader);
             std::string value    = (const char *) xmlTextReaderConstValue(this->reader);
             node->AddAttribute(key, value);
-            ss << "   " << key << "=" << value << std::endl;
         }
     }
-    std::cout << ss.str();
 }
 void    DOMParser::Print                    (Node *node, int offset)
 {
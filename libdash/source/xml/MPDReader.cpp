@@ -0,0 +1,2123 @@
+/*
+ * MPDReader.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#include "MPDReader.h"
+#include <cstdlib>
+
+using namespace dash::xml;
+using namespace dash::mpd;
+using namespace dash::helpers;
+
+bool MPDReader::children[MPDReader::ElementCount][MPDReader::ElementCount];
+
+static inline unsigned long ToULong     (const std::string *value)
+{
+    return strtoul(value->c_str(), NULL, 10);
+}
+static inline long          ToLong      (const std::string *value)
+{
+    return strtol(value->c_str(), NULL, 10);
+}
+static inline double        ToDouble    (const std::string *value)
+{
+    return strtod(value->c_str(), NULL);
+}
+
+MPDReader::MPDReader    () :
+           reader       (NULL),
+           root         (NULL),
+           depth        (0)
+{
+    static bool initialized = (InitChildren(), true);
+    (void) initialized;
+}
+MPDReader::~MPDReader   ()
+{
+    if(this->reader)
+        xmlFreeTextReader(this->reader);
+}
+
+MPD*                MPDReader::Read             (const std::string &url)
+{
+    if(this->reader == NULL)
+        this->reader = xmlReaderForFile(url.c_str(), NULL, 0);
+    else if(xmlReaderNewFile(this->reader, url.c_str(), NULL, 0) != 0)
+        return NULL;
+
+    return this->Parse(url);
+}
+MPD*                MPDReader::Read             (const uint8_t *data, size_t len, const std::string &baseUrl)
+{
+    if(!this->Reset(data, len, baseUrl))
+        return NULL;
+
+    return this->Parse(baseUrl);
+}
+bool                MPDReader::Patch            (MPD *mpd, const uint8_t *data, size_t len)
+{
+    if(mpd == NULL || !this->Reset(data, len, ""))
+        return false;
+
+    if(this->elements.empty())
+        this->InitNames();
+
+    this->mpdPath = mpd->GetMPDPathBaseUrl() ? mpd->GetMPDPathBaseUrl()->GetUrl() : "";
+
+    bool isPatched = this->ProcessPatch(mpd);
+
+    xmlTextReaderClose(this->reader);
+
+    return isPatched;
+}
+bool                MPDReader::Reset            (const uint8_t *data, size_t len, const std::string &url)
+{
+    if(data == NULL || len == 0)
+        return false;
+
+    if(this->reader == NULL)
+        this->reader = xmlReaderForMemory((const char *) data, (int) len, url.c_str(), NULL, 0);
+    else if(xmlReaderNewMemory(this->reader, (const char *) data, (int) len, url.c_str(), NULL, 0) != 0)
+        return false;
+
+    return this->reader != NULL;
+}
+MPD*                MPDReader::Parse            (const std::string &url)
+{
+    if(this->reader == NULL)
+        return NULL;
+
+    /* names are interned once per reader, the dictionary survives resets */
+    if(this->elements.empty())
+        this->InitNames();
+
+    this->mpdPath = Path::GetDirectoryPath(url);
+
+    MPD *mpd = this->Process();
+
+    /* releases the input, the caller's buffer is not referenced afterwards */
+    xmlTextReaderClose(this->reader);
+
+    return mpd;
+}
+MPD*                MPDReader::Process          ()
+{
+    this->root  = NULL;
+    this->depth = 0;
+
+    while(xmlTextReaderRead(this->reader) == 1)
+    {
+        switch(xmlTextReaderNodeType(this->reader))
+        {
+            case XML_READER_TYPE_ELEMENT:
+            {
+                bool isEmpty = xmlTextReaderIsEmptyElement(this->reader) == 1;
+
+                this->StartElement();
+                if(isEmpty)
+                    this->EndElement();
+                break;
+            }
+            case XML_READER_TYPE_END_ELEMENT:
+                if(this->depth > 0)
+                    this->EndElement();
+                break;
+            case XML_READER_TYPE_TEXT:
+            case XML_READER_TYPE_CDATA:
+                this->AddText();
+                break;
+            default:
+                break;
+        }
+    }
+
+    /* truncated or malformed document: keep what was read, as the DOM parser did */
+    while(this->depth > 0)
+        this->EndElement();
+
+    return this->root;
+}
+bool                MPDReader::ProcessPatch     (MPD *mpd)
+{
+    int ret = xmlTextReaderRead(this->reader);
+    while(ret == 1 && xmlTextReaderNodeType(this->reader) != XML_READER_TYPE_ELEMENT)
+        ret = xmlTextReaderRead(this->reader);
+
+    if(ret != 1 || this->CurrentName() != this->Intern("Patch"))
+        return false;
+
+    /* a patch only applies to the MPD version it was made for */
+    std::string publishTime = this->ReadAttribute("publishTime");
+    if(this->ReadAttribute("mpdId") != mpd->GetId() || this->ReadAttribute("originalPublishTime") != mpd->GetPublishTime())
+        return false;
+
+    if(xmlTextReaderIsEmptyElement(this->reader) == 1)
+        ret = 0;
+    else
+        ret = xmlTextReaderRead(this->reader);
+
+    while(ret == 1)
+    {
+        int type = xmlTextReaderNodeType(this->reader);
+
+        if(type == XML_READER_TYPE_END_ELEMENT)
+            break;
+
+        if(type != XML_READER_TYPE_ELEMENT)
+        {
+            ret = xmlTextReaderRead(this->reader);
+            continue;
+        }
+
+        const xmlChar   *operation      = this->CurrentName();
+        bool            isEmpty         = xmlTextReaderIsEmptyElement(this->reader) == 1;
+        std::string     path            = this->ReadAttribute("sel");
+        std::string     position        = this->ReadAttribute("pos");
+        std::string     attributeType   = this->ReadAttribute("type");
+        std::string     attribute;
+        Frame           parent;
+        Frame           target;
+
+        if(!this->Select(mpd, path, parent, target, attribute))
+            return false;
+
+        if(operation == this->Intern("add"))
+        {
+            if(attribute != "" || position != "")
+                return false;
+
+            if(attributeType != "")
+            {
+                if(attributeType.at(0) != '@')
+                    return false;
+
+                std::string value = this->ReadText();
+                this->SetAttribute(parent, target, attributeType.substr(1), value);
+                ret = xmlTextReaderNext(this->reader);
+                continue;
+            }
+
+            if(!isEmpty && !this->ProcessFragment(target))
+                return false;
+        }
+        else if(operation == this->Intern("replace"))
+        {
+            if(attribute == "")
+                return false;
+
+            std::string value = this->ReadText();
+            this->SetAttribute(parent, target, attribute, value);
+            ret = xmlTextReaderNext(this->reader);
+            continue;
+        }
+        else if(operation == this->Intern("remove"))
+        {
+            if(attribute != "" || !this->Remove(parent, target))
+                return false;
+
+            ret = xmlTextReaderNext(this->reader);
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+
+        ret = xmlTextReaderRead(this->reader);
+    }
+
+    if(ret == -1)
+        return false;
+
+    if(publishTime != "")
+    {
+        Frame root;
+        root.element = ElementMPD;
+        root.object  = mpd;
+        this->Bind(root);
+        this->SetAttribute(Frame(), root, "publishTime", publishTime);
+    }
+
+    return true;
+}
+bool                MPDReader::ProcessFragment  (const Frame &target)
+{
+    if(this->frames.empty())
+        this->frames.resize(1);
+
+    /* the target is the parent of the fragment's top level elements, it is never finished */
+    this->frames[0]             = target;
+    this->frames[0].node        = NULL;
+    this->frames[0].hasText     = false;
+    this->frames[0].attributes.clear();
+    this->frames[0].text.clear();
+    this->depth                 = 1;
+
+    while(xmlTextReaderRead(this->reader) == 1)
+    {
+        switch(xmlTextReaderNodeType(this->reader))
+        {
+            case XML_READER_TYPE_ELEMENT:
+            {
+                bool isEmpty = xmlTextReaderIsEmptyElement(this->reader) == 1;
+
+                this->StartElement();
+                if(isEmpty)
+                    this->EndElement();
+                break;
+            }
+            case XML_READER_TYPE_END_ELEMENT:
+                if(this->depth == 1)
+                    return true;
+
+                this->EndElement();
+                break;
+            case XML_READER_TYPE_TEXT:
+            case XML_READER_TYPE_CDATA:
+                if(this->depth > 1)
+                    this->AddText();
+                break;
+            default:
+                break;
+        }
+    }
+
+    while(this->depth > 1)
+        this->EndElement();
+
+    return false;
+}
+void                MPDReader::StartElement     ()
+{
+    if(this->frames.size() <= this->depth)
+        this->frames.resize(this->depth + 1);
+
+    const xmlChar   *name   = this->CurrentName();
+    Frame           &frame  = this->frames[this->depth];
+
+    /* the root is read as MPD whatever its name */
+    frame.element               = this->depth == 0 ? ElementMPD : this->Lookup(this->frames[this->depth - 1].element, name);
+    frame.object                = NULL;
+    frame.base                  = NULL;
+    frame.representationBase    = NULL;
+    frame.segmentBase           = NULL;
+    frame.multipleSegmentBase   = NULL;
+    frame.node                  = NULL;
+    frame.hasText               = false;
+    frame.text.clear();
+    frame.attributes.clear();
+
+    while(xmlTextReaderMoveToNextAttribute(this->reader) == 1)
+    {
+        frame.attributes.push_back(Attribute());
+        frame.attributes.back().name = this->CurrentName();
+        frame.attributes.back().value.assign((const char *) xmlTextReaderConstValue(this->reader));
+    }
+    xmlTextReaderMoveToElement(this->reader);
+
+    if(frame.element == ElementUnknown)
+    {
+        frame.node = new Node();
+        frame.node->SetType(XML_READER_TYPE_ELEMENT);
+        frame.node->SetName((const char *) name);
+        frame.node->SetMPDPath(this->mpdPath);
+
+        for(size_t i = 0; i < frame.attributes.size(); i++)
+            frame.node->AddAttribute((const char *) frame.attributes[i].name, frame.attributes[i].value);
+    }
+    else
+    {
+        this->Create(frame);
+    }
+
+    this->depth++;
+}
+void                MPDReader::EndElement       ()
+{
+    this->depth--;
+
+    Frame &frame = this->frames[this->depth];
+
+    if(frame.node == NULL)
+        this->Finish(frame);
+
+    if(this->depth == 0)
+    {
+        if(frame.node)
+            delete frame.node;
+        else
+            this->root = (MPD *) frame.object;
+        return;
+    }
+
+    Frame &parent = this->frames[this->depth - 1];
+
+    if(frame.node)
+    {
+        if(parent.node)
+            parent.node->AddSubNode(frame.node);
+        else if(parent.base)
+            parent.base->AddAdditionalSubNode((INode *) frame.node);
+        else
+            delete frame.node;
+
+        frame.node = NULL;
+        return;
+    }
+
+    this->Attach(parent, frame);
+}
+void                MPDReader::AddText          ()
+{
+    if(this->depth == 0)
+        return;
+
+    Frame       &frame  = this->frames[this->depth - 1];
+    const char  *value  = (const char *) xmlTextReaderConstValue(this->reader);
+
+    if(value == NULL)
+        return;
+
+    if(frame.node)
+    {
+        Node *text = new Node();
+        text->SetType(XML_READER_TYPE_TEXT);
+        text->SetText(value);
+        frame.node->AddSubNode(text);
+    }
+    else if(!frame.hasText)
+    {
+        frame.text.assign(value);
+        frame.hasText = true;
+    }
+}
+void                MPDReader::Create           (Frame &frame)
+{
+    switch(frame.element)
+    {
+        case ElementMPD:
+            frame.object = new MPD();
+            break;
+        case ElementProgramInformation:
+            frame.object = new ProgramInformation();
+            break;
+        case ElementTitle:
+        case ElementSource:
+        case ElementCopyright:
+        case ElementLocation:
+            /* text only */
+            break;
+        case ElementBaseURL:
+            frame.object = new BaseUrl();
+            break;
+        case ElementPatchLocation:
+            frame.object = new PatchLocation();
+            break;
+        case ElementServiceDescription:
+            frame.object = new ServiceDescription();
+            break;
+        case ElementScope:
+        case ElementReporting:
+        case ElementEssentialProperty:
+        case ElementSupplementalProperty:
+        case ElementUTCTiming:
+        case ElementAssetIdentifier:
+        case ElementAccessibility:
+        case ElementRole:
+        case ElementRating:
+        case ElementViewpoint:
+        case ElementFramePacking:
+        case ElementAudioChannelConfiguration:
+        case ElementOutputProtection:
+            frame.object = new Descriptor();
+            break;
+        case ElementContentProtection:
+            frame.object = new ContentProtection();
+            break;
+        case ElementLatency:
+            frame.object = new Latency();
+            break;
+        case ElementQualityLatency:
+            frame.object = new UIntPairsWithID();
+            break;
+        case ElementPlaybackRate:
+            frame.object = new PlaybackRate();
+            break;
+        case ElementOperatingQuality:
+            frame.object = new OperatingQuality();
+            break;
+        case ElementOperatingBandwidth:
+            frame.object = new OperatingBandwidth();
+            break;
+        case ElementInitializationSet:
+            frame.object = new InitializationSet();
+            break;
+        case ElementInitializationGroup:
+        case ElementInitializationPresentation:
+            frame.object = new UIntVWithID();
+            break;
+        case ElementPeriod:
+            frame.object = new Period();
+            break;
+        case ElementMetrics:
+            frame.object = new Metrics();
+            break;
+        case ElementRange:
+            frame.object = new Range();
+            break;
+        case ElementLeapSecondInformation:
+            frame.object = new LeapSecondInformation();
+            break;
+        case ElementAdaptationSet:
+            frame.object = new AdaptationSet();
+            break;
+        case ElementSubset:
+            frame.object = new Subset();
+            break;
+        case ElementGroupLabel:
+        case ElementLabel:
+            frame.object = new Label();
+            break;
+        case ElementPreselection:
+            frame.object = new Preselection();
+            break;
+        case ElementEventStream:
+        case ElementInbandEventStream:
+            frame.object = new EventStream();
+            break;
+        case ElementEvent:
+            frame.object = new Event();
+            break;
+        case ElementSegmentBase:
+            frame.object = new SegmentBase();
+            break;
+        case ElementSegmentList:
+            frame.object = new SegmentList();
+            break;
+        case ElementSegmentTemplate:
+            frame.object = new SegmentTemplate();
+            break;
+        case ElementSegmentTimeline:
+            frame.object = new SegmentTimeline();
+            break;
+        case ElementS:
+            frame.object = new Timeline();
+            break;
+        case ElementSegmentURL:
+            frame.object = new SegmentURL();
+            break;
+        case ElementInitialization:
+        case ElementRepresentationIndex:
+        case ElementBitstreamSwitching:
+            frame.object = new URLType();
+            break;
+        case ElementFailoverContent:
+            frame.object = new FailoverContent();
+            break;
+        case ElementFCS:
+            frame.object = new FCS();
+            break;
+        case ElementRepresentation:
+            frame.object = new Representation();
+            break;
+        case ElementSubRepresentation:
+            frame.object = new SubRepresentation();
+            break;
+        case ElementExtendedBandwidth:
+            frame.object = new ExtendedBandwidth();
+            break;
+        case ElementModelPair:
+            frame.object = new ModelPair();
+            break;
+        case ElementContentComponent:
+            frame.object = new ContentComponent();
+            break;
+        case ElementSwitching:
+            frame.object = new Switching();
+            break;
+        case ElementRandomAccess:
+            frame.object = new RandomAccess();
+            break;
+        case ElementContentPopularityRate:
+            frame.object = new ContentPopularityRate();
+            break;
+        case ElementPR:
+            frame.object = new PopularityRate();
+            break;
+        case ElementProducerReferenceTime:
+            frame.object = new ProducerReferenceTime();
+            break;
+        case ElementResync:
+            frame.object = new Resync();
+            break;
+        default:
+            break;
+    }
+
+    if(frame.object == NULL)
+        return;
+
+    this->Bind(frame);
+    this->Apply(frame);
+}
+void                MPDReader::Bind             (Frame &frame)
+{
+    frame.base                  = NULL;
+    frame.representationBase    = NULL;
+    frame.segmentBase           = NULL;
+    frame.multipleSegmentBase   = NULL;
+
+    switch(frame.element)
+    {
+        case ElementMPD:
+            frame.base = (MPD *) frame.object;
+            break;
+        case ElementProgramInformation:
+            frame.base = (ProgramInformation *) frame.object;
+            break;
+        case ElementBaseURL:
+            frame.base = (BaseUrl *) frame.object;
+            break;
+        case ElementPatchLocation:
+            frame.base = (PatchLocation *) frame.object;
+            break;
+        case ElementServiceDescription:
+            frame.base = (ServiceDescription *) frame.object;
+            break;
+        case ElementScope:
+        case ElementReporting:
+        case ElementEssentialProperty:
+        case ElementSupplementalProperty:
+        case ElementUTCTiming:
+        case ElementAssetIdentifier:
+        case ElementAccessibility:
+        case ElementRole:
+        case ElementRating:
+        case ElementViewpoint:
+        case ElementFramePacking:
+        case ElementAudioChannelConfiguration:
+        case ElementOutputProtection:
+            frame.base = (Descriptor *) frame.object;
+            break;
+        case ElementContentProtection:
+            frame.base = (ContentProtection *) frame.object;
+            break;
+        case ElementLatency:
+            frame.base = (Latency *) frame.object;
+            break;
+        case ElementQualityLatency:
+            frame.base = (UIntPairsWithID *) frame.object;
+            break;
+        case ElementPlaybackRate:
+            frame.base = (PlaybackRate *) frame.object;
+            break;
+        case ElementOperatingQuality:
+            frame.base = (OperatingQuality *) frame.object;
+            break;
+        case ElementOperatingBandwidth:
+            frame.base = (OperatingBandwidth *) frame.object;
+            break;
+        case ElementInitializationSet:
+        {
+            InitializationSet *initializationSet = (InitializationSet *) frame.object;
+
+            frame.base               = initializationSet;
+            frame.representationBase = initializationSet;
+            break;
+        }
+        case ElementInitializationGroup:
+        case ElementInitializationPresentation:
+            frame.base = (UIntVWithID *) frame.object;
+            break;
+        case ElementPeriod:
+            frame.base = (Period *) frame.object;
+            break;
+        case ElementMetrics:
+            frame.base = (Metrics *) frame.object;
+            break;
+        case ElementLeapSecondInformation:
+            frame.base = (LeapSecondInformation *) frame.object;
+            break;
+        case ElementAdaptationSet:
+        {
+            AdaptationSet *adaptationSet = (AdaptationSet *) frame.object;
+
+            frame.base               = adaptationSet;
+            frame.representationBase = adaptationSet;
+            break;
+        }
+        case ElementSubset:
+            frame.base = (Subset *) frame.object;
+            break;
+        case ElementGroupLabel:
+        case ElementLabel:
+            frame.base = (Label *) frame.object;
+            break;
+        case ElementPreselection:
+        {
+            Preselection *preselection = (Preselection *) frame.object;
+
+            frame.base               = preselection;
+            frame.representationBase = preselection;
+            break;
+        }
+        case ElementEventStream:
+        case ElementInbandEventStream:
+            frame.base = (EventStream *) frame.object;
+            break;
+        case ElementEvent:
+            frame.base = (Event *) frame.object;
+            break;
+        case ElementSegmentBase:
+        {
+            SegmentBase *segmentBase = (SegmentBase *) frame.object;
+
+            frame.base        = segmentBase;
+            frame.segmentBase = segmentBase;
+            break;
+        }
+        case ElementSegmentList:
+        {
+            SegmentList *segmentList = (SegmentList *) frame.object;
+
+            frame.base                = segmentList;
+            frame.segmentBase         = segmentList;
+            frame.multipleSegmentBase = segmentList;
+            break;
+        }
+        case ElementSegmentTemplate:
+        {
+            SegmentTemplate *segmentTemplate = (SegmentTemplate *) frame.object;
+
+            frame.base                = segmentTemplate;
+            frame.segmentBase         = segmentTemplate;
+            frame.multipleSegmentBase = segmentTemplate;
+            break;
+        }
+        case ElementSegmentTimeline:
+            frame.base = (SegmentTimeline *) frame.object;
+            break;
+        case ElementS:
+            frame.base = (Timeline *) frame.object;
+            break;
+        case ElementSegmentURL:
+            frame.base = (SegmentURL *) frame.object;
+            break;
+        case ElementInitialization:
+        case ElementRepresentationIndex:
+        case ElementBitstreamSwitching:
+            frame.base = (URLType *) frame.object;
+            break;
+        case ElementFailoverContent:
+            frame.base = (FailoverContent *) frame.object;
+            break;
+        case ElementFCS:
+            frame.base = (FCS *) frame.object;
+            break;
+        case ElementRepresentation:
+        {
+            Representation *representation = (Representation *) frame.object;
+
+            frame.base               = representation;
+            frame.representationBase = representation;
+            break;
+        }
+        case ElementSubRepresentation:
+        {
+            SubRepresentation *subRepresentation = (SubRepresentation *) frame.object;
+
+            frame.base               = subRepresentation;
+            frame.representationBase = subRepresentation;
+            break;
+        }
+        case ElementExtendedBandwidth:
+            frame.base = (ExtendedBandwidth *) frame.object;
+            break;
+        case ElementModelPair:
+            frame.base = (ModelPair *) frame.object;
+            break;
+        case ElementContentComponent:
+            frame.base = (ContentComponent *) frame.object;
+            break;
+        case ElementSwitching:
+            frame.base = (Switching *) frame.object;
+            break;
+        case ElementRandomAccess:
+            frame.base = (RandomAccess *) frame.object;
+            break;
+        case ElementContentPopularityRate:
+            frame.base = (ContentPopularityRate *) frame.object;
+            break;
+        case ElementPR:
+            frame.base = (PopularityRate *) frame.object;
+            break;
+        case ElementProducerReferenceTime:
+            frame.base = (ProducerReferenceTime *) frame.object;
+            break;
+        case ElementResync:
+            frame.base = (Resync *) frame.object;
+            break;
+        default:
+            break;
+    }
+}
+void                MPDReader::Apply            (Frame &frame)
+{
+    const std::string *value = NULL;
+
+    switch(frame.element)
+    {
+        case ElementMPD:
+        {
+            MPD *mpd = (MPD *) frame.object;
+
+            if((value = this->Find(frame, "id")))                           mpd->SetId(*value);
+            if((value = this->Find(frame, "profiles")))                     mpd->SetProfiles(*value);
+            if((value = this->Find(frame, "type")))                         mpd->SetType(*value);
+            if((value = this->Find(frame, "availabilityStartTime")))        mpd->SetAvailabilityStarttime(*value);
+            if((value = this->Find(frame, "availabilityEndTime")))          mpd->SetAvailabilityEndtime(*value);
+            if((value = this->Find(frame, "publishTime")))                  mpd->SetPublishTime(*value);
+            if((value = this->Find(frame, "mediaPresentationDuration")))    mpd->SetMediaPresentationDuration(*value);
+            if((value = this->Find(frame, "minimumUpdatePeriod")))          mpd->SetMinimumUpdatePeriod(*value);
+            if((value = this->Find(frame, "minBufferTime")))                mpd->SetMinBufferTime(*value);
+            if((value = this->Find(frame, "timeShiftBufferDepth")))         mpd->SetTimeShiftBufferDepth(*value);
+            if((value = this->Find(frame, "suggestedPresentationDelay")))   mpd->SetSuggestedPresentationDelay(*value);
+            if((value = this->Find(frame, "maxSegmentDuration")))           mpd->SetMaxSegmentDuration(*value);
+            if((value = this->Find(frame, "maxSubsegmentDuration")))        mpd->SetMaxSubsegmentDuration(*value);
+            break;
+        }
+        case ElementProgramInformation:
+        {
+            ProgramInformation *programInformation = (ProgramInformation *) frame.object;
+
+            if((value = this->Find(frame, "lang")))                 programInformation->SetLang(*value);
+            if((value = this->Find(frame, "moreInformationURL")))   programInformation->SetMoreInformationURL(*value);
+            break;
+        }
+        case ElementBaseURL:
+        {
+            BaseUrl *baseUrl = (BaseUrl *) frame.object;
+
+            if((value = this->Find(frame, "serviceLocation")))          baseUrl->SetServiceLocation(*value);
+            if((value = this->Find(frame, "byteRange")))                baseUrl->SetByteRange(*value);
+            if((value = this->Find(frame, "availabilityTimeOffset")))   baseUrl->SetAvailabilityTimeOffset(ToDouble(value));
+            if((value = this->Find(frame, "availabilityTimeComplete"))) baseUrl->SetAvailabilityTimeComplete(String::ToBool(*value));
+            if((value = this->Find(frame, "timeShiftBufferDepth")))     baseUrl->SetTimeShiftBufferDepth(*value);
+            if((value = this->Find(frame, "rangeAccess")))              baseUrl->SetRangeAccess(String::ToBool(*value));
+            break;
+        }
+        case ElementPatchLocation:
+        {
+            PatchLocation *patchLocation = (PatchLocation *) frame.object;
+
+            if((value = this->Find(frame, "ttl")))  patchLocation->SetTtl(ToDouble(value));
+            break;
+        }
+        case ElementServiceDescription:
+        {
+            ServiceDescription *serviceDescription = (ServiceDescription *) frame.object;
+
+            if((value = this->Find(frame, "id")))   serviceDescription->SetId(ToULong(value));
+            break;
+        }
+        case ElementScope:
+        case ElementReporting:
+        case ElementEssentialProperty:
+        case ElementSupplementalProperty:
+        case ElementUTCTiming:
+        case ElementAssetIdentifier:
+        case ElementAccessibility:
+        case ElementRole:
+        case ElementRating:
+        case ElementViewpoint:
+        case ElementFramePacking:
+        case ElementAudioChannelConfiguration:
+        case ElementOutputProtection:
+        {
+            Descriptor *descriptor = (Descriptor *) frame.object;
+
+            this->SetCommonValuesForDesc(frame, *descriptor);
+            break;
+        }
+        case ElementContentProtection:
+        {
+            ContentProtection *contentProtection = (ContentProtection *) frame.object;
+
+            this->SetCommonValuesForDesc(frame, *contentProtection);
+
+            if((value = this->Find(frame, "robustness")))   contentProtection->SetRobustness(*value);
+            if((value = this->Find(frame, "refId")))        contentProtection->SetRefId(*value);
+            if((value = this->Find(frame, "ref")))          contentProtection->SetRef(*value);
+            break;
+        }
+        case ElementLatency:
+        {
+            Latency *latency = (Latency *) frame.object;
+
+            if((value = this->Find(frame, "referenceId")))  latency->SetReferenceId(ToULong(value));
+            if((value = this->Find(frame, "target")))       latency->SetTarget(ToULong(value));
+            if((value = this->Find(frame, "max")))          latency->SetMax(ToULong(value));
+            if((value = this->Find(frame, "min")))          latency->SetMin(ToULong(value));
+            break;
+        }
+        case ElementQualityLatency:
+        {
+            UIntPairsWithID *uIntPairsWithID = (UIntPairsWithID *) frame.object;
+
+            if((value = this->Find(frame, "type")))         uIntPairsWithID->SetType(*value);
+            break;
+        }
+        case ElementPlaybackRate:
+        {
+            PlaybackRate *playbackRate = (PlaybackRate *) frame.object;
+
+            if((value = this->Find(frame, "max")))          playbackRate->SetMax(ToDouble(value));
+            if((value = this->Find(frame, "min")))          playbackRate->SetMin(ToDouble(value));
+            break;
+        }
+        case ElementOperatingQuality:
+        {
+            OperatingQuality *operatingQuality = (OperatingQuality *) frame.object;
+
+            if((value = this->Find(frame, "mediaType")))        operatingQuality->SetMediaType(*value);
+            if((value = this->Find(frame, "target")))           operatingQuality->SetTarget(ToULong(value));
+            if((value = this->Find(frame, "max")))              operatingQuality->SetMax(ToULong(value));
+            if((value = this->Find(frame, "min")))              operatingQuality->SetMin(ToULong(value));
+            if((value = this->Find(frame, "type")))             operatingQuality->SetType(*value);
+            if((value = this->Find(frame, "maxDifference")))    operatingQuality->SetMaxDifference(ToULong(value));
+            break;
+        }
+        case ElementOperatingBandwidth:
+        {
+            OperatingBandwidth *operatingBandwidth = (OperatingBandwidth *) frame.object;
+
+            if((value = this->Find(frame, "mediaType")))    operatingBandwidth->SetMediaType(*value);
+            if((value = this->Find(frame, "target")))       operatingBandwidth->SetTarget(ToULong(value));
+            if((value = this->Find(frame, "max")))          operatingBandwidth->SetMax(ToULong(value));
+            if((value = this->Find(frame, "min")))          operatingBandwidth->SetMin(ToULong(value));
+            break;
+        }
+        case ElementInitializationSet:
+        {
+            InitializationSet *initializationSet = (InitializationSet *) frame.object;
+
+            this->SetCommonValuesForRep(frame, *initializationSet);
+
+            if((value = this->Find(frame, "xlink:href")))       initializationSet->SetXlinkHref(*value);
+            if((value = this->Find(frame, "xlink:actuate")))    initializationSet->SetXlinkActuate(*value);
+            if((value = this->Find(frame, "xlink:type")))       initializationSet->SetXlinkType(*value);
+            if((value = this->Find(frame, "id")))               initializationSet->SetId(ToULong(value));
+            if((value = this->Find(frame, "inAllPeriods")))     initializationSet->SetInAllPeriods(String::ToBool(*value));
+            if((value = this->Find(frame, "contentType")))      initializationSet->SetContentType(*value);
+            if((value = this->Find(frame, "par")))              initializationSet->SetPar(*value);
+            if((value = this->Find(frame, "maxWidth")))         initializationSet->SetMaxWidth(ToULong(value));
+            if((value = this->Find(frame, "maxHeight")))        initializationSet->SetMaxHeight(ToULong(value));
+            if((value = this->Find(frame, "maxFrameRate")))     initializationSet->SetMaxFrameRate(*value);
+            if((value = this->Find(frame, "initialization")))   initializationSet->SetInitialization(*value);
+            break;
+        }
+        case ElementInitializationGroup:
+        case ElementInitializationPresentation:
+        {
+            UIntVWithID *uIntVWithID = (UIntVWithID *) frame.object;
+
+            if((value = this->Find(frame, "id")))           uIntVWithID->SetId(ToULong(value));
+            if((value = this->Find(frame, "profiles")))     uIntVWithID->SetProfiles(*value);
+            if((value = this->Find(frame, "contentType")))  uIntVWithID->SetContentType(*value);
+            break;
+        }
+        case ElementPeriod:
+        {
+            Period *period = (Period *) frame.object;
+
+            if((value = this->Find(frame, "xlink:href")))           period->SetXlinkHref(*value);
+            if((value = this->Find(frame, "xlink:actuate")))        period->SetXlinkActuate(*value);
+            if((value = this->Find(frame, "xlink:type")))           period->SetXlinkType(*value);
+            if((value = this->Find(frame, "xlink:show")))           period->SetXlinkShow(*value);
+            if((value = this->Find(frame, "id")))                   period->SetId(*value);
+            if((value = this->Find(frame, "start")))                period->SetStart(*value);
+            if((value = this->Find(frame, "duration")))             period->SetDuration(*value);
+            if((value = this->Find(frame, "bitstreamSwitching")))   period->SetBitstreamSwitching(String::ToBool(*value));
+            break;
+        }
+        case ElementMetrics:
+        {
+            Metrics *metrics = (Metrics *) frame.object;
+
+            if((value = this->Find(frame, "metrics")))  metrics->SetMetrics(*value);
+            break;
+        }
+        case ElementRange:
+        {
+            Range *range = (Range *) frame.object;
+
+            if((value = this->Find(frame, "starttime")))    range->SetStarttime(*value);
+            if((value = this->Find(frame, "duration")))     range->SetDuration(*value);
+            break;
+        }
+        case ElementLeapSecondInformation:
+        {
+            LeapSecondInformation *leapSecondInformation = (LeapSecondInformation *) frame.object;
+
+            if((value = this->Find(frame, "availabilityStartLeapOffset")))      leapSecondInformation->SetAvailabilityStartLeapOffset(ToLong(value));
+            if((value = this->Find(frame, "nextAvailabilityStartLeapOffset")))  leapSecondInformation->SetNextAvailabilityStartLeapOffset(ToLong(value));
+            if((value = this->Find(frame, "nextLeapChangeTime")))               leapSecondInformation->SetNextLeapChangeTime(*value);
+            break;
+        }
+        case ElementAdaptationSet:
+        {
+            AdaptationSet *adaptationSet = (AdaptationSet *) frame.object;
+
+            this->SetCommonValuesForRep(frame, *adaptationSet);
+
+            if((value = this->Find(frame, "xlink:href")))               adaptationSet->SetXlinkHref(*value);
+            if((value = this->Find(frame, "xlink:actuate")))            adaptationSet->SetXlinkActuate(*value);
+            if((value = this->Find(frame, "xlink:type")))               adaptationSet->SetXlinkType(*value);
+            if((value = this->Find(frame, "xlink:show")))               adaptationSet->SetXlinkShow(*value);
+            if((value = this->Find(frame, "id")))                       adaptationSet->SetId(ToULong(value));
+            if((value = this->Find(frame, "group")))                    adaptationSet->SetGroup(ToULong(value));
+            if((value = this->Find(frame, "lang")))                     adaptationSet->SetLang(*value);
+            if((value = this->Find(frame, "contentType")))              adaptationSet->SetContentType(*value);
+            if((value = this->Find(frame, "par")))                      adaptationSet->SetPar(*value);
+            if((value = this->Find(frame, "minBandwidth")))             adaptationSet->SetMinBandwidth(ToULong(value));
+            if((value = this->Find(frame, "maxBandwidth")))             adaptationSet->SetMaxBandwidth(ToULong(value));
+            if((value = this->Find(frame, "minWidth")))                 adaptationSet->SetMinWidth(ToULong(value));
+            if((value = this->Find(frame, "maxWidth")))                 adaptationSet->SetMaxWidth(ToULong(value));
+            if((value = this->Find(frame, "minHeight")))                adaptationSet->SetMinHeight(ToULong(value));
+            if((value = this->Find(frame, "maxHeight")))                adaptationSet->SetMaxHeight(ToULong(value));
+            if((value = this->Find(frame, "minFrameRate")))             adaptationSet->SetMinFramerate(*value);
+            if((value = this->Find(frame, "maxFrameRate")))             adaptationSet->SetMaxFramerate(*value);
+            if((value = this->Find(frame, "segmentAlignment")))         adaptationSet->SetSegmentAlignment(String::ToBool(*value));
+            if((value = this->Find(frame, "subsegmentAlignment")))      adaptationSet->SetSubsegmentAlignment(String::ToBool(*value));
+            if((value = this->Find(frame, "subsegmentStartsWithSAP")))  adaptationSet->SetSubsegmentStartsWithSAP((uint8_t) ToULong(value));
+            if((value = this->Find(frame, "bitstreamSwitching")))       adaptationSet->SetBitstreamSwitching(String::ToBool(*value));
+            if((value = this->Find(frame, "initializationSetRef")))     adaptationSet->SetInitializationSetRef(*value);
+            if((value = this->Find(frame, "initializationPrincipal")))  adaptationSet->SetInitializationPrincipal(*value);
+            break;
+        }
+        case ElementSubset:
+        {
+            Subset *subset = (Subset *) frame.object;
+
+            if((value = this->Find(frame, "contains")))     subset->SetSubset(*value);
+            if((value = this->Find(frame, "id")))           subset->SetId(*value);
+            break;
+        }
+        case ElementGroupLabel:
+        case ElementLabel:
+        {
+            Label *label = (Label *) frame.object;
+
+            if((value = this->Find(frame, "lang")))         label->SetLang(*value);
+            if((value = this->Find(frame, "id")))           label->SetId(ToULong(value));
+            break;
+        }
+        case ElementPreselection:
+        {
+            Preselection *preselection = (Preselection *) frame.object;
+
+            this->SetCommonValuesForRep(frame, *preselection);
+
+            if((value = this->Find(frame, "id")))                       preselection->SetId(*value);
+            if((value = this->Find(frame, "preselectionComponents")))   preselection->SetPreselectionComponents(*value);
+            if((value = this->Find(frame, "lang")))                     preselection->SetLang(*value);
+            if((value = this->Find(frame, "order")))                    preselection->SetOrder(*value);
+            break;
+        }
+        case ElementEventStream:
+        case ElementInbandEventStream:
+        {
+            EventStream *eventStream = (EventStream *) frame.object;
+
+            if((value = this->Find(frame, "xlink:href")))               eventStream->SetXlinkHref(*value);
+            if((value = this->Find(frame, "xlink:actuate")))            eventStream->SetXlinkActuate(*value);
+            if((value = this->Find(frame, "schemeIdUri")))              eventStream->SetSchemeIdUri(*value);
+            if((value = this->Find(frame, "value")))                    eventStream->SetValue(*value);
+            if((value = this->Find(frame, "timescale")))                eventStream->SetTimescale(ToULong(value));
+            if((value = this->Find(frame, "presentationTimeOffset")))   eventStream->SetPresentationTimeOffset(ToULong(value));
+            break;
+        }
+        case ElementEvent:
+        {
+            Event *event = (Event *) frame.object;
+
+            if((value = this->Find(frame, "presentationTime")))     event->SetPresentationTime(ToULong(value));
+            if((value = this->Find(frame, "duration")))             event->SetDuration(*value);
+            if((value = this->Find(frame, "id")))                   event->SetId(ToULong(value));
+            if((value = this->Find(frame, "contentEncoding")))      event->SetContentEncoding(*value);
+            if((value = this->Find(frame, "messageData")))          event->SetMessageData(*value);
+            break;
+        }
+        case ElementSegmentBase:
+        {
+            SegmentBase *segmentBase = (SegmentBase *) frame.object;
+
+            this->SetCommonValuesForSeg(frame, *segmentBase);
+            break;
+        }
+        case ElementSegmentList:
+        {
+            SegmentList *segmentList = (SegmentList *) frame.object;
+
+            this->SetCommonValuesForMSeg(frame, *segmentList);
+
+            if((value = this->Find(frame, "xlink:href")))       segmentList->SetXlinkHref(*value);
+            if((value = this->Find(frame, "xlink:actuate")))    segmentList->SetXlinkActuate(*value);
+            if((value = this->Find(frame, "xlink:type")))       segmentList->SetXlinkType(*value);
+            if((value = this->Find(frame, "xlink:show")))       segmentList->SetXlinkShow(*value);
+            break;
+        }
+        case ElementSegmentTemplate:
+        {
+            SegmentTemplate *segmentTemplate = (SegmentTemplate *) frame.object;
+
+            this->SetCommonValuesForMSeg(frame, *segmentTemplate);
+
+            if((value = this->Find(frame, "media")))                segmentTemplate->SetMedia(*value);
+            if((value = this->Find(frame, "index")))                segmentTemplate->SetIndex(*value);
+            if((value = this->Find(frame, "initialization")))       segmentTemplate->SetInitialization(*value);
+            if((value = this->Find(frame, "bitstreamSwitching")))   segmentTemplate->SetBitstreamSwitching(*value);
+            break;
+        }
+        case ElementS:
+        {
+            Timeline *timeline = (Timeline *) frame.object;
+
+            if((value = this->Find(frame, "t")))    timeline->SetStartTime(ToULong(value));
+            if((value = this->Find(frame, "d")))    timeline->SetDuration(ToULong(value));
+            if((value = this->Find(frame, "r")))    timeline->SetRepeatCount(ToULong(value));
+            break;
+        }
+        case ElementSegmentURL:
+        {
+            SegmentURL *segmentUrl = (SegmentURL *) frame.object;
+
+            if((value = this->Find(frame, "media")))        segmentUrl->SetMediaURI(*value);
+            if((value = this->Find(frame, "mediaRange")))   segmentUrl->SetMediaRange(*value);
+            if((value = this->Find(frame, "index")))        segmentUrl->SetIndexURI(*value);
+            if((value = this->Find(frame, "indexRange")))   segmentUrl->SetIndexRange(*value);
+            break;
+        }
+        case ElementInitialization:
+        case ElementRepresentationIndex:
+        case ElementBitstreamSwitching:
+        {
+            URLType *urlType = (URLType *) frame.object;
+
+            if((value = this->Find(frame, "sourceURL")))    urlType->SetSourceURL(*value);
+            if((value = this->Find(frame, "range")))        urlType->SetRange(*value);
+
+            if(frame.element == ElementInitialization)
+                urlType->SetType(dash::metrics::InitializationSegment);
+            else if(frame.element == ElementRepresentationIndex)
+                urlType->SetType(dash::metrics::IndexSegment);
+            else
+                urlType->SetType(dash::metrics::BitstreamSwitchingSegment);
+            break;
+        }
+        case ElementFailoverContent:
+        {
+            FailoverContent *failoverContent = (FailoverContent *) frame.object;
+
+            if((value = this->Find(frame, "valid")))    failoverContent->SetValid(String::ToBool(*value));
+            break;
+        }
+        case ElementFCS:
+        {
+            FCS *fcs = (FCS *) frame.object;
+
+            if((value = this->Find(frame, "t")))    fcs->SetPresentationTime(ToULong(value));
+            if((value = this->Find(frame, "d")))    fcs->SetDuration(ToULong(value));
+            break;
+        }
+        case ElementRepresentation:
+        {
+            Representation *representation = (Representation *) frame.object;
+
+            this->SetCommonValuesForRep(frame, *representation);
+
+            if((value = this->Find(frame, "id")))                       representation->SetId(*value);
+            if((value = this->Find(frame, "bandwidth")))                representation->SetBandwidth(ToULong(value));
+            if((value = this->Find(frame, "qualityRanking")))           representation->SetQualityRanking(ToULong(value));
+            if((value = this->Find(frame, "dependencyId")))             representation->SetDependencyId(*value);
+            if((value = this->Find(frame, "associationId")))            representation->SetAssociationId(*value);
+            if((value = this->Find(frame, "associationType")))          representation->SetAssociationType(*value);
+            if((value = this->Find(frame, "mediaStreamStructureId")))   representation->SetMediaStreamStructureId(*value);
+            break;
+        }
+        case ElementSubRepresentation:
+        {
+            SubRepresentation *subRepresentation = (SubRepresentation *) frame.object;
+
+            this->SetCommonValuesForRep(frame, *subRepresentation);
+
+            if((value = this->Find(frame, "level")))            subRepresentation->SetLevel(ToULong(value));
+            if((value = this->Find(frame, "dependencyLevel")))  subRepresentation->SetDependencyLevel(*value);
+            if((value = this->Find(frame, "bandwidth")))        subRepresentation->SetBandWidth(ToULong(value));
+            if((value = this->Find(frame, "contentComponent"))) subRepresentation->SetContentComponent(*value);
+            break;
+        }
+        case ElementExtendedBandwidth:
+        {
+            ExtendedBandwidth *extendedBandwidth = (ExtendedBandwidth *) frame.object;
+
+            if((value = this->Find(frame, "vbr")))  extendedBandwidth->SetVbr(String::ToBool(*value));
+            break;
+        }
+        case ElementModelPair:
+        {
+            ModelPair *modelPair = (ModelPair *) frame.object;
+
+            if((value = this->Find(frame, "bufferTime")))   modelPair->SetBufferTime(*value);
+            if((value = this->Find(frame, "bandwidth")))    modelPair->SetBandwidth(ToULong(value));
+            break;
+        }
+        case ElementContentComponent:
+        {
+            ContentComponent *contentComponent = (ContentComponent *) frame.object;
+
+            if((value = this->Find(frame, "id")))           contentComponent->SetId(ToULong(value));
+            if((value = this->Find(frame, "lang")))         contentComponent->SetLang(*value);
+            if((value = this->Find(frame, "contentType")))  contentComponent->SetContentType(*value);
+            if((value = this->Find(frame, "par")))          contentComponent->SetPar(*value);
+            if((value = this->Find(frame, "tag")))          contentComponent->SetTag(*value);
+            break;
+        }
+        case ElementSwitching:
+        {
+            Switching *switching = (Switching *) frame.object;
+
+            if((value = this->Find(frame, "interval")))     switching->SetInterval(ToULong(value));
+            if((value = this->Find(frame, "type")))         switching->SetType(*value);
+            break;
+        }
+        case ElementRandomAccess:
+        {
+            RandomAccess *randomAccess = (RandomAccess *) frame.object;
+
+            if((value = this->Find(frame, "interval")))         randomAccess->SetInterval(ToULong(value));
+            if((value = this->Find(frame, "type")))             randomAccess->SetType(*value);
+            if((value = this->Find(frame, "minBufferTime")))    randomAccess->SetMinBufferTime(*value);
+            if((value = this->Find(frame, "bandwidth")))        randomAccess->SetBandwidth(ToULong(value));
+            break;
+        }
+        case ElementContentPopularityRate:
+        {
+            ContentPopularityRate *contentPopularityRate = (ContentPopularityRate *) frame.object;
+
+            if((value = this->Find(frame, "source")))               contentPopularityRate->SetSource(*value);
+            if((value = this->Find(frame, "source_description")))   contentPopularityRate->SetSourceDescription(*value);
+            break;
+        }
+        case ElementPR:
+        {
+            PopularityRate *popularityRate = (PopularityRate *) frame.object;
+
+            if((value = this->Find(frame, "popularityRate")))   popularityRate->SetPopularityRate(ToULong(value));
+            if((value = this->Find(frame, "start")))            popularityRate->SetStart(ToULong(value));
+            if((value = this->Find(frame, "r")))                popularityRate->SetR(ToLong(value));
+            break;
+        }
+        case ElementProducerReferenceTime:
+        {
+            ProducerReferenceTime *producerReferenceTime = (ProducerReferenceTime *) frame.object;
+
+            if((value = this->Find(frame, "id")))                   producerReferenceTime->SetId(ToULong(value));
+            if((value = this->Find(frame, "inband")))               producerReferenceTime->SetInband(String::ToBool(*value));
+            if((value = this->Find(frame, "type")))                 producerReferenceTime->SetType(*value);
+            if((value = this->Find(frame, "applicationScheme")))    producerReferenceTime->SetApplicationScheme(*value);
+            if((value = this->Find(frame, "wallClockTime")))        producerReferenceTime->SetWallClockTime(*value);
+            if((value = this->Find(frame, "presentationTime")))     producerReferenceTime->SetPresentationTime(ToULong(value));
+            break;
+        }
+        case ElementResync:
+        {
+            Resync *resync = (Resync *) frame.object;
+
+            if((value = this->Find(frame, "type")))     resync->SetType(ToULong(value));
+            if((value = this->Find(frame, "dT")))       resync->SetDT(ToULong(value));
+            if((value = this->Find(frame, "dImax")))    resync->SetDIMax(strtof(value->c_str(), NULL));
+            if((value = this->Find(frame, "dImin")))    resync->SetDIMin(strtof(value->c_str(), NULL));
+            if((value = this->Find(frame, "marker")))   resync->SetMarker(String::ToBool(*value));
+            break;
+        }
+        default:
+            break;
+    }
+}
+void                MPDReader::Finish           (Frame &frame)
+{
+    switch(frame.element)
+    {
+        case ElementMPD:
+        {
+            BaseUrl *mpdPathBaseUrl = new BaseUrl();
+            mpdPathBaseUrl->SetUrl(this->mpdPath);
+            ((MPD *) frame.object)->SetMPDPathBaseUrl(mpdPathBaseUrl);
+            break;
+        }
+        case ElementBaseURL:
+            ((BaseUrl *) frame.object)->SetUrl(frame.text == "./" ? this->mpdPath : frame.text);
+            break;
+        case ElementPatchLocation:
+            ((PatchLocation *) frame.object)->SetUrl(frame.text == "./" ? this->mpdPath : frame.text);
+            break;
+        case ElementQualityLatency:
+            if(frame.text != "")
+            {
+                std::vector<std::string> pairs;
+                String::Split(frame.text, ',', pairs);
+                for(size_t i = 0; i < pairs.size(); i++)
+                    ((UIntPairsWithID *) frame.object)->AddQualityLatency(pairs.at(i));
+            }
+            break;
+        case ElementInitializationGroup:
+        case ElementInitializationPresentation:
+            if(frame.text != "")
+                ((UIntVWithID *) frame.object)->SetList(frame.text);
+            break;
+        default:
+            break;
+    }
+
+    if(frame.base)
+    {
+        std::map<std::string, std::string> attributes;
+
+        for(size_t i = 0; i < frame.attributes.size(); i++)
+            attributes[(const char *) frame.attributes[i].name] = frame.attributes[i].value;
+
+        frame.base->AddRawAttributes(attributes);
+    }
+}
+void                MPDReader::Attach           (Frame &parent, Frame &child)
+{
+    switch(child.element)
+    {
+        case ElementProgramInformation:
+            ((MPD *) parent.object)->AddProgramInformation((ProgramInformation *) child.object);
+            break;
+        case ElementTitle:
+            ((ProgramInformation *) parent.object)->SetTitle(child.text);
+            break;
+        case ElementSource:
+            ((ProgramInformation *) parent.object)->SetSource(child.text);
+            break;
+        case ElementCopyright:
+            ((ProgramInformation *) parent.object)->SetCopyright(child.text);
+            break;
+        case ElementLocation:
+            ((MPD *) parent.object)->AddLocation(child.text);
+            break;
+        case ElementBaseURL:
+            if(parent.element == ElementMPD)
+                ((MPD *) parent.object)->AddBaseUrl((BaseUrl *) child.object);
+            else if(parent.element == ElementPeriod)
+                ((Period *) parent.object)->AddBaseURL((BaseUrl *) child.object);
+            else if(parent.element == ElementAdaptationSet)
+                ((AdaptationSet *) parent.object)->AddBaseURL((BaseUrl *) child.object);
+            else
+                ((Representation *) parent.object)->AddBaseURL((BaseUrl *) child.object);
+            break;
+        case ElementPatchLocation:
+            ((MPD *) parent.object)->AddPatchLocation((PatchLocation *) child.object);
+            break;
+        case ElementServiceDescription:
+            if(parent.element == ElementMPD)
+                ((MPD *) parent.object)->AddServiceDescription((ServiceDescription *) child.object);
+            else
+                ((Period *) parent.object)->AddServiceDescription((ServiceDescription *) child.object);
+            break;
+        case ElementScope:
+            ((ServiceDescription *) parent.object)->AddScope((Descriptor *) child.object);
+            break;
+        case ElementLatency:
+            ((ServiceDescription *) parent.object)->AddLatency((Latency *) child.object);
+            break;
+        case ElementQualityLatency:
+            ((Latency *) parent.object)->AddQualityLatencyType((UIntPairsWithID *) child.object);
+            break;
+        case ElementPlaybackRate:
+            ((ServiceDescription *) parent.object)->AddPlaybackRate((PlaybackRate *) child.object);
+            break;
+        case ElementOperatingQuality:
+            ((ServiceDescription *) parent.object)->AddOperatingQuality((OperatingQuality *) child.object);
+            break;
+        case ElementOperatingBandwidth:
+            ((ServiceDescription *) parent.object)->AddOperatingBandwidth((OperatingBandwidth *) child.object);
+            break;
+        case ElementInitializationSet:
+            ((MPD *) parent.object)->AddInitializationSet((InitializationSet *) child.object);
+            break;
+        case ElementInitializationGroup:
+            ((MPD *) parent.object)->AddInitializationGroup((UIntVWithID *) child.object);
+            break;
+        case ElementInitializationPresentation:
+            ((MPD *) parent.object)->AddInitializationPresentation((UIntVWithID *) child.object);
+            break;
+        case ElementContentProtection:
+            if(parent.element == ElementMPD)
+                ((MPD *) parent.object)->AddContentProtection((ContentProtection *) child.object);
+            else if(parent.element == ElementPeriod)
+                ((Period *) parent.object)->AddContentProtection((ContentProtection *) child.object);
+            else
+                parent.representationBase->AddContentProtection((ContentProtection *) child.object);
+            break;
+        case ElementPeriod:
+            ((MPD *) parent.object)->AddPeriod((Period *) child.object);
+            break;
+        case ElementMetrics:
+            ((MPD *) parent.object)->AddMetrics((Metrics *) child.object);
+            break;
+        case ElementReporting:
+            ((Metrics *) parent.object)->AddReporting((Descriptor *) child.object);
+            break;
+        case ElementRange:
+            ((Metrics *) parent.object)->AddRange((Range *) child.object);
+            break;
+        case ElementEssentialProperty:
+            if(parent.element == ElementMPD)
+                ((MPD *) parent.object)->AddEssentialProperty((Descriptor *) child.object);
+            else
+                parent.representationBase->AddEssentialProperty((Descriptor *) child.object);
+            break;
+        case ElementSupplementalProperty:
+            if(parent.element == ElementMPD)
+                ((MPD *) parent.object)->AddSupplementalProperty((Descriptor *) child.object);
+            else if(parent.element == ElementPeriod)
+                ((Period *) parent.object)->AddSupplementalProperty((Descriptor *) child.object);
+            else
+                parent.representationBase->AddSupplementalProperty((Descriptor *) child.object);
+            break;
+        case ElementUTCTiming:
+            if(parent.element == ElementMPD)
+                ((MPD *) parent.object)->AddUTCTiming((Descriptor *) child.object);
+            else
+                ((ProducerReferenceTime *) parent.object)->SetUTCTiming((Descriptor *) child.object);
+            break;
+        case ElementLeapSecondInformation:
+            ((MPD *) parent.object)->SetLeapSecondInformation((LeapSecondInformation *) child.object);
+            break;
+        case ElementAdaptationSet:
+            ((Period *) parent.object)->AddAdaptationSet((AdaptationSet *) child.object);
+            break;
+        case ElementSubset:
+            ((Period *) parent.object)->AddSubset((Subset *) child.object);
+            break;
+        case ElementGroupLabel:
+            if(parent.element == ElementPeriod)
+                ((Period *) parent.object)->AddGroupLabel((Label *) child.object);
+            else
+                parent.representationBase->AddGroupLabel((Label *) child.object);
+            break;
+        case ElementLabel:
+            parent.representationBase->AddLabel((Label *) child.object);
+            break;
+        case ElementPreselection:
+            ((Period *) parent.object)->AddPreselection((Preselection *) child.object);
+            break;
+        case ElementAssetIdentifier:
+            ((Period *) parent.object)->SetAssetIdentifier((Descriptor *) child.object);
+            break;
+        case ElementEventStream:
+            ((Period *) parent.object)->AddEventStream((EventStream *) child.object);
+            break;
+        case ElementInbandEventStream:
+            parent.representationBase->AddEventStream((EventStream *) child.object);
+            break;
+        case ElementEvent:
+            ((EventStream *) parent.object)->AddEvent((Event *) child.object);
+            break;
+        case ElementSegmentBase:
+            if(parent.element == ElementPeriod)
+                ((Period *) parent.object)->SetSegmentBase((SegmentBase *) child.object);
+            else if(parent.element == ElementAdaptationSet)
+                ((AdaptationSet *) parent.object)->SetSegmentBase((SegmentBase *) child.object);
+            else
+                ((Representation *) parent.object)->SetSegmentBase((SegmentBase *) child.object);
+            break;
+        case ElementSegmentList:
+            if(parent.element == ElementPeriod)
+                ((Period *) parent.object)->SetSegmentList((SegmentList *) child.object);
+            else if(parent.element == ElementAdaptationSet)
+                ((AdaptationSet *) parent.object)->SetSegmentList((SegmentList *) child.object);
+            else
+                ((Representation *) parent.object)->SetSegmentList((SegmentList *) child.object);
+            break;
+        case ElementSegmentTemplate:
+            if(parent.element == ElementPeriod)
+                ((Period *) parent.object)->SetSegmentTemplate((SegmentTemplate *) child.object);
+            else if(parent.element == ElementAdaptationSet)
+                ((AdaptationSet *) parent.object)->SetSegmentTemplate((SegmentTemplate *) child.object);
+            else
+                ((Representation *) parent.object)->SetSegmentTemplate((SegmentTemplate *) child.object);
+            break;
+        case ElementSegmentTimeline:
+            parent.multipleSegmentBase->SetSegmentTimeline((SegmentTimeline *) child.object);
+            break;
+        case ElementS:
+            ((SegmentTimeline *) parent.object)->AddTimeline((Timeline *) child.object);
+            break;
+        case ElementSegmentURL:
+            ((SegmentList *) parent.object)->AddSegmentURL((SegmentURL *) child.object);
+            break;
+        case ElementInitialization:
+            parent.segmentBase->SetInitialization((URLType *) child.object);
+            break;
+        case ElementRepresentationIndex:
+            parent.segmentBase->SetRepresentationIndex((URLType *) child.object);
+            break;
+        case ElementBitstreamSwitching:
+            parent.multipleSegmentBase->SetBitstreamSwitching((URLType *) child.object);
+            break;
+        case ElementFailoverContent:
+            ((SegmentBase *) parent.object)->SetFailoverContent((FailoverContent *) child.object);
+            break;
+        case ElementFCS:
+            ((FailoverContent *) parent.object)->AddFCS((FCS *) child.object);
+            break;
+        case ElementRepresentation:
+            ((AdaptationSet *) parent.object)->AddRepresentation((Representation *) child.object);
+            break;
+        case ElementSubRepresentation:
+            ((Representation *) parent.object)->AddSubRepresentation((SubRepresentation *) child.object);
+            break;
+        case ElementExtendedBandwidth:
+            ((Representation *) parent.object)->AddExtendedBandwidth((ExtendedBandwidth *) child.object);
+            break;
+        case ElementModelPair:
+            ((ExtendedBandwidth *) parent.object)->AddModelPair((ModelPair *) child.object);
+            break;
+        case ElementContentComponent:
+            ((AdaptationSet *) parent.object)->AddContentComponent((ContentComponent *) child.object);
+            break;
+        case ElementAccessibility:
+        case ElementRole:
+        case ElementRating:
+        case ElementViewpoint:
+        {
+            Descriptor *descriptor = (Descriptor *) child.object;
+
+            if(parent.element == ElementContentComponent)
+            {
+                ContentComponent *contentComponent = (ContentComponent *) parent.object;
+                if(child.element == ElementAccessibility)   contentComponent->AddAccessibity(descriptor);
+                if(child.element == ElementRole)            contentComponent->AddRole(descriptor);
+                if(child.element == ElementRating)          contentComponent->AddRating(descriptor);
+                if(child.element == ElementViewpoint)       contentComponent->AddViewpoint(descriptor);
+            }
+            else if(parent.element == ElementAdaptationSet)
+            {
+                AdaptationSet *adaptationSet = (AdaptationSet *) parent.object;
+                if(child.element == ElementAccessibility)   adaptationSet->AddAccessibity(descriptor);
+                if(child.element == ElementRole)            adaptationSet->AddRole(descriptor);
+                if(child.element == ElementRating)          adaptationSet->AddRating(descriptor);
+                if(child.element == ElementViewpoint)       adaptationSet->AddViewpoint(descriptor);
+            }
+            else if(parent.element == ElementPreselection)
+            {
+                Preselection *preselection = (Preselection *) parent.object;
+                if(child.element == ElementAccessibility)   preselection->AddAccessibity(descriptor);
+                if(child.element == ElementRole)            preselection->AddRole(descriptor);
+                if(child.element == ElementRating)          preselection->AddRating(descriptor);
+                if(child.element == ElementViewpoint)       preselection->AddViewpoint(descriptor);
+            }
+            else
+            {
+                InitializationSet *initializationSet = (InitializationSet *) parent.object;
+                if(child.element == ElementAccessibility)   initializationSet->AddAccessibity(descriptor);
+                if(child.element == ElementRole)            initializationSet->AddRole(descriptor);
+                if(child.element == ElementRating)          initializationSet->AddRating(descriptor);
+                if(child.element == ElementViewpoint)       initializationSet->AddViewpoint(descriptor);
+            }
+            break;
+        }
+        case ElementFramePacking:
+            parent.representationBase->AddFramePacking((Descriptor *) child.object);
+            break;
+        case ElementAudioChannelConfiguration:
+            parent.representationBase->AddAudioChannelConfiguration((Descriptor *) child.object);
+            break;
+        case ElementOutputProtection:
+            parent.representationBase->SetOutputProtection((Descriptor *) child.object);
+            break;
+        case ElementSwitching:
+            parent.representationBase->AddSwitching((Switching *) child.object);
+            break;
+        case ElementRandomAccess:
+            parent.representationBase->AddRandomAccess((RandomAccess *) child.object);
+            break;
+        case ElementContentPopularityRate:
+            parent.representationBase->AddContentPopularityRate((ContentPopularityRate *) child.object);
+            break;
+        case ElementPR:
+            ((ContentPopularityRate *) parent.object)->AddPopularityRate((PopularityRate *) child.object);
+            break;
+        case ElementProducerReferenceTime:
+            parent.representationBase->AddProducerReferenceTime((ProducerReferenceTime *) child.object);
+            break;
+        case ElementResync:
+            parent.representationBase->AddResync((Resync *) child.object);
+            break;
+        default:
+            break;
+    }
+}
+void                MPDReader::SetCommonValuesForRep    (Frame &frame, RepresentationBase &object)
+{
+    const std::string *value = NULL;
+
+    if((value = this->Find(frame, "profiles")))             object.SetProfiles(*value);
+    if((value = this->Find(frame, "width")))                object.SetWidth(ToULong(value));
+    if((value = this->Find(frame, "height")))               object.SetHeight(ToULong(value));
+    if((value = this->Find(frame, "sar")))                  object.SetSar(*value);
+    if((value = this->Find(frame, "frameRate")))            object.SetFrameRate(*value);
+    if((value = this->Find(frame, "audioSamplingRate")))    object.SetAudioSamplingRate(*value);
+    if((value = this->Find(frame, "mimeType")))             object.SetMimeType(*value);
+    if((value = this->Find(frame, "segmentProfiles")))      object.SetSegmentProfiles(*value);
+    if((value = this->Find(frame, "codecs")))               object.SetCodecs(*value);
+    if((value = this->Find(frame, "containerProfiles")))    object.SetContainerProfiles(*value);
+    if((value = this->Find(frame, "maximumSAPPeriod")))     object.SetMaximumSAPPeriod(ToDouble(value));
+    if((value = this->Find(frame, "startWithSAP")))         object.SetStartWithSAP((uint8_t) ToULong(value));
+    if((value = this->Find(frame, "maxPlayoutRate")))       object.SetMaxPlayoutRate(ToDouble(value));
+    if((value = this->Find(frame, "codingDependency")))     object.SetCodingDependency(String::ToBool(*value));
+    if((value = this->Find(frame, "scanType")))             object.SetScanType(*value);
+    if((value = this->Find(frame, "selectionPriority")))    object.SetSelectionPriority(ToULong(value));
+    if((value = this->Find(frame, "tag")))                  object.SetTag(*value);
+}
+void                MPDReader::SetCommonValuesForDesc   (Frame &frame, Descriptor &object)
+{
+    const std::string *value = NULL;
+
+    if((value = this->Find(frame, "schemeIdUri")))  object.SetSchemeIdUri(*value);
+    if((value = this->Find(frame, "value")))        object.SetValue(*value);
+    if((value = this->Find(frame, "id")))           object.SetId(*value);
+}
+void                MPDReader::SetCommonValuesForSeg    (Frame &frame, SegmentBase &object)
+{
+    const std::string *value = NULL;
+
+    if((value = this->Find(frame, "timescale")))                object.SetTimescale(ToULong(value));
+    if((value = this->Find(frame, "eptDelta")))                 object.SetEptDelta((int) ToLong(value));
+    if((value = this->Find(frame, "pdDelta")))                  object.SetPdDelta((int) ToLong(value));
+    if((value = this->Find(frame, "presentationTimeOffset")))   object.SetPresentationTimeOffset(ToULong(value));
+    if((value = this->Find(frame, "presentationDuration")))     object.SetPresentationDuration(ToULong(value));
+    if((value = this->Find(frame, "timeShiftBufferDepth")))     object.SetTimeShiftBufferDepth(*value);
+    if((value = this->Find(frame, "indexRange")))               object.SetIndexRange(*value);
+    if((value = this->Find(frame, "indexRangeExact")))          object.SetIndexRangeExact(String::ToBool(*value));
+    if((value = this->Find(frame, "availabilityTimeOffset")))   object.SetAvailabilityTimeOffset(ToDouble(value));
+    if((value = this->Find(frame, "availabilityTimeComplete"))) object.SetAvailabilityTimeComplete(String::ToBool(*value));
+}
+void                MPDReader::SetCommonValuesForMSeg   (Frame &frame, MultipleSegmentBase &object)
+{
+    const std::string *value = NULL;
+
+    this->SetCommonValuesForSeg(frame, object);
+
+    if((value = this->Find(frame, "duration")))     object.SetDuration(ToULong(value));
+    if((value = this->Find(frame, "startNumber")))  object.SetStartNumber(ToULong(value));
+    if((value = this->Find(frame, "endNumber")))    object.SetEndNumber(ToULong(value));
+}
+std::string         MPDReader::ReadAttribute    (const char *name)
+{
+    xmlChar *value = xmlTextReaderGetAttribute(this->reader, BAD_CAST name);
+    if(value == NULL)
+        return "";
+
+    std::string attribute((const char *) value);
+    xmlFree(value);
+
+    return attribute;
+}
+std::string         MPDReader::ReadText         ()
+{
+    xmlChar *value = xmlTextReaderReadString(this->reader);
+    if(value == NULL)
+        return "";
+
+    std::string text((const char *) value);
+    xmlFree(value);
+
+    return text;
+}
+bool                MPDReader::Select           (MPD *mpd, const std::string &path, Frame &parent, Frame &target, std::string &attribute)
+{
+    std::vector<std::string> steps;
+
+    /* split on '/' outside of quoted predicate values */
+    char quote = 0;
+    for(size_t i = 0; i < path.size(); i++)
+    {
+        char c = path.at(i);
+
+        if(quote)
+        {
+            if(c == quote)
+                quote = 0;
+        }
+        else if(c == '\'' || c == '"')
+        {
+            quote = c;
+        }
+        else if(c == '/')
+        {
+            steps.push_back("");
+            continue;
+        }
+
+        if(steps.empty())
+            return false;
+
+        steps.back() += c;
+    }
+
+    if(steps.empty() || steps.at(0).compare(0, 3, "MPD") != 0 || (steps.at(0).size() > 3 && steps.at(0).at(3) != '['))
+        return false;
+
+    parent.element  = ElementUnknown;
+    parent.object   = NULL;
+    target.element  = ElementMPD;
+    target.object   = mpd;
+    this->Bind(parent);
+    this->Bind(target);
+
+    for(size_t i = 1; i < steps.size(); i++)
+    {
+        const std::string &step = steps.at(i);
+
+        if(step.size() > 1 && step.at(0) == '@')
+        {
+            if(i + 1 != steps.size())
+                return false;
+
+            attribute = step.substr(1);
+            return true;
+        }
+
+        size_t          open    = step.find('[');
+        const xmlChar   *name   = xmlTextReaderConstString(this->reader, BAD_CAST step.substr(0, open).c_str());
+        Element         element = this->Lookup(target.element, name);
+
+        std::vector<Frame> candidates;
+        if(element == ElementUnknown || !this->Children(target, element, candidates))
+            return false;
+
+        while(open != std::string::npos)
+        {
+            size_t close = step.find(']', open);
+            if(close == std::string::npos)
+                return false;
+
+            std::string predicate = step.substr(open + 1, close - open - 1);
+            std::vector<Frame> matches;
+
+            if(predicate.size() > 0 && predicate.at(0) == '@')
+            {
+                for(size_t j = 0; j < candidates.size(); j++)
+                    if(this->Matches(candidates.at(j), predicate))
+                        matches.push_back(candidates.at(j));
+            }
+            else
+            {
+                size_t index = strtoul(predicate.c_str(), NULL, 10);
+                if(index >= 1 && index <= candidates.size())
+                    matches.push_back(candidates.at(index - 1));
+            }
+
+            candidates.swap(matches);
+            open = step.find('[', close);
+        }
+
+        /* a selector has to match exactly one node */
+        if(candidates.size() != 1)
+            return false;
+
+        parent = target;
+        target = candidates.at(0);
+    }
+
+    return true;
+}
+bool                MPDReader::Children         (const Frame &parent, Element element, std::vector<Frame> &children)
+{
+    switch(element)
+    {
+        case ElementPeriod:
+            for(size_t i = 0; i < ((MPD *) parent.object)->GetPeriods().size(); i++)
+                this->AddChild(children, element, (Period *) ((MPD *) parent.object)->GetPeriods().at(i));
+            return true;
+        case ElementAdaptationSet:
+            for(size_t i = 0; i < ((Period *) parent.object)->GetAdaptationSets().size(); i++)
+                this->AddChild(children, element, (AdaptationSet *) ((Period *) parent.object)->GetAdaptationSets().at(i));
+            return true;
+        case ElementRepresentation:
+            for(size_t i = 0; i < ((AdaptationSet *) parent.object)->GetRepresentation().size(); i++)
+                this->AddChild(children, element, (Representation *) ((AdaptationSet *) parent.object)->GetRepresentation().at(i));
+            return true;
+        case ElementSubRepresentation:
+            for(size_t i = 0; i < ((Representation *) parent.object)->GetSubRepresentations().size(); i++)
+                this->AddChild(children, element, (SubRepresentation *) ((Representation *) parent.object)->GetSubRepresentations().at(i));
+            return true;
+        case ElementBaseURL:
+        {
+            std::vector<IBaseUrl *> baseUrls;
+            if(parent.element == ElementMPD)
+                baseUrls = ((MPD *) parent.object)->GetBaseUrls();
+            else if(parent.element == ElementPeriod)
+                baseUrls = ((Period *) parent.object)->GetBaseURLs();
+            else if(parent.element == ElementAdaptationSet)
+                baseUrls = ((AdaptationSet *) parent.object)->GetBaseURLs();
+            else
+                baseUrls = ((Representation *) parent.object)->GetBaseURLs();
+
+            for(size_t i = 0; i < baseUrls.size(); i++)
+                this->AddChild(children, element, (BaseUrl *) baseUrls.at(i));
+            return true;
+        }
+        case ElementPatchLocation:
+            for(size_t i = 0; i < ((MPD *) parent.object)->GetPatchLocations().size(); i++)
+                this->AddChild(children, element, (PatchLocation *) ((MPD *) parent.object)->GetPatchLocations().at(i));
+            return true;
+        case ElementUTCTiming:
+            if(parent.element != ElementMPD)
+                return false;
+
+            for(size_t i = 0; i < ((MPD *) parent.object)->GetUTCTimings().size(); i++)
+                this->AddChild(children, element, dynamic_cast<Descriptor *>(((MPD *) parent.object)->GetUTCTimings().at(i)));
+            return true;
+        case ElementSegmentBase:
+        case ElementSegmentList:
+        case ElementSegmentTemplate:
+        {
+            void *object = NULL;
+
+            if(parent.element == ElementPeriod)
+            {
+                Period *period = (Period *) parent.object;
+                object = element == ElementSegmentBase ? (void *) dynamic_cast<SegmentBase *>(period->GetSegmentBase()) :
+                         element == ElementSegmentList ? (void *) (SegmentList *) period->GetSegmentList() :
+                                                         (void *) (SegmentTemplate *) period->GetSegmentTemplate();
+            }
+            else if(parent.element == ElementAdaptationSet)
+            {
+                AdaptationSet *adaptationSet = (AdaptationSet *) parent.object;
+                object = element == ElementSegmentBase ? (void *) dynamic_cast<SegmentBase *>(adaptationSet->GetSegmentBase()) :
+                         element == ElementSegmentList ? (void *) (SegmentList *) adaptationSet->GetSegmentList() :
+                                                         (void *) (SegmentTemplate *) adaptationSet->GetSegmentTemplate();
+            }
+            else
+            {
+                Representation *representation = (Representation *) parent.object;
+                object = element == ElementSegmentBase ? (void *) dynamic_cast<SegmentBase *>(representation->GetSegmentBase()) :
+                         element == ElementSegmentList ? (void *) (SegmentList *) representation->GetSegmentList() :
+                                                         (void *) (SegmentTemplate *) representation->GetSegmentTemplate();
+            }
+
+            if(object)
+                this->AddChild(children, element, object);
+            return true;
+        }
+        case ElementSegmentTimeline:
+            if(parent.multipleSegmentBase->GetSegmentTimeline())
+                this->AddChild(children, element, (SegmentTimeline *) parent.multipleSegmentBase->GetSegmentTimeline());
+            return true;
+        case ElementS:
+            for(size_t i = 0; i < ((SegmentTimeline *) parent.object)->GetTimelines().size(); i++)
+                this->AddChild(children, element, (Timeline *) ((SegmentTimeline *) parent.object)->GetTimelines().at(i));
+            return true;
+        case ElementSegmentURL:
+            for(size_t i = 0; i < ((SegmentList *) parent.object)->GetSegmentURLs().size(); i++)
+                this->AddChild(children, element, (SegmentURL *) ((SegmentList *) parent.object)->GetSegmentURLs().at(i));
+            return true;
+        case ElementEventStream:
+            if(parent.element != ElementPeriod)
+                return false;
+
+            for(size_t i = 0; i < ((Period *) parent.object)->GetEventStreams().size(); i++)
+                this->AddChild(children, element, (EventStream *) ((Period *) parent.object)->GetEventStreams().at(i));
+            return true;
+        case ElementEvent:
+            for(size_t i = 0; i < ((EventStream *) parent.object)->GetEvents().size(); i++)
+                this->AddChild(children, element, (Event *) ((EventStream *) parent.object)->GetEvents().at(i));
+            return true;
+        default:
+            return false;
+    }
+}
+void                MPDReader::AddChild         (std::vector<Frame> &children, Element element, void *object)
+{
+    children.push_back(Frame());
+
+    Frame &child = children.back();
+    child.element   = element;
+    child.object    = object;
+    child.node      = NULL;
+    child.hasText   = false;
+    this->Bind(child);
+}
+bool                MPDReader::Matches          (const Frame &frame, const std::string &predicate)
+{
+    /* @name='value' or @name="value" */
+    size_t equals = predicate.find('=');
+    if(frame.base == NULL || equals == std::string::npos || predicate.size() < equals + 3)
+        return false;
+
+    std::string name    = predicate.substr(1, equals - 1);
+    std::string value   = predicate.substr(equals + 2, predicate.size() - equals - 3);
+
+    std::map<std::string, std::string> attributes = frame.base->GetRawAttributes();
+    std::map<std::string, std::string>::const_iterator it = attributes.find(name);
+
+    return it != attributes.end() && it->second == value;
+}
+void                MPDReader::SetAttribute     (const Frame &parent, const Frame &target, const std::string &name, const std::string &value)
+{
+    Frame frame = target;
+
+    frame.attributes.clear();
+    frame.attributes.push_back(Attribute());
+    frame.attributes.back().name    = xmlTextReaderConstString(this->reader, BAD_CAST name.c_str());
+    frame.attributes.back().value   = value;
+
+    this->Apply(frame);
+
+    if(frame.base)
+    {
+        std::map<std::string, std::string> attributes = frame.base->GetRawAttributes();
+        attributes[name] = value;
+        frame.base->AddRawAttributes(attributes);
+    }
+
+    /* the timeline index caches S@t, @d and @r */
+    if(target.element == ElementS)
+        ((SegmentTimeline *) parent.object)->Reindex();
+}
+bool                MPDReader::Remove           (const Frame &parent, const Frame &target)
+{
+    switch(target.element)
+    {
+        case ElementPeriod:
+            return ((MPD *) parent.object)->RemovePeriod((Period *) target.object);
+        case ElementAdaptationSet:
+            return ((Period *) parent.object)->RemoveAdaptationSet((AdaptationSet *) target.object);
+        case ElementRepresentation:
+            return ((AdaptationSet *) parent.object)->RemoveRepresentation((Representation *) target.object);
+        case ElementS:
+            return ((SegmentTimeline *) parent.object)->RemoveTimeline((Timeline *) target.object);
+        case ElementSegmentURL:
+            return ((SegmentList *) parent.object)->RemoveSegmentURL((SegmentURL *) target.object);
+        case ElementEvent:
+            return ((EventStream *) parent.object)->RemoveEvent((Event *) target.object);
+        default:
+            return false;
+    }
+}
+const std::string*  MPDReader::Find             (const Frame &frame, const char *name)
+{
+    const xmlChar *key = this->Intern(name);
+
+    for(size_t i = 0; i < frame.attributes.size(); i++)
+        if(frame.attributes[i].name == key)
+            return &frame.attributes[i].value;
+
+    return NULL;
+}
+const xmlChar*      MPDReader::Intern           (const char *name)
+{
+    std::map<const char *, const xmlChar *>::const_iterator it = this->literals.find(name);
+    if(it != this->literals.end())
+        return it->second;
+
+    const xmlChar *key = xmlTextReaderConstString(this->reader, BAD_CAST name);
+    this->literals[name] = key;
+
+    return key;
+}
+const xmlChar*      MPDReader::CurrentName      ()
+{
+    const xmlChar *name = xmlTextReaderConstName(this->reader);
+
+    /* prefixed names come from a separate QName lookup, intern the full string */
+    if(xmlTextReaderConstPrefix(this->reader) != NULL)
+        name = xmlTextReaderConstString(this->reader, name);
+
+    return name;
+}
+MPDReader::Element  MPDReader::Lookup           (Element parent, const xmlChar *name)
+{
+    std::map<const xmlChar *, Element>::const_iterator it = this->elements.find(name);
+
+    if(it == this->elements.end() || !children[parent][it->second])
+        return ElementUnknown;
+
+    return it->second;
+}
+void                MPDReader::InitNames        ()
+{
+    static const struct { Element element; const char *name; } names[] =
+    {
+        { ElementMPD,                           "MPD" },
+        { ElementProgramInformation,            "ProgramInformation" },
+        { ElementTitle,                         "Title" },
+        { ElementSource,                        "Source" },
+        { ElementCopyright,                     "Copyright" },
+        { ElementBaseURL,                       "BaseURL" },
+        { ElementLocation,                      "Location" },
+        { ElementPatchLocation,                 "PatchLocation" },
+        { ElementServiceDescription,            "ServiceDescription" },
+        { ElementScope,                         "Scope" },
+        { ElementLatency,                       "Latency" },
+        { ElementQualityLatency,                "QualityLatency" },
+        { ElementPlaybackRate,                  "PlaybackRate" },
+        { ElementOperatingQuality,              "OperatingQuality" },
+        { ElementOperatingBandwidth,            "OperatingBandwidth" },
+        { ElementInitializationSet,             "InitializationSet" },
+        { ElementInitializationGroup,           "InitializationGroup" },
+        { ElementInitializationPresentation,    "InitializationPresentation" },
+        { ElementContentProtection,             "ContentProtection" },
+        { ElementPeriod,                        "Period" },
+        { ElementMetrics,                       "Metrics" },
+        { ElementReporting,                     "Reporting" },
+        { ElementRange,                         "Range" },
+        { ElementEssentialProperty,             "EssentialProperty" },
+        { ElementSupplementalProperty,          "SupplementalProperty" },
+        { ElementUTCTiming,                     "UTCTiming" },
+        { ElementLeapSecondInformation,         "LeapSecondInformation" },
+        { ElementAdaptationSet,                 "AdaptationSet" },
+        { ElementSubset,                        "Subset" },
+        { ElementGroupLabel,                    "GroupLabel" },
+        { ElementLabel,                         "Label" },
+        { ElementPreselection,                  "Preselection" },
+        { ElementAssetIdentifier,               "AssetIdentifier" },
+        { ElementEventStream,                   "EventStream" },
+        { ElementInbandEventStream,             "InbandEventStream" },
+        { ElementEvent,                         "Event" },
+        { ElementSegmentBase,                   "SegmentBase" },
+        { ElementSegmentList,                   "SegmentList" },
+        { ElementSegmentTemplate,               "SegmentTemplate" },
+        { ElementSegmentTimeline,               "SegmentTimeline" },
+        { ElementS,                             "S" },
+        { ElementSegmentURL,                    "SegmentURL" },
+        { ElementInitialization,                "Initialization" },
+        { ElementRepresentationIndex,           "RepresentationIndex" },
+        { ElementBitstreamSwitching,            "BitstreamSwitching" },
+        { ElementFailoverContent,               "FailoverContent" },
+        { ElementFCS,                           "FCS" },
+        { ElementRepresentation,                "Representation" },
+        { ElementSubRepresentation,             "SubRepresentation" },
+        { ElementExtendedBandwidth,             "ExtendedBandwidth" },
+        { ElementModelPair,                     "ModelPair" },
+        { ElementContentComponent,              "ContentComponent" },
+        { ElementAccessibility,                 "Accessibility" },
+        { ElementRole,                          "Role" },
+        { ElementRating,                        "Rating" },
+        { ElementViewpoint,                     "Viewpoint" },
+        { ElementFramePacking,                  "FramePacking" },
+        { ElementAudioChannelConfiguration,     "AudioChannelConfiguration" },
+        { ElementOutputProtection,              "OutputProtection" },
+        { ElementSwitching,                     "Switching" },
+        { ElementRandomAccess,                  "RandomAccess" },
+        { ElementContentPopularityRate,         "ContentPopularityRate" },
+        { ElementPR,                            "PR" },
+        { ElementProducerReferenceTime,         "ProducerReferenceTime" },
+        { ElementResync,                        "Resync" },
+    };
+
+    for(size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+        this->elements[this->Intern(names[i].name)] = names[i].element;
+}
+void                MPDReader::InitChildren     ()
+{
+    /* which child elements each element turns into objects, as in Node::To* */
+    static const Element representationBases[]  = { ElementAdaptationSet, ElementRepresentation, ElementSubRepresentation, ElementPreselection, ElementInitializationSet };
+    static const Element representationCommon[] = { ElementFramePacking, ElementAudioChannelConfiguration, ElementContentProtection, ElementOutputProtection,
+                                                     ElementEssentialProperty, ElementSupplementalProperty, ElementInbandEventStream, ElementSwitching,
+                                                     ElementRandomAccess, ElementGroupLabel, ElementLabel, ElementContentPopularityRate,
+                                                     ElementProducerReferenceTime, ElementResync };
+    static const Element descriptorOwners[]     = { ElementContentComponent, ElementAdaptationSet, ElementPreselection, ElementInitializationSet };
+    static const Element descriptorCommon[]     = { ElementAccessibility, ElementRole, ElementRating, ElementViewpoint };
+    static const Element segmentBases[]         = { ElementSegmentBase, ElementSegmentList, ElementSegmentTemplate };
+    static const Element segmentOwners[]        = { ElementPeriod, ElementAdaptationSet, ElementRepresentation };
+    static const Element pairs[][2] =
+    {
+        { ElementMPD,                   ElementProgramInformation },
+        { ElementMPD,                   ElementBaseURL },
+        { ElementMPD,                   ElementLocation },
+        { ElementMPD,                   ElementPatchLocation },
+        { ElementMPD,                   ElementServiceDescription },
+        { ElementMPD,                   ElementInitializationSet },
+        { ElementMPD,                   ElementInitializationGroup },
+        { ElementMPD,                   ElementInitializationPresentation },
+        { ElementMPD,                   ElementContentProtection },
+        { ElementMPD,                   ElementPeriod },
+        { ElementMPD,                   ElementMetrics },
+        { ElementMPD,                   ElementEssentialProperty },
+        { ElementMPD,                   ElementSupplementalProperty },
+        { ElementMPD,                   ElementUTCTiming },
+        { ElementMPD,                   ElementLeapSecondInformation },
+        { ElementProgramInformation,    ElementTitle },
+        { ElementProgramInformation,    ElementSource },
+        { ElementProgramInformation,    ElementCopyright },
+        { ElementServiceDescription,    ElementScope },
+        { ElementServiceDescription,    ElementLatency },
+        { ElementServiceDescription,    ElementPlaybackRate },
+        { ElementServiceDescription,    ElementOperatingQuality },
+        { ElementServiceDescription,    ElementOperatingBandwidth },
+        { ElementLatency,               ElementQualityLatency },
+        { ElementMetrics,               ElementReporting },
+        { ElementMetrics,               ElementRange },
+        { ElementPeriod,                ElementBaseURL },
+        { ElementPeriod,                ElementAdaptationSet },
+        { ElementPeriod,                ElementSubset },
+        { ElementPeriod,                ElementGroupLabel },
+        { ElementPeriod,                ElementPreselection },
+        { ElementPeriod,                ElementAssetIdentifier },
+        { ElementPeriod,                ElementEventStream },
+        { ElementPeriod,                ElementServiceDescription },
+        { ElementPeriod,                ElementContentProtection },
+        { ElementPeriod,                ElementSupplementalProperty },
+        { ElementAdaptationSet,         ElementContentComponent },
+        { ElementAdaptationSet,         ElementBaseURL },
+        { ElementAdaptationSet,         ElementRepresentation },
+        { ElementRepresentation,        ElementBaseURL },
+        { ElementRepresentation,        ElementExtendedBandwidth },
+        { ElementRepresentation,        ElementSubRepresentation },
+        { ElementExtendedBandwidth,     ElementModelPair },
+        { ElementEventStream,           ElementEvent },
+        { ElementSegmentBase,           ElementFailoverContent },
+        { ElementFailoverContent,       ElementFCS },
+        { ElementSegmentList,           ElementSegmentURL },
+        { ElementSegmentList,           ElementSegmentTimeline },
+        { ElementSegmentList,           ElementBitstreamSwitching },
+        { ElementSegmentTemplate,       ElementSegmentTimeline },
+        { ElementSegmentTemplate,       ElementBitstreamSwitching },
+        { ElementSegmentTimeline,       ElementS },
+        { ElementContentPopularityRate, ElementPR },
+        { ElementProducerReferenceTime, ElementUTCTiming },
+    };
+
+    memset(children, 0, sizeof(children));
+
+    for(size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++)
+        children[pairs[i][0]][pairs[i][1]] = true;
+
+    for(size_t i = 0; i < sizeof(representationBases) / sizeof(representationBases[0]); i++)
+        for(size_t j = 0; j < sizeof(representationCommon) / sizeof(representationCommon[0]); j++)
+            children[representationBases[i]][representationCommon[j]] = true;
+
+    for(size_t i = 0; i < sizeof(descriptorOwners) / sizeof(descriptorOwners[0]); i++)
+        for(size_t j = 0; j < sizeof(descriptorCommon) / sizeof(descriptorCommon[0]); j++)
+            children[descriptorOwners[i]][descriptorCommon[j]] = true;
+
+    for(size_t i = 0; i < sizeof(segmentOwners) / sizeof(segmentOwners[0]); i++)
+        for(size_t j = 0; j < sizeof(segmentBases) / sizeof(segmentBases[0]); j++)
+            children[segmentOwners[i]][segmentBases[j]] = true;
+
+    for(size_t i = 0; i < sizeof(segmentBases) / sizeof(segmentBases[0]); i++)
+    {
+        children[segmentBases[i]][ElementInitialization]        = true;
+        children[segmentBases[i]][ElementRepresentationIndex]   = true;
+    }
+}
@@ -0,0 +1,194 @@
+/*
+ * MPDReader.h
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - libdash
+ *****************************************************************************/
+
+#ifndef MPDREADER_H_
+#define MPDREADER_H_
+
+#include "config.h"
+
+#include "Node.h"
+#include <libxml/xmlreader.h>
+#include "../helpers/Path.h"
+
+namespace dash
+{
+    namespace xml
+    {
+        /*
+         * One pass MPD parser: builds the dash::mpd object model straight
+         * from the libxml2 reader stream. Only the currently open elements
+         * are kept on a stack, element and attribute names are compared as
+         * pointers interned in the reader's dictionary, and a Node tree is
+         * only built for elements the object model does not describe, which
+         * end up as additional sub nodes as before.
+         *
+         * A reader can parse any number of documents: the libxml2 reader and
+         * its name dictionary are kept and reset for the next input, so a
+         * refresh only pays for the parse itself.
+         */
+        class MPDReader
+        {
+            public:
+                MPDReader           ();
+                virtual ~MPDReader  ();
+
+                dash::mpd::MPD*     Read    (const std::string &url);
+                /*
+                 * baseUrl is the URL the document was retrieved from; relative
+                 * BaseURLs resolve against its directory as for files.
+                 */
+                dash::mpd::MPD*     Read    (const uint8_t *data, size_t len, const std::string &baseUrl);
+                /*
+                 * Applies an MPD Patch document (ISO/IEC 23009-1 5.15) to mpd in
+                 * place. Supported are add (appending elements, or an attribute
+                 * through type="@name"), replace of attributes and remove of
+                 * Period, AdaptationSet, Representation, S, SegmentURL and Event
+                 * elements, selected by absolute paths of element names with
+                 * [@name='value'] or [n] predicates. Returns false if the patch
+                 * is not meant for mpd or needs anything else; mpd may then be
+                 * partially patched and has to be replaced by a full MPD.
+                 */
+                bool                Patch   (dash::mpd::MPD *mpd, const uint8_t *data, size_t len);
+
+            private:
+                enum Element
+                {
+                    ElementUnknown = 0,
+                    ElementMPD,
+                    ElementProgramInformation,
+                    ElementTitle,
+                    ElementSource,
+                    ElementCopyright,
+                    ElementBaseURL,
+                    ElementLocation,
+                    ElementPatchLocation,
+                    ElementServiceDescription,
+                    ElementScope,
+                    ElementLatency,
+                    ElementQualityLatency,
+                    ElementPlaybackRate,
+                    ElementOperatingQuality,
+                    ElementOperatingBandwidth,
+                    ElementInitializationSet,
+                    ElementInitializationGroup,
+                    ElementInitializationPresentation,
+                    ElementContentProtection,
+                    ElementPeriod,
+                    ElementMetrics,
+                    ElementReporting,
+                    ElementRange,
+                    ElementEssentialProperty,
+                    ElementSupplementalProperty,
+                    ElementUTCTiming,
+                    ElementLeapSecondInformation,
+                    ElementAdaptationSet,
+                    ElementSubset,
+                    ElementGroupLabel,
+                    ElementLabel,
+                    ElementPreselection,
+                    ElementAssetIdentifier,
+                    ElementEventStream,
+                    ElementInbandEventStream,
+                    ElementEvent,
+                    ElementSegmentBase,
+                    ElementSegmentList,
+                    ElementSegmentTemplate,
+                    ElementSegmentTimeline,
+                    ElementS,
+                    ElementSegmentURL,
+                    ElementInitialization,
+                    ElementRepresentationIndex,
+                    ElementBitstreamSwitching,
+                    ElementFailoverContent,
+                    ElementFCS,
+                    ElementRepresentation,
+                    ElementSubRepresentation,
+                    ElementExtendedBandwidth,
+                    ElementModelPair,
+                    ElementContentComponent,
+                    ElementAccessibility,
+                    ElementRole,
+                    ElementRating,
+                    ElementViewpoint,
+                    ElementFramePacking,
+                    ElementAudioChannelConfiguration,
+                    ElementOutputProtection,
+                    ElementSwitching,
+                    ElementRandomAccess,
+                    ElementContentPopularityRate,
+                    ElementPR,
+                    ElementProducerReferenceTime,
+                    ElementResync,
+                    ElementCount
+                };
+                struct Attribute
+                {
+                    const xmlChar   *name;
+                    std::string     value;
+                };
+                struct Frame
+                {
+                    Element                             element;
+                    void                                *object;
+                    dash::mpd::AbstractMPDElement       *base;
+                    dash::mpd::RepresentationBase       *representationBase;
+                    dash::mpd::SegmentBase              *segmentBase;
+                    dash::mpd::MultipleSegmentBase      *multipleSegmentBase;
+                    Node                                *node;
+                    std::vector<Attribute>              attributes;
+                    std::string                         text;
+                    bool                                hasText;
+                };
+
+                xmlTextReaderPtr                            reader;
+                dash::mpd::MPD                              *root;
+                std::string                                 mpdPath;
+                std::vector<Frame>                          frames;
+                size_t                                      depth;
+                std::map<const xmlChar *, Element>          elements;
+                std::map<const char *, const xmlChar *>     literals;
+
+                static bool     children[ElementCount][ElementCount];
+
+                static void             InitChildren    ();
+                void                    InitNames       ();
+                const xmlChar*          Intern          (const char *name);
+                const xmlChar*          CurrentName     ();
+                Element                 Lookup          (Element parent, const xmlChar *name);
+                const std::string*      Find            (const Frame &frame, const char *name);
+
+                bool                    Reset           (const uint8_t *data, size_t len, const std::string &url);
+                dash::mpd::MPD*         Parse           (const std::string &url);
+                dash::mpd::MPD*         Process         ();
+                bool                    ProcessPatch    (dash::mpd::MPD *mpd);
+                bool                    ProcessFragment (const Frame &target);
+                void                    StartElement    ();
+                void                    EndElement      ();
+                void                    AddText         ();
+                void                    Create          (Frame &frame);
+                void                    Bind            (Frame &frame);
+                void                    Apply           (Frame &frame);
+                void                    Finish          (Frame &frame);
+                void                    Attach          (Frame &parent, Frame &child);
+
+                std::string             ReadAttribute   (const char *name);
+                std::string             ReadText        ();
+                bool                    Select          (dash::mpd::MPD *mpd, const std::string &path, Frame &parent, Frame &target, std::string &attribute);
+                bool                    Children        (const Frame &parent, Element element, std::vector<Frame> &children);
+                void                    AddChild        (std::vector<Frame> &children, Element element, void *object);
+                bool                    Matches         (const Frame &frame, const std::string &predicate);
+                void                    SetAttribute    (const Frame &parent, const Frame &target, const std::string &name, const std::string &value);
+                bool                    Remove          (const Frame &parent, const Frame &target);
+
+                void    SetCommonValuesForRep   (Frame &frame, dash::mpd::RepresentationBase &object);
+                void    SetCommonValuesForDesc  (Frame &frame, dash::mpd::Descriptor &object);
+                void    SetCommonValuesForSeg   (Frame &frame, dash::mpd::SegmentBase &object);
+                void    SetCommonValuesForMSeg  (Frame &frame, dash::mpd::MultipleSegmentBase &object);
+        };
+    }
+}
+
+#endif /* MPDREADER_H_ */
@@ -461,7 +461,7 @@ dash::mpd::SubRepresentation*               Node::ToSubRepresentation   ()  cons
     }
     for (size_t i = 0; i < subNodes.size(); i++)
     {
-        if (subNodes.at(i)->GetName() != "FramePacking" && subNodes.at(i)->GetName() != "AudioChannelConfiguration" && subNodes.at(i)->GetName() != "ContentProtection")
+        if (!IsCommonRepElement(subNodes.at(i)->GetName()))
             subRepresentation->AddAdditionalSubNode((xml::INode *) new Node(*(subNodes.at(i))));
     }
 
@@ -581,7 +581,7 @@ dash::mpd::Representation*                  Node::ToRepresentation      ()  cons
             representation->SetSegmentTemplate(subNodes.at(i)->ToSegmentTemplate());
             continue;
         }
-        if (subNodes.at(i)->GetName() != "FramePacking" && subNodes.at(i)->GetName() != "AudioChannelConfiguration" && subNodes.at(i)->GetName() != "ContentProtection")
+        if (!IsCommonRepElement(subNodes.at(i)->GetName()))
             representation->AddAdditionalSubNode((xml::INode *) new Node(*(subNodes.at(i))));
     }
 
@@ -673,7 +673,7 @@ dash::mpd::AdaptationSet*                   Node::ToAdaptationSet       ()  cons
     }
     if (this->HasAttribute("subsegmentStartsWithSAP"))
     {
-        adaptationSet->SetMaxHeight((uint8_t) strtoul(this->GetAttributeValue("subsegmentStartsWithSAP").c_str(), NULL, 10));
+        adaptationSet->SetSubsegmentStartsWithSAP((uint8_t) strtoul(this->GetAttributeValue("subsegmentStartsWithSAP").c_str(), NULL, 10));
     }
     if (this->HasAttribute("bitstreamSwitching"))
     {
@@ -740,7 +740,7 @@ dash::mpd::AdaptationSet*                   Node::ToAdaptationSet       ()  cons
             adaptationSet->AddRepresentation(subNodes.at(i)->ToRepresentation());
             continue;
         }
-        if (subNodes.at(i)->GetName() != "FramePacking" && subNodes.at(i)->GetName() != "AudioChannelConfiguration" && subNodes.at(i)->GetName() != "ContentProtection")
+        if (!IsCommonRepElement(subNodes.at(i)->GetName()))
             adaptationSet->AddAdditionalSubNode((xml::INode *) new Node(*(subNodes.at(i))));
     }
 
@@ -1772,6 +1772,14 @@ void                                        Node::SetType               (int typ
 {
     this->type = type;
 }
+bool                                        Node::IsCommonRepElement    (const std::string &name)
+{
+    /* SetCommonValuesForRep() converts these, so they are no additional sub nodes */
+    return name == "FramePacking" || name == "AudioChannelConfiguration" || name == "ContentProtection" ||
+           name == "OutputProtection" || name == "EssentialProperty" || name == "SupplementalProperty" ||
+           name == "InbandEventStream" || name == "Switching" || name == "RandomAccess" || name == "GroupLabel" ||
+           name == "Label" || name == "ContentPopularityRate" || name == "ProducerReferenceTime" || name == "Resync";
+}
 void                                        Node::SetCommonValuesForRep (dash::mpd::RepresentationBase& object) const
 {
     std::vector<Node *> subNodes = this->GetSubNodes();
@@ -101,6 +101,7 @@ namespace dash
             private:
                 void                                        SetCommonValuesForDesc  (dash::mpd::Descriptor& object) const;
                 void                                        SetCommonValuesForRep   (dash::mpd::RepresentationBase& object) const;
+                static bool                                 IsCommonRepElement      (const std::string &name);
                 void                                        SetCommonValuesForSeg   (dash::mpd::SegmentBase& object) const;
                 void                                        SetCommonValuesForMSeg  (dash::mpd::MultipleSegmentBase& object) const;
                 dash::mpd::AdaptationSet*                   ToAdaptationSet         ()  const;
@@ -0,0 +1,484 @@
+/*
+ * mpd_bench.cpp
+ *****************************************************************************
+ * MCNL-ARstreaming Capstone Project - MPD parser benchmark
+ *
+ * Usage: mpd_bench [MPD] [options]
+ *
+ *   --segments=        SegmentURLs per representation of the generated MPD
+ *                      (default 5000), ignored when an MPD file is given
+ *   --representations= representations of the generated MPD (default 3)
+ *   --runs=            parses per parser, the best one is reported (default 5)
+ *
+ * Without an MPD argument a manifest shaped like the ones written by
+ * server/createContent.sh is generated to a temporary file. Each parser turns
+ * it into a dash::mpd::MPD; reported are the wall time and the peak of the
+ * heap bytes held through operator new and the libxml2 allocator. The bench
+ * fails unless both parsers build the same tree, compared as a dump of every
+ * element's attributes and children.
+ *****************************************************************************/
+
+#include "xml/DOMParser.h"
+#include "xml/MPDReader.h"
+
+#include <libxml/xmlmemory.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dash::mpd;
+using namespace std;
+
+/* Every allocation carries its size in front so frees can be accounted */
+static const size_t HEADER_SIZE = 16;
+
+static size_t heap_bytes = 0;
+static size_t heap_peak = 0;
+
+static void * counted_malloc(size_t size)
+{
+	unsigned char *block = (unsigned char *) malloc(size + HEADER_SIZE);
+	if(block == 0x0)
+		return 0x0;
+
+	*(size_t *) block = size;
+	heap_bytes += size;
+	if(heap_bytes > heap_peak)
+		heap_peak = heap_bytes;
+
+	return block + HEADER_SIZE;
+}
+static void counted_free(void *data)
+{
+	if(data == 0x0)
+		return;
+
+	unsigned char *block = (unsigned char *) data - HEADER_SIZE;
+	heap_bytes -= *(size_t *) block;
+	free(block);
+}
+static void * counted_realloc(void *data, size_t size)
+{
+	if(data == 0x0)
+		return counted_malloc(size);
+
+	unsigned char *block = (unsigned char *) data - HEADER_SIZE;
+	size_t old = *(size_t *) block;
+
+	block = (unsigned char *) realloc(block, size + HEADER_SIZE);
+	if(block == 0x0)
+		return 0x0;
+
+	*(size_t *) block = size;
+	heap_bytes = heap_bytes - old + size;
+	if(heap_bytes > heap_peak)
+		heap_peak = heap_bytes;
+
+	return block + HEADER_SIZE;
+}
+static char * counted_strdup(const char *string)
+{
+	size_t size = strlen(string) + 1;
+	char *copy = (char *) counted_malloc(size);
+	if(copy != 0x0)
+		memcpy(copy, string, size);
+
+	return copy;
+}
+
+void * operator new(size_t size)
+{
+	void *data = counted_malloc(size);
+	if(data == 0x0)
+		throw bad_alloc();
+
+	return data;
+}
+void * operator new[](size_t size)
+{
+	return operator new(size);
+}
+void operator delete(void *data) noexcept
+{
+	counted_free(data);
+}
+void operator delete[](void *data) noexcept
+{
+	counted_free(data);
+}
+void operator delete(void *data, size_t) noexcept
+{
+	counted_free(data);
+}
+void operator delete[](void *data, size_t) noexcept
+{
+	counted_free(data);
+}
+
+static bool write_mpd(const string &path, size_t representations, size_t segments)
+{
+	static const char *names[] = { "high", "mid", "low" };
+	ofstream mpd(path.c_str());
+	if(!mpd)
+		return false;
+
+	mpd << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+		<< "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\" minBufferTime=\"PT0H0M1.0000S\" type=\"static\""
+		<< " mediaPresentationDuration=\"PT0H0M" << segments << "S\" maxSegmentDuration=\"PT0H0M1.0000S\""
+		<< " profiles=\"urn:mpeg:dash:profile:full:2011\">\n"
+		<< "  <BaseURL>./</BaseURL>\n"
+		<< "    <Period duration=\"PT0H0M" << segments << "S\">\n"
+		<< "      <AdaptationSet sgmentAlignment=\"true\" maxWidth=\"1024\" maxHeight=\"1024\" maxFrameRate=\"30\">\n";
+
+	for(size_t r = 0 ; r < representations ; r++) {
+		string name = r < 3 ? names[r] : "r" + to_string(r);
+
+		mpd << "    \t  <Representation id=\"" << r << "\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\""
+			<< " height=\"1024\" frameRate=\"30\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"" << (representations - r) * 10000000 << "\">\n"
+			<< "\t\t\t<SegmentBase>\n"
+			<< "\t\t\t  <Initialization sourceURL=\"" << name << "/content_" << name << "_init.mp4\"/>\n"
+			<< "\t\t\t</SegmentBase>\n"
+			<< "\t\t\t<SegmentList duration=\"1.0000\">\n";
+		for(size_t s = 1 ; s <= segments ; s++)
+			mpd << "\t\t\t  <SegmentURL media=\"" << name << "/" << name << "_s" << s << ".bin\"/>\n";
+		mpd << "\t\t\t</SegmentList>\n"
+			<< "\t\t  </Representation>\n";
+	}
+
+	mpd << "      </AdaptationSet>\n"
+		<< "    </Period>\n"
+		<< "</MPD>\n";
+
+	return (bool) mpd;
+}
+
+static MPD * parse_dom(const string &path)
+{
+	dash::xml::DOMParser parser(path);
+	if(!parser.Parse())
+		return 0x0;
+
+	return parser.GetRootNode()->ToMPD();
+}
+
+static MPD * parse_reader(const string &path)
+{
+	dash::xml::MPDReader reader;
+
+	return reader.Read(path);
+}
+
+static size_t count_segments(MPD *mpd)
+{
+	size_t count = 0;
+
+	for(size_t p = 0 ; p < mpd->GetPeriods().size() ; p++) {
+		IPeriod *period = mpd->GetPeriods().at(p);
+		for(size_t a = 0 ; a < period->GetAdaptationSets().size() ; a++) {
+			IAdaptationSet *adaptationSet = period->GetAdaptationSets().at(a);
+			for(size_t r = 0 ; r < adaptationSet->GetRepresentation().size() ; r++) {
+				ISegmentList *segmentList = adaptationSet->GetRepresentation().at(r)->GetSegmentList();
+				if(segmentList != 0x0)
+					count += segmentList->GetSegmentURLs().size();
+			}
+		}
+	}
+
+	return count;
+}
+
+/* One line per element: its name, the raw attributes (sorted, they are a map) and unknown children */
+static void dump_element(ostream &out, int depth, const string &name, const IMPDElement *element)
+{
+	out << string(depth * 2, ' ') << name;
+	if(element == 0x0) {
+		out << " -\n";
+		return;
+	}
+
+	map<string, string> attributes = element->GetRawAttributes();
+	for(map<string, string>::const_iterator it = attributes.begin() ; it != attributes.end() ; it++)
+		out << " " << it->first << "=\"" << it->second << "\"";
+
+	vector<dash::xml::INode *> nodes = element->GetAdditionalSubNodes();
+	for(size_t i = 0 ; i < nodes.size() ; i++)
+		out << " <" << nodes.at(i)->GetName() << ">";
+
+	out << "\n";
+}
+
+template <typename T>
+static void dump_list(ostream &out, int depth, const string &name, const vector<T *> &elements)
+{
+	for(size_t i = 0 ; i < elements.size() ; i++)
+		dump_element(out, depth, name, elements.at(i));
+}
+
+static void dump_base_urls(ostream &out, int depth, const vector<IBaseUrl *> &urls)
+{
+	for(size_t i = 0 ; i < urls.size() ; i++) {
+		dump_element(out, depth, "BaseURL", urls.at(i));
+		out << string(depth * 2 + 2, ' ') << urls.at(i)->GetUrl() << "\n";
+	}
+}
+
+static void dump_timeline(ostream &out, int depth, const ISegmentTimeline *timeline)
+{
+	if(timeline == 0x0)
+		return;
+
+	dump_element(out, depth, "SegmentTimeline", timeline);
+	for(size_t i = 0 ; i < timeline->GetTimelines().size() ; i++) {
+		ITimeline *s = timeline->GetTimelines().at(i);
+		dump_element(out, depth + 1, "S", s);
+		out << string(depth * 2 + 4, ' ') << s->GetStartTime() << " " << s->GetDuration() << " " << s->GetRepeatCount() << "\n";
+	}
+}
+
+static void dump_segment_base(ostream &out, int depth, const string &name, const ISegmentBase *base)
+{
+	dump_element(out, depth, name, base);
+	if(base == 0x0)
+		return;
+
+	out << string(depth * 2 + 2, ' ') << base->GetTimescale() << " " << base->GetPresentationTimeOffset()
+		<< " " << base->GetIndexRange() << "\n";
+	dump_element(out, depth + 1, "Initialization", base->GetInitialization());
+	dump_element(out, depth + 1, "RepresentationIndex", base->GetRepresentationIndex());
+}
+
+static void dump_multiple_segment_base(ostream &out, int depth, const string &name, const IMultipleSegmentBase *base)
+{
+	dump_segment_base(out, depth, name, base);
+	if(base == 0x0)
+		return;
+
+	out << string(depth * 2 + 2, ' ') << base->GetDuration() << " " << base->GetStartNumber() << " " << base->GetEndNumber() << "\n";
+	dump_timeline(out, depth + 1, base->GetSegmentTimeline());
+}
+
+static void dump_segments(ostream &out, int depth, ISegmentBase *base, ISegmentList *list, ISegmentTemplate *segmentTemplate)
+{
+	if(base != 0x0)
+		dump_segment_base(out, depth, "SegmentBase", base);
+
+	if(list != 0x0) {
+		dump_multiple_segment_base(out, depth, "SegmentList", list);
+		for(size_t i = 0 ; i < list->GetSegmentURLs().size() ; i++) {
+			ISegmentURL *url = list->GetSegmentURLs().at(i);
+			dump_element(out, depth + 1, "SegmentURL", url);
+			out << string(depth * 2 + 4, ' ') << url->GetMediaURI() << " " << url->GetMediaRange() << "\n";
+		}
+	}
+
+	if(segmentTemplate != 0x0) {
+		dump_multiple_segment_base(out, depth, "SegmentTemplate", segmentTemplate);
+		out << string(depth * 2 + 2, ' ') << segmentTemplate->Getmedia() << " " << segmentTemplate->Getinitialization() << "\n";
+	}
+}
+
+static void dump_representation_base(ostream &out, int depth, const IRepresentationBase *base)
+{
+	out << string(depth * 2, ' ') << base->GetMimeType() << " " << base->GetWidth() << "x" << base->GetHeight()
+		<< " " << base->GetFrameRate() << " " << base->GetCodecs().size() << " codecs\n";
+	dump_list(out, depth, "FramePacking", base->GetFramePacking());
+	dump_list(out, depth, "AudioChannelConfiguration", base->GetAudioChannelConfiguration());
+	dump_list(out, depth, "ContentProtection", base->GetContentProtections());
+	dump_list(out, depth, "EssentialProperty", base->GetEssentialProperties());
+	dump_list(out, depth, "SupplementalProperty", base->GetSupplementalProperties());
+	dump_list(out, depth, "EventStream", base->GetEventStreams());
+	dump_list(out, depth, "Label", base->GetLabels());
+}
+
+static string dump(MPD *mpd)
+{
+	ostringstream out;
+
+	dump_element(out, 0, "MPD", mpd);
+	out << "  " << mpd->GetType() << " " << mpd->GetMinBufferTime() << " " << mpd->GetMediaPresentationDuration() << "\n";
+	dump_list(out, 1, "ProgramInformation", mpd->GetProgramInformations());
+	dump_base_urls(out, 1, mpd->GetBaseUrls());
+	for(size_t i = 0 ; i < mpd->GetLocations().size() ; i++)
+		out << "  Location " << mpd->GetLocations().at(i) << "\n";
+	dump_list(out, 1, "PatchLocation", mpd->GetPatchLocations());
+	dump_list(out, 1, "ServiceDescription", mpd->GetServiceDescriptions());
+	dump_list(out, 1, "ContentProtection", mpd->GetContentProtections());
+	dump_list(out, 1, "EssentialProperty", mpd->GetEssentialProperties());
+	dump_list(out, 1, "SupplementalProperty", mpd->GetSupplementalProperties());
+	dump_list(out, 1, "UTCTiming", mpd->GetUTCTimings());
+	dump_list(out, 1, "Metrics", mpd->GetMetrics());
+
+	for(size_t p = 0 ; p < mpd->GetPeriods().size() ; p++) {
+		IPeriod *period = mpd->GetPeriods().at(p);
+		dump_element(out, 1, "Period", period);
+		out << "    " << period->GetId() << " " << period->GetStart() << " " << period->GetDuration() << "\n";
+		dump_base_urls(out, 2, period->GetBaseURLs());
+		dump_segments(out, 2, period->GetSegmentBase(), period->GetSegmentList(), period->GetSegmentTemplate());
+		dump_list(out, 2, "EventStream", period->GetEventStreams());
+		dump_list(out, 2, "Subset", period->GetSubsets());
+		dump_list(out, 2, "SupplementalProperty", period->GetSupplementalProperties());
+
+		for(size_t a = 0 ; a < period->GetAdaptationSets().size() ; a++) {
+			IAdaptationSet *adaptationSet = period->GetAdaptationSets().at(a);
+			dump_element(out, 2, "AdaptationSet", adaptationSet);
+			out << "      " << adaptationSet->GetId() << " " << adaptationSet->GetMaxWidth() << "x" << adaptationSet->GetMaxHeight()
+				<< " " << adaptationSet->GetMaxFramerate() << " " << adaptationSet->GetSegmentAligment() << "\n";
+			dump_representation_base(out, 3, adaptationSet);
+			dump_list(out, 3, "Accessibility", adaptationSet->GetAccessibility());
+			dump_list(out, 3, "Role", adaptationSet->GetRole());
+			dump_list(out, 3, "Rating", adaptationSet->GetRating());
+			dump_list(out, 3, "Viewpoint", adaptationSet->GetViewpoint());
+			dump_list(out, 3, "ContentComponent", adaptationSet->GetContentComponent());
+			dump_base_urls(out, 3, adaptationSet->GetBaseURLs());
+			dump_segments(out, 3, adaptationSet->GetSegmentBase(), adaptationSet->GetSegmentList(), adaptationSet->GetSegmentTemplate());
+
+			for(size_t r = 0 ; r < adaptationSet->GetRepresentation().size() ; r++) {
+				IRepresentation *representation = adaptationSet->GetRepresentation().at(r);
+				dump_element(out, 3, "Representation", representation);
+				out << "        " << representation->GetId() << " " << representation->GetBandwidth() << "\n";
+				dump_representation_base(out, 4, representation);
+				dump_base_urls(out, 4, representation->GetBaseURLs());
+				dump_list(out, 4, "SubRepresentation", representation->GetSubRepresentations());
+				dump_segments(out, 4, representation->GetSegmentBase(), representation->GetSegmentList(), representation->GetSegmentTemplate());
+			}
+		}
+	}
+
+	return out.str();
+}
+
+static bool same_trees(const string &path)
+{
+	MPD *dom = parse_dom(path);
+	MPD *reader = parse_reader(path);
+	bool same = false;
+
+	if(dom == 0x0 || reader == 0x0) {
+		cerr << "cannot parse " << path << "\n";
+	} else {
+		string domDump = dump(dom);
+		string readerDump = dump(reader);
+		same = domDump == readerDump;
+
+		if(!same) {
+			/* report the first line that differs */
+			istringstream domLines(domDump), readerLines(readerDump);
+			string domLine, readerLine;
+			for(size_t line = 1 ; ; line++) {
+				bool moreDom = (bool) getline(domLines, domLine);
+				bool moreReader = (bool) getline(readerLines, readerLine);
+				if(!moreDom && !moreReader)
+					break;
+				if(!moreDom || !moreReader || domLine != readerLine) {
+					cerr << "dom and reader trees differ at line " << line << ":\n"
+						<< "  dom:    " << (moreDom ? domLine : "(end)") << "\n"
+						<< "  reader: " << (moreReader ? readerLine : "(end)") << "\n";
+					break;
+				}
+			}
+		}
+	}
+
+	delete dom;
+	delete reader;
+
+	return same;
+}
+
+static bool run(const char *name, MPD * (*parse)(const string &), const string &path, int runs)
+{
+	double best = 0;
+	size_t peak = 0;
+	size_t segments = 0;
+
+	for(int i = 0 ; i < runs ; i++) {
+		size_t base = heap_bytes;
+		heap_peak = heap_bytes;
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		MPD *mpd = parse(path);
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+		if(mpd == 0x0) {
+			cerr << name << ": cannot parse " << path << "\n";
+			return false;
+		}
+		if(i == 0 || elapsed.count() < best)
+			best = elapsed.count();
+		if(heap_peak - base > peak)
+			peak = heap_peak - base;
+
+		segments = count_segments(mpd);
+		delete mpd;
+	}
+
+	cout << left << setw(12) << name
+		<< right << fixed << setprecision(2) << setw(12) << best * 1000
+		<< setprecision(1) << setw(14) << peak / (1024.0 * 1024.0)
+		<< setw(12) << segments << "\n";
+
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	string path;
+	size_t segments = 5000;
+	size_t representations = 3;
+	int runs = 5;
+
+	for(int i = 1 ; i < argc ; i++) {
+		string arg = argv[i];
+		size_t eq = arg.find('=');
+		string key = arg.substr(0, eq);
+		string value = eq == string::npos ? "" : arg.substr(eq + 1);
+
+		if(key == "--segments") segments = atoi(value.c_str());
+		else if(key == "--representations") representations = atoi(value.c_str());
+		else if(key == "--runs") runs = atoi(value.c_str());
+		else if(arg.compare(0, 2, "--") != 0 && path.empty()) path = arg;
+		else {
+			cerr << "usage: mpd_bench [MPD] [--segments=N] [--representations=N] [--runs=N]\n";
+			return 1;
+		}
+	}
+	if(runs < 1)
+		runs = 1;
+
+	// Must be in place before libxml2 allocates anything
+	xmlMemSetup(counted_free, counted_malloc, counted_realloc, counted_strdup);
+	xmlInitParser();
+
+	bool generated = path.empty();
+	if(generated) {
+		path = "/tmp/mpd_bench_" + to_string(segments) + ".mpd";
+		if(!write_mpd(path, representations, segments)) {
+			cerr << "cannot write " << path << "\n";
+			return 1;
+		}
+	}
+
+	cout << left << setw(12) << "parser"
+		<< right << setw(12) << "best ms" << setw(14) << "peak MiB" << setw(12) << "segments" << "\n";
+
+	bool ok = run("dom", parse_dom, path, runs) && run("reader", parse_reader, path, runs);
+	if(ok) {
+		ok = same_trees(path);
+		cout << (ok ? "trees equal\n" : "trees DIFFER\n");
+	}
+
+	if(generated)
+		remove(path.c_str());
+
+	return ok ? 0 : 1;
+}
@@ -205,7 +205,7 @@ echo "    <Period duration=\"$presentation_dur\">" >> $STREAM_PATH/$CONTENTS_NAM
 echo "      <AdaptationSet sgmentAlignment=\"true\" maxWidth=\"1024\" maxHeight=\"1024\" maxFrameRate=\"30\">" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 
 ## HIGH ##
-echo "    	  <Representation id=\"0\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\" height=\"1024\" framRate=\"$FPS\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"$HIGH_BANDWIDTH\">" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
+echo "    	  <Representation id=\"0\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\" height=\"1024\" frameRate=\"$FPS\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"$HIGH_BANDWIDTH\">" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "			<SegmentBase>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 
 echo "			  <Initialization sourceURL=\"high/${CONTENTS_NAME}_high_init.mp4\"/>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
@@ -221,7 +221,7 @@ echo "			</SegmentList>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "		  </Representation>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 
 ## MID ##
-echo "    	  <Representation id=\"1\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\" height=\"1024\" framRate=\"$FPS\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"$MID_BANDWIDTH\">" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
+echo "    	  <Representation id=\"1\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\" height=\"1024\" frameRate=\"$FPS\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"$MID_BANDWIDTH\">" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "			<SegmentBase>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "			  <Initialization sourceURL=\"mid/${CONTENTS_NAME}_mid_init.mp4\"/>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "			</SegmentBase>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
@@ -236,7 +236,7 @@ echo "			</SegmentList>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "		  </Representation>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 
 ## LOW ##
-echo "    	  <Representation id=\"2\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\" height=\"1024\" framRate=\"$FPS\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"$LOW_BANDWIDTH\">" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
+echo "    	  <Representation id=\"2\" mimeType=\"video/mp4\" codecs=\"avc1.d44020\" width=\"1024\" height=\"1024\" frameRate=\"$FPS\" sar=\"1:1\" startWithSAP=\"1\" bandwidth=\"$LOW_BANDWIDTH\">" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "			<SegmentBase>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "			  <Initialization sourceURL=\"low/${CONTENTS_NAME}_low_init.mp4\"/>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
 echo "			</SegmentBase>" >> $STREAM_PATH/$CONTENTS_NAME/$CONTENTS_NAME.mpd
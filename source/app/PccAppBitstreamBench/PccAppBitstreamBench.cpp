@@ -0,0 +1,157 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include <chrono>
+#include <random>
+#include "PCCBitstreamCommon.h"
+#include "PCCHighLevelSyntax.h"
+#include "PCCBitstream.h"
+#include "PCCBitstreamReader.h"
+
+using namespace std;
+using namespace pcc;
+
+// Times the parsing of the atlas sub-bitstreams of V3C bitstreams and checks on the same data
+// that PCCBitstream reads and writes the bits exactly as a plain bit by bit implementation.
+
+void usage() {
+  printf( "Usage: ./PccAppBitstreamBench <iterations> <filename> [<filename> ...] \n" );
+  printf( "      <iterations>: number of times the atlas data of each file is parsed \n" );
+  printf( "      <filename>  : path to a compressed PCC bitstream \n" );
+  exit( -1 );
+}
+
+static uint32_t referenceRead( const std::vector<uint8_t>& data, uint64_t& position, uint8_t bits ) {
+  uint32_t value = 0;
+  for ( size_t i = 0; i < bits; i++, position++ ) {
+    uint32_t bit = ( position >> 3 ) < data.size() ? ( data[position >> 3] >> ( 7 - ( position & 7 ) ) ) & 1 : 0;
+    value        = ( value << 1 ) | bit;
+  }
+  return value;
+}
+
+static uint32_t referenceReadUvlc( const std::vector<uint8_t>& data, uint64_t& position ) {
+  uint32_t length = 0;
+  while ( referenceRead( data, position, 1 ) == 0 ) { length++; }
+  return referenceRead( data, position, length ) + ( 1 << length ) - 1;
+}
+
+// reads the data with random widths and exp-Golomb codes, then writes the bits read back
+static bool checkBits( std::vector<uint8_t>& data, std::mt19937& random ) {
+  PCCBitstream                              bitstream;
+  std::vector<std::pair<uint32_t, uint8_t>> codes;
+  uint64_t                                  position = 0;
+  bitstream.initialize( data );
+  while ( position < data.size() * 8 ) {
+    uint64_t start = position, peek = position;
+    if ( random() % 4 == 0 && referenceRead( data, peek, 32 ) != 0 ) {
+      if ( bitstream.readUvlc() != referenceReadUvlc( data, position ) ) { return false; }
+    } else {
+      uint8_t bits = random() % 33;
+      if ( bitstream.read( bits ) != referenceRead( data, position, bits ) ) { return false; }
+    }
+    auto current = bitstream.getPosition();
+    if ( current.bytes_ * 8 + current.bits_ != position ) { return false; }
+    while ( start < position ) {
+      uint8_t bits = static_cast<uint8_t>( std::min<uint64_t>( position - start, 32 ) );
+      codes.push_back( std::make_pair( referenceRead( data, start, bits ), bits ) );
+    }
+  }
+  PCCBitstream output;
+  output.initialize( 0 );
+  for ( auto& code : codes ) {
+    // bits above the code length must be ignored
+    uint32_t noise = code.second < 32 ? static_cast<uint32_t>( random() ) << code.second : 0;
+    output.write( code.first | noise, code.second );
+  }
+  if ( output.size() * 8 + output.getPosition().bits_ != position ) { return false; }
+  return std::equal( data.begin(), data.end(), output.vector().begin() );
+}
+
+static double parseAtlas( SampleStreamV3CUnit& ssvu, size_t iterations ) {
+  SampleStreamV3CUnit atlas;
+  for ( auto& unit : ssvu.getV3CUnit() ) {
+    if ( unit.getType() == V3C_VPS || unit.getType() == V3C_AD ) { atlas.addV3CUnit() = unit; }
+  }
+  std::chrono::duration<double> duration( 0 );
+  for ( size_t i = 0; i < iterations; i++ ) {
+    SampleStreamV3CUnit units = atlas;
+    PCCBitstreamStat    bitstreamStat;
+    auto                start = std::chrono::steady_clock::now();
+    while ( units.getV3CUnitCount() > 0 ) {
+      PCCBitstreamReader bitstreamReader;
+      PCCHighLevelSyntax context;
+      context.setBitstreamStat( bitstreamStat );
+      if ( bitstreamReader.decode( units, context ) == 0 ) { break; }
+    }
+    duration += std::chrono::steady_clock::now() - start;
+  }
+  return duration.count();
+}
+
+int benchPccBin( const std::string& filename, size_t iterations ) {
+  PCCBitstream bitstream;
+  if ( !bitstream.initialize( filename ) ) { return -1; }
+  SampleStreamV3CUnit ssvu;
+  pcc::PCCBitstreamReader::read( bitstream, ssvu );
+
+  std::mt19937 random( 1 );
+  size_t       atlasBytes = 0, mismatches = 0;
+  for ( auto& unit : ssvu.getV3CUnit() ) {
+    if ( unit.getType() == V3C_AD ) { atlasBytes += unit.getBitstream().capacity(); }
+    if ( !checkBits( unit.getBitstream().vector(), random ) ) { mismatches++; }
+  }
+  double seconds = parseAtlas( ssvu, iterations );
+  printf( "%s: %zu V3C units, %zu atlas bytes, %.3f ms per parse, %.2f MB/s, %s \n", filename.c_str(),
+          ssvu.getV3CUnitCount(), atlasBytes, 1000.0 * seconds / iterations,
+          seconds > 0 ? atlasBytes * iterations / seconds / 1e6 : 0.0,
+          mismatches == 0 ? "bit exact" : "MISMATCH" );
+  return mismatches == 0 ? 0 : -1;
+}
+
+int main( int argc, char* argv[] ) {
+  std::cout << "PccAppBitstreamBench v" << TMC2_VERSION_MAJOR << "." << TMC2_VERSION_MINOR << std::endl << std::endl;
+  if ( argc < 3 || atoi( argv[1] ) <= 0 ) { usage(); }
+  size_t iterations = atoi( argv[1] );
+  int    ret        = 0;
+  for ( int i = 2; i < argc; i++ ) {
+    if ( !exist( argv[i] ) ) {
+      printf( "File %s not exist \n", argv[i] );
+      usage();
+    }
+    if ( benchPccBin( argv[i], iterations ) != 0 ) { ret = -1; }
+  }
+  return ret;
+}
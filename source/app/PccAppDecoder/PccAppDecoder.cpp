@@ -149,6 +149,10 @@ bool parseParameters( int                       argc,
       decoderParams.nbThread_,
       decoderParams.nbThread_,
     "Number of thread used for parallel processing")
+    ( "parallelVideoDecoding",
+      decoderParams.parallelVideoDecoding_,
+      decoderParams.parallelVideoDecoding_,
+      "Decode the video sub-bitstreams of a GOF concurrently")
     ( "attributeTransferFilterType",
       decoderParams.attrTransferFilterType_,
       decoderParams.attrTransferFilterType_,
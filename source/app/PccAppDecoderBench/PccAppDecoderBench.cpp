@@ -0,0 +1,174 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include "PCCCommon.h"
+#include "PCCDecoder.h"
+#include "PCCContext.h"
+#include "PCCFrameContext.h"
+#include "PCCBitstream.h"
+#include "PCCGroupOfFrames.h"
+#include "PCCBitstreamReader.h"
+#include "PCCDecoderParameters.h"
+#include <chrono>
+
+using namespace std;
+using namespace pcc;
+
+// Decodes every GOF of V3C segments with parallelVideoDecoding off and on, reports the decode
+// time of each GOF in both modes, and checks that the reconstructed point clouds are identical.
+
+void usage() {
+  printf( "Usage: ./PccAppDecoderBench [--nbThread=<n>] [--runs=<n>] <filename> [<filename> ...] \n" );
+  printf( "      --nbThread : threads used by the decoder (default 1) \n" );
+  printf( "      --runs     : decodes per mode, the fastest one is reported (default 3) \n" );
+  printf( "      <filename> : path to a compressed PCC bitstream (segment) \n" );
+  exit( -1 );
+}
+
+static bool sameFrames( PCCGroupOfFrames& gof0, PCCGroupOfFrames& gof1 ) {
+  if ( gof0.getFrameCount() != gof1.getFrameCount() ) { return false; }
+  for ( size_t i = 0; i < gof0.getFrameCount(); i++ ) {
+    if ( gof0[i].getPositions() != gof1[i].getPositions() || gof0[i].getColor() != gof1[i].getColor() ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Decodes all the GOFs of the file, the reconstruction and decode time of each GOF are appended to
+// gofs and times.
+static int decodePccBin( const std::string&             filename,
+                         PCCDecoderParameters           params,
+                         std::vector<PCCGroupOfFrames>& gofs,
+                         std::vector<double>&           times ) {
+  PCCBitstream     bitstream;
+  PCCBitstreamStat bitstreamStat;
+  PCCLogger        logger;
+  logger.initilalize( removeFileExtension( filename ) + "_bench", false );
+  if ( !bitstream.initialize( filename ) ) { return -1; }
+  bitstreamStat.setHeader( bitstream.size() );
+  SampleStreamV3CUnit ssvu;
+  bitstreamStat.incrHeader( PCCBitstreamReader::read( bitstream, ssvu ) );
+  PCCDecoder decoder;
+  decoder.setLogger( logger );
+  decoder.setParameters( params );
+  while ( ssvu.getV3CUnitCount() > 0 ) {
+    PCCContext         context;
+    PCCBitstreamReader bitstreamReader;
+    context.setBitstreamStat( bitstreamStat );
+    if ( bitstreamReader.decode( ssvu, context ) == 0 ) { break; }
+    if ( context.checkProfile() != 0 ) { return -1; }
+    params.setReconstructionParameters( context.getVps().getProfileTierLevel().getProfileReconstructionIdc() );
+    decoder.setReconstructionParameters( params );
+    context.resizeAtlas( context.getVps().getAtlasCountMinus1() + 1 );
+    for ( uint32_t atlId = 0; atlId < context.getVps().getAtlasCountMinus1() + 1; atlId++ ) {
+      PCCGroupOfFrames reconstructs;
+      context.getAtlas( atlId ).allocateVideoFrames( context, 0 );
+      context.setAtlasIndex( atlId );
+      auto start = std::chrono::steady_clock::now();
+      if ( decoder.decode( context, reconstructs, atlId ) != 0 ) { return -1; }
+      std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+      gofs.push_back( std::move( reconstructs ) );
+      times.push_back( time.count() );
+    }
+  }
+  return 0;
+}
+
+int benchPccBin( const std::string& filename, const PCCDecoderParameters& params, size_t runs ) {
+  std::vector<PCCGroupOfFrames> gofs[2];
+  std::vector<double>           best[2];
+  for ( size_t run = 0; run < runs; run++ ) {
+    for ( size_t mode = 0; mode < 2; mode++ ) {
+      PCCDecoderParameters          modeParams = params;
+      std::vector<PCCGroupOfFrames> modeGofs;
+      std::vector<double>           times;
+      modeParams.parallelVideoDecoding_ = mode == 1;
+      if ( decodePccBin( filename, modeParams, modeGofs, times ) != 0 ) {
+        printf( "%s: decoding failed \n", filename.c_str() );
+        return -1;
+      }
+      if ( run == 0 ) {
+        gofs[mode] = std::move( modeGofs );
+        best[mode] = times;
+      }
+      for ( size_t i = 0; i < times.size() && i < best[mode].size(); i++ ) {
+        best[mode][i] = ( std::min )( best[mode][i], times[i] );
+      }
+    }
+  }
+  size_t mismatches = gofs[0].size() == gofs[1].size() ? 0 : 1;
+  double total[2]   = {0, 0};
+  for ( size_t i = 0; i < gofs[0].size() && i < gofs[1].size(); i++ ) {
+    bool same = sameFrames( gofs[0][i], gofs[1][i] );
+    printf( "%s: GOF %zu, %zu frames, serial %.3f ms, parallel %.3f ms, %.2fx, %s \n", filename.c_str(), i,
+            gofs[0][i].getFrameCount(), 1000.0 * best[0][i], 1000.0 * best[1][i],
+            best[1][i] > 0 ? best[0][i] / best[1][i] : 0.0, same ? "identical frames" : "MISMATCH" );
+    total[0] += best[0][i];
+    total[1] += best[1][i];
+    if ( !same ) { mismatches++; }
+  }
+  printf( "%s: %zu GOFs, serial %.3f ms, parallel %.3f ms, %.2fx, %s \n", filename.c_str(), gofs[0].size(),
+          1000.0 * total[0], 1000.0 * total[1], total[1] > 0 ? total[0] / total[1] : 0.0,
+          mismatches == 0 ? "identical frames" : "MISMATCH" );
+  return mismatches == 0 ? 0 : -1;
+}
+
+int main( int argc, char* argv[] ) {
+  std::cout << "PccAppDecoderBench v" << TMC2_VERSION_MAJOR << "." << TMC2_VERSION_MINOR << std::endl << std::endl;
+  PCCDecoderParameters params;
+  size_t               runs = 3;
+  std::vector<string>  filenames;
+  for ( int i = 1; i < argc; i++ ) {
+    std::string arg = argv[i];
+    if ( arg.compare( 0, 11, "--nbThread=" ) == 0 ) {
+      params.nbThread_ = (size_t)atoi( arg.c_str() + 11 );
+    } else if ( arg.compare( 0, 7, "--runs=" ) == 0 ) {
+      runs = (size_t)atoi( arg.c_str() + 7 );
+    } else {
+      filenames.push_back( arg );
+    }
+  }
+  if ( filenames.empty() || runs == 0 ) { usage(); }
+  int ret = 0;
+  for ( auto& filename : filenames ) {
+    if ( !exist( filename ) ) {
+      printf( "File %s not exist \n", filename.c_str() );
+      usage();
+    }
+    if ( benchPccBin( filename, params, runs ) != 0 ) { ret = -1; }
+  }
+  return ret;
+}
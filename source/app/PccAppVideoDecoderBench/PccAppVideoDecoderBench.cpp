@@ -0,0 +1,155 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include "PCCCommon.h"
+#include "PCCHighLevelSyntax.h"
+#include "PCCBitstream.h"
+#include "PCCBitstreamReader.h"
+#include "PCCVideo.h"
+#include "PCCVideoBitstream.h"
+#include "PCCVirtualVideoDecoder.h"
+#include <chrono>
+
+using namespace std;
+using namespace pcc;
+
+// Decodes the HEVC video sub-bitstreams of V3C segments twice, through the external HM decoder
+// (bitstream and reconstruction written to files, one process per sub-bitstream) and through the
+// HM library from memory, and reports the time per segment and whether the frames are identical.
+// The frame callback of the library decoder gives the time until the first frame of each
+// sub-bitstream is available.
+
+void usage() {
+  printf( "Usage: ./PccAppVideoDecoderBench <decoderPath> <filename> [<filename> ...] \n" );
+  printf( "      <decoderPath>: path to TAppDecoderStatic \n" );
+  printf( "      <filename>   : path to a compressed PCC bitstream (segment) \n" );
+  exit( -1 );
+}
+
+#if defined( USE_HMAPP_VIDEO_CODEC ) && defined( USE_HMLIB_VIDEO_CODEC )
+static bool sameFrames( PCCVideo<uint16_t, 3>& video0, PCCVideo<uint16_t, 3>& video1 ) {
+  if ( video0.getFrameCount() != video1.getFrameCount() ) { return false; }
+  for ( size_t i = 0; i < video0.getFrameCount(); i++ ) {
+    for ( size_t c = 0; c < 3; c++ ) {
+      if ( video0.getFrame( i ).computeMD5( c ) != video1.getFrame( i ).computeMD5( c ) ) { return false; }
+    }
+  }
+  return true;
+}
+
+static size_t outputBitDepth( PCCHighLevelSyntax& syntax, PCCVideoType type ) {
+  auto& vps = syntax.getVps();
+  if ( type == VIDEO_OCCUPANCY ) { return 8; }
+  if ( type < VIDEO_ATTRIBUTE ) { return vps.getGeometryInformation( 0 ).getGeometry2dBitdepthMinus1() + 1; }
+  return vps.getAttributeInformation( 0 ).getAttribute2dBitdepthMinus1( 0 ) + 1;
+}
+
+int benchPccBin( const std::string& filename, const std::string& decoderPath ) {
+  PCCBitstream bitstream;
+  if ( !bitstream.initialize( filename ) ) { return -1; }
+  SampleStreamV3CUnit ssvu;
+  PCCBitstreamStat    bitstreamStat;
+  pcc::PCCBitstreamReader::read( bitstream, ssvu );
+
+  auto                          appDecoder = PCCVirtualVideoDecoder<uint16_t>::create( HMAPP );
+  auto                          libDecoder = PCCVirtualVideoDecoder<uint16_t>::create( HMLIB );
+  std::chrono::duration<double> appTime( 0 ), libTime( 0 ), firstFrameTime( 0 );
+  size_t                        streams = 0, mismatches = 0;
+  while ( ssvu.getV3CUnitCount() > 0 ) {
+    PCCBitstreamReader bitstreamReader;
+    PCCHighLevelSyntax syntax;
+    syntax.setBitstreamStat( bitstreamStat );
+    if ( bitstreamReader.decode( ssvu, syntax ) == 0 ) { break; }
+    for ( size_t i = 0; i < syntax.getVideoBitstreamCount(); i++ ) {
+      auto& videoBitstream = syntax.getVideoBitstream( i );
+      if ( videoBitstream.size() == 0 ) { continue; }
+      videoBitstream.sampleStreamToByteStream();
+      size_t                bitDepth = outputBitDepth( syntax, videoBitstream.type() );
+      PCCVideo<uint16_t, 3> appVideo, libVideo;
+      auto                  start = std::chrono::steady_clock::now();
+      appDecoder->decode( videoBitstream, appVideo, bitDepth, decoderPath,
+                          removeFileExtension( filename ) + "_bench_" + videoBitstream.getExtension() );
+      size_t                                reported = 0;
+      std::chrono::steady_clock::time_point firstFrame;
+      libDecoder->setFrameCallback( [&]( PCCVideo<uint16_t, 3>&, size_t ) {
+        if ( reported++ == 0 ) { firstFrame = std::chrono::steady_clock::now(); }
+      } );
+      auto middle = std::chrono::steady_clock::now();
+      libDecoder->decode( videoBitstream.buffer(), videoBitstream.size(), libVideo, bitDepth );
+      auto end = std::chrono::steady_clock::now();
+      appTime += middle - start;
+      libTime += end - middle;
+      if ( reported > 0 ) { firstFrameTime += firstFrame - middle; }
+      streams++;
+      if ( reported != libVideo.getFrameCount() ) {
+        printf( "%s: %s %zu of %zu frames reported \n", filename.c_str(), videoBitstream.getExtension().c_str(),
+                reported, libVideo.getFrameCount() );
+        mismatches++;
+      }
+      if ( !sameFrames( appVideo, libVideo ) ) {
+        printf( "%s: %s frames differ \n", filename.c_str(), videoBitstream.getExtension().c_str() );
+        mismatches++;
+      }
+    }
+  }
+  printf( "%s: %zu video sub-bitstreams, app %.3f ms, library %.3f ms (first frames %.3f ms), %.2fx, %s \n",
+          filename.c_str(), streams, 1000.0 * appTime.count(), 1000.0 * libTime.count(),
+          1000.0 * firstFrameTime.count(),
+          libTime.count() > 0 ? appTime.count() / libTime.count() : 0.0,
+          mismatches == 0 ? "identical frames" : "MISMATCH" );
+  return mismatches == 0 ? 0 : -1;
+}
+#endif
+
+int main( int argc, char* argv[] ) {
+  std::cout << "PccAppVideoDecoderBench v" << TMC2_VERSION_MAJOR << "." << TMC2_VERSION_MINOR << std::endl
+            << std::endl;
+#if defined( USE_HMAPP_VIDEO_CODEC ) && defined( USE_HMLIB_VIDEO_CODEC )
+  if ( argc < 3 ) { usage(); }
+  std::string decoderPath = argv[1];
+  int         ret         = 0;
+  for ( int i = 2; i < argc; i++ ) {
+    if ( !exist( argv[i] ) ) {
+      printf( "File %s not exist \n", argv[i] );
+      usage();
+    }
+    if ( benchPccBin( argv[i], decoderPath ) != 0 ) { ret = -1; }
+  }
+  return ret;
+#else
+  printf( "PccAppVideoDecoderBench needs the HM application and library video codecs \n" );
+  return -1;
+#endif
+}
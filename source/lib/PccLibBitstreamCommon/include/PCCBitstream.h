@@ -287,15 +287,29 @@ class PCCBitstream {
     trace_                  = false;
 #endif
     uint32_t value = 0, code = 0, length = 0;
-    code = read( 1 );
-    if ( 0 == code ) {
-      length = 0;
-      while ( !( code & 1 ) ) {
-        code = read( 1 );
+    // the prefix zeros are counted in one 32-bit window, longer prefixes bit by bit
+    uint32_t prefix = peek( 32, position_ );
+    if ( prefix & 0x80000000 ) {
+      read( 1, position_ );
+    } else if ( prefix != 0 ) {
+      while ( !( prefix & 0x80000000 ) ) {
+        prefix <<= 1;
         length++;
       }
-      value = read( length );
+      read( length + 1, position_ );
+      value = read( length, position_ );
       value += ( 1 << length ) - 1;
+    } else {
+      code = read( 1 );
+      if ( 0 == code ) {
+        length = 0;
+        while ( !( code & 1 ) ) {
+          code = read( 1 );
+          length++;
+        }
+        value = read( length );
+        value += ( 1 << length ) - 1;
+      }
     }
 #ifdef BITSTREAM_TRACE
     trace_ = traceStartingValue;
@@ -347,31 +361,46 @@ class PCCBitstream {
 #endif
  private:
   inline void realloc( const size_t size = 4096 ) { data_.resize( data_.size() + ( ( ( size / 4096 ) + 1 ) * 4096 ) ); }
-  inline uint32_t read( uint8_t bits, PCCBistreamPosition& pos ) {
-    uint32_t value = 0;
-    for ( size_t i = 0; i < bits; i++ ) {
-      value |= ( ( data_[pos.bytes_] >> ( 7 - pos.bits_ ) ) & 1 ) << ( bits - 1 - i );
-      if ( pos.bits_ == 7 ) {
-        pos.bytes_++;
-        pos.bits_ = 0;
-      } else {
-        pos.bits_++;
-      }
+  // up to 64 bits starting at byte pos, big-endian, zeros past the end of the buffer
+  inline uint64_t window( uint64_t pos ) {
+    const uint8_t* data = data_.data() + pos;
+    if ( pos + 8 <= data_.size() ) {
+      return ( (uint64_t)data[0] << 56 ) | ( (uint64_t)data[1] << 48 ) | ( (uint64_t)data[2] << 40 ) |
+             ( (uint64_t)data[3] << 32 ) | ( (uint64_t)data[4] << 24 ) | ( (uint64_t)data[5] << 16 ) |
+             ( (uint64_t)data[6] << 8 ) | (uint64_t)data[7];
+    }
+    uint64_t value = 0;
+    for ( size_t i = 0; i < 8; i++ ) {
+      value <<= 8;
+      if ( pos + i < data_.size() ) { value |= data[i]; }
     }
     return value;
   }
 
+  inline uint32_t peek( uint8_t bits, const PCCBistreamPosition& pos ) {
+    if ( bits == 0 ) { return 0; }
+    return static_cast<uint32_t>( ( window( pos.bytes_ ) << pos.bits_ ) >> ( 64 - bits ) );
+  }
+
+  // bits <= 32, so the bits never reach past the 64-bit window of the current byte
+  inline uint32_t read( uint8_t bits, PCCBistreamPosition& pos ) {
+    uint32_t value = peek( bits, pos );
+    uint64_t end   = pos.bits_ + bits;
+    pos.bytes_ += end >> 3;
+    pos.bits_ = static_cast<uint8_t>( end & 7 );
+    return value;
+  }
+
+  // ORs the bits into the buffer a byte at a time, as the buffer is zero filled
   inline void write( uint32_t value, uint8_t bits, PCCBistreamPosition& pos ) {
     if ( pos.bytes_ + bits + 16 >= data_.size() ) { realloc(); }
-    for ( size_t i = 0; i < bits; i++ ) {
-      data_[pos.bytes_] |= ( ( value >> ( bits - 1 - i ) ) & 1 ) << ( 7 - pos.bits_ );
-      if ( pos.bits_ == 7 ) {
-        pos.bytes_++;
-        pos.bits_ = 0;
-      } else {
-        pos.bits_++;
-      }
-    }
+    if ( bits == 0 ) { return; }
+    uint64_t end  = pos.bits_ + bits;
+    uint64_t code = ( static_cast<uint64_t>( value ) & ( ( static_cast<uint64_t>( 1 ) << bits ) - 1 ) ) << ( 64 - end );
+    uint8_t* data = data_.data() + pos.bytes_;
+    for ( size_t i = 0; i < ( end + 7 ) >> 3; i++ ) { data[i] |= static_cast<uint8_t>( code >> ( 56 - 8 * i ) ); }
+    pos.bytes_ += end >> 3;
+    pos.bits_ = static_cast<uint8_t>( end & 7 );
   }
 
   std::vector<uint8_t> data_;
@@ -10,8 +10,8 @@
 #define USE_HMAPP_VIDEO_CODEC
 #define USE_SHMAPP_VIDEO_CODEC
 #define USE_HMLIB_VIDEO_CODEC
-#define USE_JMLIB_VIDEO_CODEC
-#define USE_VTMLIB_VIDEO_CODEC
+/* #undef USE_JMLIB_VIDEO_CODEC */
+/* #undef USE_VTMLIB_VIDEO_CODEC */
 /* #undef USE_FFMPEG_VIDEO_CODEC */
 
 #define USE_HDRTOOLS
@@ -43,7 +43,9 @@ class PCCImage {
  public:
   PCCImage() : width_( 0 ), height_( 0 ), format_( PCCCOLORFORMAT::UNKNOWN ), deprecatedColorFormat_( 0 ) {}
   PCCImage( const PCCImage& ) = default;
+  PCCImage( PCCImage&& )      = default;
   PCCImage& operator=( const PCCImage& rhs ) = default;
+  PCCImage& operator=( PCCImage&& rhs )      = default;
   ~PCCImage()                                = default;
   std::vector<T>& operator[]( int index ) { return channels_[index]; }
 
@@ -43,7 +43,9 @@ class PCCPointSet3 {
  public:
   PCCPointSet3() : withNormals_( false ), withColors_( false ), withReflectances_( false ) {}
   PCCPointSet3( const PCCPointSet3& ) = default;
+  PCCPointSet3( PCCPointSet3&& )      = default;
   PCCPointSet3& operator=( const PCCPointSet3& rhs ) = default;
+  PCCPointSet3& operator=( PCCPointSet3&& rhs )      = default;
   ~PCCPointSet3()                                    = default;
 
   PCCPoint3D operator[]( const size_t index ) const {
@@ -625,209 +625,217 @@ void PCCCodec::generatePointCloud( PCCPointSet3&                       reconstru
   eomPointsPerPatch.resize( totalPatchCount );
   uint32_t   index;
   const bool patchPrecedenceOrderFlag = context.getAtlasSequenceParameterSet( 0 ).getPatchPrecedenceOrderFlag();
-  for ( index = 0; index < patches.size(); index++ ) {
-    patchIndex                     = ( bDecoder && patchPrecedenceOrderFlag ) ? ( totalPatchCount - index - 1 ) : index;
-    const size_t patchIndexPlusOne = patchIndex + 1;
-    auto&        patch             = patches[patchIndex];
-    PCCColor3B   color( uint8_t( 0 ) );
-    TRACE_CODEC(
-        "P%2lu/%2lu: 2D=(%2lu,%2lu)*(%2lu,%2lu) 3D(%4zu,%4zu,%4zu)*(%4zu,%4zu) A=(%zu,%zu,%zu) Or=%zu P=%zu => %zu "
-        "AxisOfAdditionalPlane = %zu \n",
-        patchIndex, totalPatchCount, patch.getU0(), patch.getV0(), patch.getSizeU0(), patch.getSizeV0(), patch.getU1(),
-        patch.getV1(), patch.getD1(), patch.getSizeU0() * patch.getOccupancyResolution(),
-        patch.getSizeV0() * patch.getOccupancyResolution(), patch.getNormalAxis(), patch.getTangentAxis(),
-        patch.getBitangentAxis(), patch.getPatchOrientation(), patch.getProjectionMode(), reconstruct.getPointCount(),
-        patch.getAxisOfAdditionalPlane() );
 
+  // The patches are reconstructed concurrently, each one into its own point set, and then copied at
+  // the prefix sum of the point counts of the patches before it, which gives the order of a serial walk.
+  std::vector<size_t>                          patchOrder( totalPatchCount );
+  std::vector<PCCColor3B>                      patchColors( totalPatchCount, PCCColor3B( uint8_t( 0 ) ) );
+  std::vector<PCCPointSet3>                    patchPoints( totalPatchCount );
+  std::vector<std::vector<PCCVector3<size_t>>> patchPointToPixel( totalPatchCount );
+  std::vector<uint8_t>                         patchSetsFirstPointType( totalPatchCount, 0 );
+  for ( index = 0; index < patches.size(); index++ ) {
+    patchIndex        = ( bDecoder && patchPrecedenceOrderFlag ) ? ( totalPatchCount - index - 1 ) : index;
+    patchOrder[index] = patchIndex;
+    auto& color       = patchColors[patchIndex];
     while ( color[0] == color[1] || color[2] == color[1] || color[2] == color[0] ) {
       color[0] = static_cast<uint8_t>( rand() % 32 ) * 8;
       color[1] = static_cast<uint8_t>( rand() % 32 ) * 8;
       color[2] = static_cast<uint8_t>( rand() % 32 ) * 8;
     }
-    for ( size_t v0 = 0; v0 < patch.getSizeV0(); ++v0 ) {
-      for ( size_t u0 = 0; u0 < patch.getSizeU0(); ++u0 ) {
-        const size_t blockIndex = patch.patchBlock2CanvasBlock( u0, v0, blockToPatchWidth, blockToPatchHeight );
-        if ( blockToPatch[blockIndex] == patchIndexPlusOne ) {
-          for ( size_t v1 = 0; v1 < patch.getOccupancyResolution(); ++v1 ) {
-            const size_t v = v0 * patch.getOccupancyResolution() + v1;
-            for ( size_t u1 = 0; u1 < patch.getOccupancyResolution(); ++u1 ) {
-              const size_t u = u0 * patch.getOccupancyResolution() + u1;
-              size_t       x;
-              size_t       y;
-              bool         occupancy     = false;
-              size_t       canvasIndex   = patch.patch2Canvas( u, v, tileWidth, tileHeight, x, y );
-              size_t       xInVideoFrame = x + tile.getLeftTopXInFrame();
-              size_t       yInVideoFrame = y + tile.getLeftTopYInFrame();
-              bool         isBoundary    = false;
-              if ( params.pbfEnableFlag_ ) {
-                occupancy = patch.getOccupancyMap( u, v ) != 0;
-                if ( occupancy ) { isBoundary = patch.isBorder( u, v ); }
-              } else {
-                occupancy = occupancyMap[canvasIndex] != 0;
-              }
-              if ( !occupancy ) { continue; }
-              if ( params.enhancedOccupancyMapCode_ ) {
-                // D0
-                PCCPoint3D point0 = patch.generatePoint( u, v, frame0.getValue( 0, xInVideoFrame, yInVideoFrame ) );
-                size_t     pointIndex0;  // = reconstruct.addPoint(point0);
-                if ( patch.getAxisOfAdditionalPlane() == 0 ) {
-                  pointIndex0 = reconstruct.addPoint( point0 );
+  }
+  tbb::task_arena limited( static_cast<int>( params.nbThread_ ) );
+  limited.execute( [&] {
+    tbb::parallel_for( size_t( 0 ), totalPatchCount, [&]( const size_t patchIndex ) {
+      const size_t patchIndexPlusOne = patchIndex + 1;
+      auto&        patch             = patches[patchIndex];
+      auto&        points            = patchPoints[patchIndex];
+      auto&        pixels            = patchPointToPixel[patchIndex];
+      const auto   color             = patchColors[patchIndex];
+      points.addColors();
+      for ( size_t v0 = 0; v0 < patch.getSizeV0(); ++v0 ) {
+        for ( size_t u0 = 0; u0 < patch.getSizeU0(); ++u0 ) {
+          const size_t blockIndex = patch.patchBlock2CanvasBlock( u0, v0, blockToPatchWidth, blockToPatchHeight );
+          if ( blockToPatch[blockIndex] == patchIndexPlusOne ) {
+            for ( size_t v1 = 0; v1 < patch.getOccupancyResolution(); ++v1 ) {
+              const size_t v = v0 * patch.getOccupancyResolution() + v1;
+              for ( size_t u1 = 0; u1 < patch.getOccupancyResolution(); ++u1 ) {
+                const size_t u = u0 * patch.getOccupancyResolution() + u1;
+                size_t       x;
+                size_t       y;
+                bool         occupancy     = false;
+                size_t       canvasIndex   = patch.patch2Canvas( u, v, tileWidth, tileHeight, x, y );
+                size_t       xInVideoFrame = x + tile.getLeftTopXInFrame();
+                size_t       yInVideoFrame = y + tile.getLeftTopYInFrame();
+                bool         isBoundary    = false;
+                if ( params.pbfEnableFlag_ ) {
+                  occupancy = patch.getOccupancyMap( u, v ) != 0;
+                  if ( occupancy ) { isBoundary = patch.isBorder( u, v ); }
                 } else {
-                  PCCVector3D tmp;
-                  inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(), params.geometryBitDepth3D_,
-                                                       point0, tmp );
-                  pointIndex0 = reconstruct.addPoint( tmp );
+                  occupancy = occupancyMap[canvasIndex] != 0;
                 }
-                reconstruct.setPointPatchIndex( pointIndex0, tileIndex, patchIndex );
-                reconstruct.setColor( pointIndex0, color );
-                if ( PCC_SAVE_POINT_TYPE == 1 ) { reconstruct.setType( pointIndex0, POINT_D0 ); }
-                partition.push_back( uint32_t( patchIndex ) );
-                pointToPixel.emplace_back( x, y, 0 );
-                uint16_t    eomCode = 0;
-                size_t      d1pos   = 0;
-                const auto& frame0  = params.multipleStreams_ ? videoGeometryMultiple[0].getFrame( videoFrameIndex )
-                                                             : videoGeometry.getFrame( videoFrameIndex );
-                const auto& indx = patch.patch2Canvas( u, v, tileWidth, tileHeight, x, y );
-                if ( params.mapCountMinus1_ > 0 ) {
-                  const auto& frame1 = params.multipleStreams_ ? videoGeometryMultiple[1].getFrame( videoFrameIndex )
-                                                               : videoGeometry.getFrame( videoFrameIndex + 1 );
-                  int16_t diff = params.absoluteD1_
-                                     ? ( static_cast<int16_t>( frame1.getValue( 0, xInVideoFrame, yInVideoFrame ) ) -
-                                         static_cast<int16_t>( frame0.getValue( 0, xInVideoFrame, yInVideoFrame ) ) )
-                                     : static_cast<int16_t>( frame1.getValue( 0, xInVideoFrame, yInVideoFrame ) );
-                  assert( diff >= 0 );
-                  // Convert occupancy map to eomCode
-                  if ( diff == 0 ) {
-                    eomCode = 0;
-                  } else if ( diff == 1 ) {
-                    d1pos   = 1;
-                    eomCode = 1;
-                  } else if ( diff > 0 ) {
-                    uint16_t bits = diff - 1;
-                    uint16_t symbol =
-                        ( 1 << bits ) - occupancyMap[patch.patch2Canvas( u, v, tileWidth, tileHeight, x, y )];
-                    eomCode = symbol | ( 1 << bits );
-                    d1pos   = ( bits );
+                if ( !occupancy ) { continue; }
+                if ( params.enhancedOccupancyMapCode_ ) {
+                  // D0
+                  PCCPoint3D point0 = patch.generatePoint( u, v, frame0.getValue( 0, xInVideoFrame, yInVideoFrame ) );
+                  size_t     pointIndex0;  // = points.addPoint(point0);
+                  if ( patch.getAxisOfAdditionalPlane() == 0 ) {
+                    pointIndex0 = points.addPoint( point0 );
+                  } else {
+                    PCCVector3D tmp;
+                    inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(), params.geometryBitDepth3D_,
+                                                         point0, tmp );
+                    pointIndex0 = points.addPoint( tmp );
                   }
-                } else {  // params.mapCountMinus1_ == 0
-                  eomCode = ( 1 << params.EOMFixBitCount_ ) - occupancyMap[indx];
-                }
-                PCCPoint3D point1( point0 );
-                if ( eomCode == 0 ) {
-                  if ( !params.removeDuplicatePoints_ ) {
-                    size_t pointIndex1;  // = reconstruct.addPoint(point1);
-                    if ( patch.getAxisOfAdditionalPlane() == 0 ) {
-                      pointIndex1 = reconstruct.addPoint( point1 );
-                    } else {
-                      PCCVector3D tmp;
-                      inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(), params.geometryBitDepth3D_,
-                                                           point1, tmp );
-                      pointIndex1 = reconstruct.addPoint( tmp );
+                  points.setPointPatchIndex( pointIndex0, tileIndex, patchIndex );
+                  points.setColor( pointIndex0, color );
+                  if ( PCC_SAVE_POINT_TYPE == 1 ) { points.setType( pointIndex0, POINT_D0 ); }
+                  pixels.emplace_back( x, y, 0 );
+                  uint16_t    eomCode = 0;
+                  size_t      d1pos   = 0;
+                  const auto& frame0  = params.multipleStreams_ ? videoGeometryMultiple[0].getFrame( videoFrameIndex )
+                                                               : videoGeometry.getFrame( videoFrameIndex );
+                  const auto& indx = patch.patch2Canvas( u, v, tileWidth, tileHeight, x, y );
+                  if ( params.mapCountMinus1_ > 0 ) {
+                    const auto& frame1 = params.multipleStreams_ ? videoGeometryMultiple[1].getFrame( videoFrameIndex )
+                                                                 : videoGeometry.getFrame( videoFrameIndex + 1 );
+                    int16_t diff = params.absoluteD1_
+                                       ? ( static_cast<int16_t>( frame1.getValue( 0, xInVideoFrame, yInVideoFrame ) ) -
+                                           static_cast<int16_t>( frame0.getValue( 0, xInVideoFrame, yInVideoFrame ) ) )
+                                       : static_cast<int16_t>( frame1.getValue( 0, xInVideoFrame, yInVideoFrame ) );
+                    assert( diff >= 0 );
+                    // Convert occupancy map to eomCode
+                    if ( diff == 0 ) {
+                      eomCode = 0;
+                    } else if ( diff == 1 ) {
+                      d1pos   = 1;
+                      eomCode = 1;
+                    } else if ( diff > 0 ) {
+                      uint16_t bits = diff - 1;
+                      uint16_t symbol =
+                          ( 1 << bits ) - occupancyMap[patch.patch2Canvas( u, v, tileWidth, tileHeight, x, y )];
+                      eomCode = symbol | ( 1 << bits );
+                      d1pos   = ( bits );
                     }
-                    reconstruct.setPointPatchIndex( pointIndex1, tileIndex, patchIndex );
-                    reconstruct.setColor( pointIndex1, color );
-                    if ( PCC_SAVE_POINT_TYPE == 1 ) { reconstruct.setType( pointIndex1, POINT_D1 ); }
-                    partition.push_back( uint32_t( patchIndex ) );
-                    pointToPixel.emplace_back( x, y, 1 );
-                  }
-                } else {  // eomCode != 0
-                  uint16_t addedPointCount = 0;
-                  size_t   pointIndex1     = 0;
-                  for ( uint16_t i = 0; i < 10; i++ ) {
-                    if ( ( eomCode & ( 1 << i ) ) != 0 ) { d1pos = i; }
+                  } else {  // params.mapCountMinus1_ == 0
+                    eomCode = ( 1 << params.EOMFixBitCount_ ) - occupancyMap[indx];
                   }
-                  for ( uint16_t i = 0; i < 10; i++ ) {
-                    if ( ( eomCode & ( 1 << i ) ) != 0 ) {
-                      uint8_t deltaDCur = ( i + 1 );
-                      if ( patch.getProjectionMode() == 0 ) {
-                        point1[patch.getNormalAxis()] =
-                            static_cast<double>( point0[patch.getNormalAxis()] + deltaDCur );
+                  PCCPoint3D point1( point0 );
+                  if ( eomCode == 0 ) {
+                    if ( !params.removeDuplicatePoints_ ) {
+                      size_t pointIndex1;  // = points.addPoint(point1);
+                      if ( patch.getAxisOfAdditionalPlane() == 0 ) {
+                        pointIndex1 = points.addPoint( point1 );
                       } else {
-                        point1[patch.getNormalAxis()] =
-                            static_cast<double>( point0[patch.getNormalAxis()] - deltaDCur );
+                        PCCVector3D tmp;
+                        inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(),
+                                                             params.geometryBitDepth3D_, point1, tmp );
+                        pointIndex1 = points.addPoint( tmp );
                       }
-                      if ( ( eomCode == 1 || i == d1pos ) && ( params.mapCountMinus1_ > 0 ) ) {  // d1
-                        if ( patch.getAxisOfAdditionalPlane() == 0 ) {
-                          pointIndex1 = reconstruct.addPoint( point1 );
+                      points.setPointPatchIndex( pointIndex1, tileIndex, patchIndex );
+                      points.setColor( pointIndex1, color );
+                      if ( PCC_SAVE_POINT_TYPE == 1 ) { points.setType( pointIndex1, POINT_D1 ); }
+                      pixels.emplace_back( x, y, 1 );
+                    }
+                  } else {  // eomCode != 0
+                    uint16_t addedPointCount = 0;
+                    size_t   pointIndex1     = 0;
+                    bool     addedD1Point    = false;
+                    for ( uint16_t i = 0; i < 10; i++ ) {
+                      if ( ( eomCode & ( 1 << i ) ) != 0 ) { d1pos = i; }
+                    }
+                    for ( uint16_t i = 0; i < 10; i++ ) {
+                      if ( ( eomCode & ( 1 << i ) ) != 0 ) {
+                        uint8_t deltaDCur = ( i + 1 );
+                        if ( patch.getProjectionMode() == 0 ) {
+                          point1[patch.getNormalAxis()] =
+                              static_cast<double>( point0[patch.getNormalAxis()] + deltaDCur );
                         } else {
-                          PCCVector3D tmp;
-                          inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(),
-                                                               params.geometryBitDepth3D_, point1, tmp );
-                          pointIndex1 = reconstruct.addPoint( tmp );
+                          point1[patch.getNormalAxis()] =
+                              static_cast<double>( point0[patch.getNormalAxis()] - deltaDCur );
                         }
-                        reconstruct.setPointPatchIndex( pointIndex1, tileIndex, patchIndex );
-                        reconstruct.setColor( pointIndex1, color );
-                        if ( PCC_SAVE_POINT_TYPE == 1 ) { reconstruct.setType( pointIndex1, POINT_D1 ); }
-                        partition.push_back( uint32_t( patchIndex ) );
-                        pointToPixel.emplace_back( x, y, 1 );
-                      } else {
+                        if ( ( eomCode == 1 || i == d1pos ) && ( params.mapCountMinus1_ > 0 ) ) {  // d1
+                          if ( patch.getAxisOfAdditionalPlane() == 0 ) {
+                            pointIndex1 = points.addPoint( point1 );
+                          } else {
+                            PCCVector3D tmp;
+                            inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(),
+                                                                 params.geometryBitDepth3D_, point1, tmp );
+                            pointIndex1 = points.addPoint( tmp );
+                          }
+                          addedD1Point = true;
+                          points.setPointPatchIndex( pointIndex1, tileIndex, patchIndex );
+                          points.setColor( pointIndex1, color );
+                          if ( PCC_SAVE_POINT_TYPE == 1 ) { points.setType( pointIndex1, POINT_D1 ); }
+                          pixels.emplace_back( x, y, 1 );
+                        } else {
+                          if ( patch.getAxisOfAdditionalPlane() == 0 ) {
+                            eomPointsPerPatch[patchIndex].push_back( point1 );
+                          } else {
+                            PCCVector3D tmp;
+                            inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(),
+                                                                 params.geometryBitDepth3D_, point1, tmp );
+                            eomPointsPerPatch[patchIndex].push_back( PCCPoint3D( tmp[0], tmp[1], tmp[2] ) );
+                          }
+                        }
+                        addedPointCount++;
+                      }
+                    }  // for each bit of EOM code
+                    if ( PCC_SAVE_POINT_TYPE == 1 && !addedD1Point ) { patchSetsFirstPointType[patchIndex] = 1; }
+                    // Without "Identify boundary points" & "1st Extension boundary region" as EOM code is only for
+                    // lossless coding now
+                  }       // if (eomCode == 0)
+                } else {  // not params.enhancedOccupancyMapCode_
+                  std::vector<PCCPoint3D> createdPoints;
+                  if ( params.pointLocalReconstruction_ ) {
+                    auto& mode =
+                        context.getPointLocalReconstructionMode( patch.getPointLocalReconstructionMode( u0, v0 ) );
+                    createdPoints = generatePoints( params, tile, videoGeometryMultiple, videoFrameIndex, patchIndex, u,
+                                                    v, xInVideoFrame, yInVideoFrame, mode.interpolate_, mode.filling_,
+                                                    mode.minD1_, mode.neighbor_ );
+                  } else {
+                    createdPoints = generatePoints( params, tile, videoGeometryMultiple, videoFrameIndex, patchIndex, u,
+                                                    v, xInVideoFrame, yInVideoFrame );
+                  }
+                  if ( !createdPoints.empty() ) {
+                    for ( size_t i = 0; i < createdPoints.size(); i++ ) {
+                      if ( ( !params.removeDuplicatePoints_ ) ||
+                           ( ( i == 0 ) || ( createdPoints[i] != createdPoints[0] ) ) ) {
+                        size_t pointindex = 0;
                         if ( patch.getAxisOfAdditionalPlane() == 0 ) {
-                          eomPointsPerPatch[patchIndex].push_back( point1 );
+                          pointindex = points.addPoint( createdPoints[i] );
+                          points.setPointPatchIndex( pointindex, tileIndex, patchIndex );
                         } else {
                           PCCVector3D tmp;
                           inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(),
-                                                               params.geometryBitDepth3D_, point1, tmp );
-                          eomPointsPerPatch[patchIndex].push_back( PCCPoint3D( tmp[0], tmp[1], tmp[2] ) );
+                                                               params.geometryBitDepth3D_, createdPoints[i], tmp );
+                          pointindex = points.addPoint( tmp );
+                          points.setPointPatchIndex( pointindex, tileIndex, patchIndex );
+                        }
+                        const size_t pointindex_1 = pointindex;
+                        points.setColor( pointindex_1, color );
+                        if ( params.pbfEnableFlag_ ) { points.setBoundaryPointType( pointindex_1, isBoundary ); }
+                        if ( PCC_SAVE_POINT_TYPE == 1 ) {
+                          if ( params.singleMapPixelInterleaving_ ) {
+                            size_t flag;
+                            flag = ( i == 0 ) ? ( x + y ) % 2
+                                              : ( i == 1 ) ? ( x + y + 1 ) % 2 : g_intermediateLayerIndex;
+                            points.setType( pointindex_1, flag == 0 ? POINT_D0 : flag == 1 ? POINT_D1 : POINT_DF );
+                          } else {
+                            points.setType( pointindex_1, i == 0 ? POINT_D0 : i == 1 ? POINT_D1 : POINT_DF );
+                          }
                         }
-                      }
-                      addedPointCount++;
-                    }
-                  }  // for each bit of EOM code
-                  if ( PCC_SAVE_POINT_TYPE == 1 ) { reconstruct.setType( pointIndex1, POINT_D1 ); }
-                  // Without "Identify boundary points" & "1st Extension boundary region" as EOM code is only for
-                  // lossless coding now
-                }       // if (eomCode == 0)
-              } else {  // not params.enhancedOccupancyMapCode_
-                std::vector<PCCPoint3D> createdPoints;
-                if ( params.pointLocalReconstruction_ ) {
-                  auto& mode =
-                      context.getPointLocalReconstructionMode( patch.getPointLocalReconstructionMode( u0, v0 ) );
-                  createdPoints = generatePoints( params, tile, videoGeometryMultiple, videoFrameIndex, patchIndex, u,
-                                                  v, xInVideoFrame, yInVideoFrame, mode.interpolate_, mode.filling_,
-                                                  mode.minD1_, mode.neighbor_ );
-                } else {
-                  createdPoints = generatePoints( params, tile, videoGeometryMultiple, videoFrameIndex, patchIndex, u,
-                                                  v, xInVideoFrame, yInVideoFrame );
-                }
-                if ( !createdPoints.empty() ) {
-                  for ( size_t i = 0; i < createdPoints.size(); i++ ) {
-                    if ( ( !params.removeDuplicatePoints_ ) ||
-                         ( ( i == 0 ) || ( createdPoints[i] != createdPoints[0] ) ) ) {
-                      size_t pointindex = 0;
-                      if ( patch.getAxisOfAdditionalPlane() == 0 ) {
-                        pointindex = reconstruct.addPoint( createdPoints[i] );
-                        reconstruct.setPointPatchIndex( pointindex, tileIndex, patchIndex );
-                      } else {
-                        PCCVector3D tmp;
-                        inverseRotatePosition45DegreeOnAxis( patch.getAxisOfAdditionalPlane(),
-                                                             params.geometryBitDepth3D_, createdPoints[i], tmp );
-                        pointindex = reconstruct.addPoint( tmp );
-                        reconstruct.setPointPatchIndex( pointindex, tileIndex, patchIndex );
-                      }
-                      const size_t pointindex_1 = pointindex;
-                      reconstruct.setColor( pointindex_1, color );
-                      if ( params.pbfEnableFlag_ ) { reconstruct.setBoundaryPointType( pointindex_1, isBoundary ); }
-                      if ( PCC_SAVE_POINT_TYPE == 1 ) {
                         if ( params.singleMapPixelInterleaving_ ) {
-                          size_t flag;
-                          flag = ( i == 0 ) ? ( x + y ) % 2 : ( i == 1 ) ? ( x + y + 1 ) % 2 : g_intermediateLayerIndex;
-                          reconstruct.setType( pointindex_1, flag == 0 ? POINT_D0 : flag == 1 ? POINT_D1 : POINT_DF );
+                          pixels.emplace_back(
+                              x, y,
+                              i == 0 ? ( static_cast<size_t>( x + y ) % 2 )
+                                     : i == 1 ? ( static_cast<size_t>( x + y + 1 ) % 2 ) : g_intermediateLayerIndex );
+                        } else if ( params.pointLocalReconstruction_ ) {
+                          pixels.emplace_back(
+                              x, y, i == 0 ? 0 : i == 1 ? g_intermediateLayerIndex : g_intermediateLayerIndex + 1 );
                         } else {
-                          reconstruct.setType( pointindex_1, i == 0 ? POINT_D0 : i == 1 ? POINT_D1 : POINT_DF );
+                          pixels.emplace_back( x, y, i < 2 ? i : g_intermediateLayerIndex + 1 );
                         }
                       }
-                      partition.push_back( uint32_t( patchIndex ) );
-                      if ( params.singleMapPixelInterleaving_ ) {
-                        pointToPixel.emplace_back(
-                            x, y,
-                            i == 0 ? ( static_cast<size_t>( x + y ) % 2 )
-                                   : i == 1 ? ( static_cast<size_t>( x + y + 1 ) % 2 ) : g_intermediateLayerIndex );
-                      } else if ( params.pointLocalReconstruction_ ) {
-                        pointToPixel.emplace_back(
-                            x, y, i == 0 ? 0 : i == 1 ? g_intermediateLayerIndex : g_intermediateLayerIndex + 1 );
-                      } else {
-                        pointToPixel.emplace_back( x, y, i < 2 ? i : g_intermediateLayerIndex + 1 );
-                      }
                     }
                   }
                 }
@@ -836,7 +844,50 @@ void PCCCodec::generatePointCloud( PCCPointSet3&                       reconstru
           }
         }
       }
-    }
+    } );
+  } );
+  std::vector<size_t> patchOffsets( totalPatchCount + 1, 0 );
+  for ( index = 0; index < patches.size(); index++ ) {
+    patchIndex = uint32_t( patchOrder[index] );
+    TRACE_CODEC(
+        "P%2lu/%2lu: 2D=(%2lu,%2lu)*(%2lu,%2lu) 3D(%4zu,%4zu,%4zu)*(%4zu,%4zu) A=(%zu,%zu,%zu) Or=%zu P=%zu => %zu "
+        "AxisOfAdditionalPlane = %zu \n",
+        patchIndex, totalPatchCount, patches[patchIndex].getU0(), patches[patchIndex].getV0(),
+        patches[patchIndex].getSizeU0(), patches[patchIndex].getSizeV0(), patches[patchIndex].getU1(),
+        patches[patchIndex].getV1(), patches[patchIndex].getD1(),
+        patches[patchIndex].getSizeU0() * patches[patchIndex].getOccupancyResolution(),
+        patches[patchIndex].getSizeV0() * patches[patchIndex].getOccupancyResolution(),
+        patches[patchIndex].getNormalAxis(), patches[patchIndex].getTangentAxis(),
+        patches[patchIndex].getBitangentAxis(), patches[patchIndex].getPatchOrientation(),
+        patches[patchIndex].getProjectionMode(), patchOffsets[index], patches[patchIndex].getAxisOfAdditionalPlane() );
+    patchOffsets[index + 1] = patchOffsets[index] + patchPoints[patchIndex].getPointCount();
+  }
+  // the points are added after those already in reconstruct, pointToPixel and partition
+  const size_t reconstructOffset  = reconstruct.getPointCount();
+  const size_t pointToPixelOffset = pointToPixel.size();
+  const size_t partitionOffset    = partition.size();
+  reconstruct.resize( reconstructOffset + patchOffsets[totalPatchCount] );
+  pointToPixel.resize( pointToPixelOffset + patchOffsets[totalPatchCount] );
+  partition.resize( partitionOffset + patchOffsets[totalPatchCount] );
+  limited.execute( [&] {
+    tbb::parallel_for( size_t( 0 ), totalPatchCount, [&]( const size_t index ) {
+      const size_t patchIndex = patchOrder[index];
+      auto&        points     = patchPoints[patchIndex];
+      for ( size_t i = 0, pointIndex = patchOffsets[index]; i < points.getPointCount(); i++, pointIndex++ ) {
+        reconstruct[reconstructOffset + pointIndex] = points[i];
+        reconstruct.setPointPatchIndex( reconstructOffset + pointIndex, tileIndex, patchIndex );
+        reconstruct.setColor( reconstructOffset + pointIndex, points.getColor( i ) );
+        reconstruct.setBoundaryPointType( reconstructOffset + pointIndex, points.getBoundaryPointType( i ) );
+        if ( PCC_SAVE_POINT_TYPE == 1 ) { reconstruct.setType( reconstructOffset + pointIndex, points.getType( i ) ); }
+        partition[partitionOffset + pointIndex]       = uint32_t( patchIndex );
+        pointToPixel[pointToPixelOffset + pointIndex] = patchPointToPixel[patchIndex][i];
+      }
+    } );
+  } );
+  // an EOM code without D1 point sets the type of the first point of the tile, as the serial walk did
+  if ( PCC_SAVE_POINT_TYPE == 1 && std::find( patchSetsFirstPointType.begin(), patchSetsFirstPointType.end(), 1 ) !=
+                                       patchSetsFirstPointType.end() ) {
+    reconstruct.setType( reconstructOffset, POINT_D1 );
   }
   tile.setTotalNumberOfRegularPoints( reconstruct.getPointCount() );
   printf( "frame %zu, tile %zu: regularPoints %zu\n", frameIndex, tileIndex, reconstruct.getPointCount() );
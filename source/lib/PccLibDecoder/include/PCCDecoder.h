@@ -38,6 +38,7 @@
 #include "PCCCodec.h"
 #include "PCCMath.h"
 #include "PCCPatch.h"
+#include <functional>
 
 namespace pcc {
 
@@ -49,11 +50,22 @@ class PatchFrameGeometryParameterSet;
 class GeometryPatchParameterSet;
 class V3CParameterSet;
 class PLRData;
+class PCCPointSet3;
+class PCCVideoFrameTracker;
 
 template <typename T, size_t N>
 class PCCImage;
 typedef pcc::PCCImage<uint8_t, 3> PCCImageOccupancyMap;
 
+// decompression of one video sub-bitstream into the video it fills
+struct PCCVideoDecodingJob {
+  const void*                   video;
+  PCCCodecId                    codecId;
+  std::function<void()>         decode;
+  size_t                        framesPerAtlasFrame;  // video frames an atlas frame is reconstructed from
+  std::function<void( size_t )> convertFrame;         // conversion of a decoded frame to the nominal bitdepth
+};
+
 class PCCDecoder : public PCCCodec {
  public:
   PCCDecoder();
@@ -61,6 +73,11 @@ class PCCDecoder : public PCCCodec {
 
   int decode( PCCContext& context, PCCGroupOfFrames& reconstruct, int32_t atlasIndex );
 
+  // called on the thread of decode() with each point cloud as soon as it is reconstructed, in frame order
+  void setFrameCallback( std::function<void( PCCPointSet3& frame, size_t frameIndex )> callback ) {
+    frameCallback_ = callback;
+  }
+
   void setParameters( const PCCDecoderParameters& params );
   void setReconstructionParameters( const PCCDecoderParameters& params );
   void setPostProcessingSeiParameters( GeneratePointCloudParameters& gpcParams, PCCContext& context, size_t atglIndex );
@@ -82,9 +99,11 @@ class PCCDecoder : public PCCCodec {
   void       createHlsAtlasTileLogFiles( PCCContext& context, int frameIndex );
   void       setConsitantFourCCCode( PCCContext& context, size_t atglIndex );
   PCCCodecId getCodedCodecId( PCCContext& context, const uint8_t codecCodecId, const std::string& videoDecoderPath );
+  void       decodeVideos( std::vector<PCCVideoDecodingJob>& jobs, PCCVideoFrameTracker& decodedFrames );
 
-  PCCDecoderParameters     params_;
-  std::vector<std::string> consitantFourCCCode_;
+  PCCDecoderParameters                                          params_;
+  std::vector<std::string>                                      consitantFourCCCode_;
+  std::function<void( PCCPointSet3& frame, size_t frameIndex )> frameCallback_;
 };
 
 };  // namespace pcc
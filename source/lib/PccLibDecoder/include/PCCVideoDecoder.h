@@ -35,6 +35,7 @@
 #define PCCVideoDecoder_h
 
 #include "PCCCommon.h"
+#include <functional>
 
 namespace pcc {
 
@@ -67,8 +68,16 @@ class PCCVideoDecoder {
 
   void setLogger( PCCLogger& logger ) { logger_ = &logger; }
 
+  // Called on the decoding thread with each frame of video once it has its final format, in output order.
+  // When video has been sized to the expected frame count, the frames of the library decoders are converted
+  // one by one and moved into it as they are output, so video is never reallocated while they are read.
+  void setFrameReadyCallback( std::function<void( const void* video, size_t frameIndex )> callback ) {
+    frameReady_ = callback;
+  }
+
  private:
-  PCCLogger* logger_ = nullptr;
+  PCCLogger*                                                 logger_ = nullptr;
+  std::function<void( const void* video, size_t frameIndex )> frameReady_;
 };
 
 };  // namespace pcc
@@ -44,10 +44,61 @@
 #include <iostream>
 #include <fstream>
 #include <ctime>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
 
 using namespace pcc;
 using namespace std;
 
+namespace pcc {
+
+// Counts the frames each video holds in their final format while the videos are decoded, so that an atlas
+// frame is reconstructed as soon as the frames it is made of are there. The jobs filling the same video run
+// one after the other and each one overwrites it, so only the frames of the last one are counted.
+class PCCVideoFrameTracker {
+ public:
+  void addJob( const void* video ) {
+    std::lock_guard<std::mutex> lock( mutex_ );
+    videos_[video].pendingJobs++;
+  }
+  void frameReady( const void* video ) {
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      auto&                       state = videos_[video];
+      if ( state.pendingJobs == 1 ) { state.readyFrames++; }
+    }
+    changed_.notify_all();
+  }
+  void jobDone( const void* video ) {
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      videos_[video].pendingJobs--;
+    }
+    changed_.notify_all();
+  }
+  // blocks until video holds frameCount frames; false if its jobs ended with less
+  bool wait( const void* video, size_t frameCount ) {
+    std::unique_lock<std::mutex> lock( mutex_ );
+    auto&                        state = videos_[video];
+    changed_.wait( lock, [&] { return state.pendingJobs == 0 || state.readyFrames >= frameCount; } );
+    return state.readyFrames >= frameCount;
+  }
+
+ private:
+  struct VideoState {
+    size_t pendingJobs = 0;
+    size_t readyFrames = 0;
+  };
+  std::mutex                        mutex_;
+  std::condition_variable           changed_;
+  std::map<const void*, VideoState> videos_;
+};
+
+};  // namespace pcc
+
 PCCDecoder::PCCDecoder() {
 #ifdef ENABLE_PAPI_PROFILING
   initPapiProfiler();
@@ -96,6 +147,7 @@ int PCCDecoder::decode( PCCContext& context, PCCGroupOfFrames& reconstructs, int
   auto occupancyCodecId = getCodedCodecId( context, oi.getOccupancyCodecId(), params_.videoDecoderOccupancyPath_ );
   auto geometryCodecId  = getCodedCodecId( context, gi.getGeometryCodecId(), params_.videoDecoderGeometryPath_ );
   path << removeFileExtension( params_.compressedStreamPath_ ) << "_dec_GOF" << sps.getV3CParameterSetId() << "_";
+  const std::string videoPath = path.str();
 
   printf( "CodecCodecId: ProfileCodecGroupIdc = %u occupancyCodecId = %u geometry = %u auxGeo = %u \n",
           plt.getProfileCodecGroupIdc(), oi.getOccupancyCodecId(), gi.getGeometryCodecId(),
@@ -103,93 +155,116 @@ int PCCDecoder::decode( PCCContext& context, PCCGroupOfFrames& reconstructs, int
   printf( "=> Video decoder : occupancy = %d geometry = %d \n", (int)occupancyCodecId, (int)geometryCodecId );
   printf( " Decode 0 size = %zu \n", context.getVideoBitstream( VIDEO_OCCUPANCY ).size() );
   fflush( stdout );
-  TRACE_PICTURE( "Occupancy\n" );
-  TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 0\n" );
-  videoDecoder.decompress( context.getVideoOccupancyMap(),                // video
-                           context,                                       // contexts
-                           path.str(),                                    // path
-                           context.getVideoBitstream( VIDEO_OCCUPANCY ),  // bitstream
-                           params_.byteStreamVideoCoderOccupancy_,        // byte stream video coder
-                           occupancyCodecId,                              // codecId
-                           params_.videoDecoderOccupancyPath_,            // decoder path
-                           8,                                             // output bit depth
-                           params_.keepIntermediateFiles_ );              // keep intermediate files
-
-  // converting the decoded bitdepth to the nominal bitdepth
-  context.getVideoOccupancyMap().convertBitdepth( 8, oi.getOccupancy2DBitdepthMinus1() + 1,
-                                                  oi.getOccupancyMSBAlignFlag() );
-
+  // Each video sub-bitstream is queued as a job filling its own video; jobs filling the same video keep their order.
+  // The videos are sized to the frame count of the GOF first, so that their frames can be read while the
+  // following ones are decoded.
+  std::vector<PCCVideoDecodingJob> videoJobs;
+  context.getVideoOccupancyMap().resize( frameCount );
+  videoJobs.push_back( {&context.getVideoOccupancyMap(), occupancyCodecId, [&] {
+                          TRACE_PICTURE( "Occupancy\n" );
+                          TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 0\n" );
+                          videoDecoder.decompress( context.getVideoOccupancyMap(),                // video
+                                                   context,                                       // contexts
+                                                   videoPath,                                     // path
+                                                   context.getVideoBitstream( VIDEO_OCCUPANCY ),  // bitstream
+                                                   params_.byteStreamVideoCoderOccupancy_,  // byte stream video coder
+                                                   occupancyCodecId,                        // codecId
+                                                   params_.videoDecoderOccupancyPath_,      // decoder path
+                                                   8,                                       // output bit depth
+                                                   params_.keepIntermediateFiles_ );        // keep intermediate files
+                        },
+                        1, [&]( size_t frameIndex ) {
+                          // converting the decoded bitdepth to the nominal bitdepth
+                          context.getVideoOccupancyMap()[frameIndex].convertBitdepth(
+                              8, oi.getOccupancy2DBitdepthMinus1() + 1, oi.getOccupancyMSBAlignFlag() );
+                        }} );
+
+  std::atomic<size_t> totalGeoSize( 0 );
   if ( sps.getMultipleMapStreamsPresentFlag( atlasIndex ) ) {
     context.getVideoGeometryMultiple().resize( sps.getMapCountMinus1( atlasIndex ) + 1 );
-    size_t totalGeoSize = 0;
     for ( uint32_t mapIndex = 0; mapIndex < sps.getMapCountMinus1( atlasIndex ) + 1; mapIndex++ ) {
-      TRACE_PICTURE( "Geometry\n" );
-      TRACE_PICTURE( "MapIdx = %d, AuxiliaryVideoFlag = 0\n", mapIndex );
-      std::cout << "*******Video Decoding: Geometry[" << mapIndex << "] ********" << std::endl;
-      auto  geometryIndex  = static_cast<PCCVideoType>( VIDEO_GEOMETRY_D0 + mapIndex );
-      auto& videoBitstream = context.getVideoBitstream( geometryIndex );
-      videoDecoder.decompress( context.getVideoGeometryMultiple( mapIndex ),  // video
-                               context,                                       // contexts
-                               path.str(),                                    // path
-                               videoBitstream,                                // bitstream
-                               params_.byteStreamVideoCoderGeometry_,         // byte stream video coder
-                               geometryCodecId,                               // codecId
-                               params_.videoDecoderGeometryPath_,             // decoder path
-                               geometryBitDepth,                              // output bit depth
-                               params_.keepIntermediateFiles_,                // keep intermediate files
-                               0 );                                           // SHVC layer index
-
-      context.getVideoGeometryMultiple()[mapIndex].convertBitdepth(
-          geometryBitDepth, gi.getGeometry2dBitdepthMinus1() + 1, gi.getGeometryMSBAlignFlag() );
-      std::cout << "geometry D" << mapIndex << " video ->" << videoBitstream.size() << " B" << std::endl;
-      totalGeoSize += videoBitstream.size();
+      context.getVideoGeometryMultiple( mapIndex ).resize( frameCount );
+      videoJobs.push_back( {&context.getVideoGeometryMultiple( mapIndex ), geometryCodecId, [&, mapIndex] {
+                              TRACE_PICTURE( "Geometry\n" );
+                              TRACE_PICTURE( "MapIdx = %d, AuxiliaryVideoFlag = 0\n", mapIndex );
+                              std::cout << "*******Video Decoding: Geometry[" << mapIndex << "] ********" << std::endl;
+                              auto  geometryIndex  = static_cast<PCCVideoType>( VIDEO_GEOMETRY_D0 + mapIndex );
+                              auto& videoBitstream = context.getVideoBitstream( geometryIndex );
+                              videoDecoder.decompress( context.getVideoGeometryMultiple( mapIndex ),  // video
+                                                       context,                                       // contexts
+                                                       videoPath,                                     // path
+                                                       videoBitstream,                                // bitstream
+                                                       params_.byteStreamVideoCoderGeometry_,  // byte stream video coder
+                                                       geometryCodecId,                        // codecId
+                                                       params_.videoDecoderGeometryPath_,      // decoder path
+                                                       geometryBitDepth,                       // output bit depth
+                                                       params_.keepIntermediateFiles_,  // keep intermediate files
+                                                       0 );                             // SHVC layer index
+
+                              std::cout << "geometry D" << mapIndex << " video ->" << videoBitstream.size() << " B"
+                                        << std::endl;
+                              totalGeoSize += videoBitstream.size();
+                            },
+                            1, [&, mapIndex]( size_t frameIndex ) {
+                              context.getVideoGeometryMultiple( mapIndex )[frameIndex].convertBitdepth(
+                                  geometryBitDepth, gi.getGeometry2dBitdepthMinus1() + 1, gi.getGeometryMSBAlignFlag() );
+                            }} );
     }
-    std::cout << "total geometry video ->" << totalGeoSize << " B" << std::endl;
   } else {
-    TRACE_PICTURE( "Geometry\n" );
-    TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 0\n" );
-    std::cout << "*******Video Decoding: Geometry ********" << std::endl;
-    auto& videoBitstream = context.getVideoBitstream( VIDEO_GEOMETRY );
-
-    printf( " Decode G size = %zu \n", videoBitstream.size() );
-    fflush( stdout );
-    videoDecoder.decompress( context.getVideoGeometryMultiple( 0 ),  // video
-                             context,                                // contexts
-                             path.str(),                             // path
-                             videoBitstream,                         // bitstream
-                             params_.byteStreamVideoCoderGeometry_,  // byte stream video coder
-                             geometryCodecId,                        // codecId
-                             params_.videoDecoderGeometryPath_,      // decoder path
-                             geometryBitDepth,                       // output bit depth
-                             params_.keepIntermediateFiles_,         // keep intermediate files
-                             params_.shvcLayerIndex_ );              // SHVC layer index
-
-    context.getVideoGeometryMultiple()[0].convertBitdepth( geometryBitDepth, gi.getGeometry2dBitdepthMinus1() + 1,
-                                                           gi.getGeometryMSBAlignFlag() );
-    std::cout << "geometry video ->" << videoBitstream.size() << " B" << std::endl;
+    context.getVideoGeometryMultiple( 0 ).resize( frameCount * mapCount );
+    videoJobs.push_back( {&context.getVideoGeometryMultiple( 0 ), geometryCodecId, [&] {
+                            TRACE_PICTURE( "Geometry\n" );
+                            TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 0\n" );
+                            std::cout << "*******Video Decoding: Geometry ********" << std::endl;
+                            auto& videoBitstream = context.getVideoBitstream( VIDEO_GEOMETRY );
+
+                            printf( " Decode G size = %zu \n", videoBitstream.size() );
+                            fflush( stdout );
+                            videoDecoder.decompress( context.getVideoGeometryMultiple( 0 ),  // video
+                                                     context,                                // contexts
+                                                     videoPath,                              // path
+                                                     videoBitstream,                         // bitstream
+                                                     params_.byteStreamVideoCoderGeometry_,  // byte stream video coder
+                                                     geometryCodecId,                        // codecId
+                                                     params_.videoDecoderGeometryPath_,      // decoder path
+                                                     geometryBitDepth,                       // output bit depth
+                                                     params_.keepIntermediateFiles_,         // keep intermediate files
+                                                     params_.shvcLayerIndex_ );              // SHVC layer index
+
+                            std::cout << "geometry video ->" << videoBitstream.size() << " B" << std::endl;
+                          },
+                          mapCount, [&]( size_t frameIndex ) {
+                            context.getVideoGeometryMultiple( 0 )[frameIndex].convertBitdepth(
+                                geometryBitDepth, gi.getGeometry2dBitdepthMinus1() + 1, gi.getGeometryMSBAlignFlag() );
+                          }} );
   }
 
   if ( asps.getRawPatchEnabledFlag() && asps.getAuxiliaryVideoEnabledFlag() &&
        sps.getAuxiliaryVideoPresentFlag( atlasIndex ) ) {
-    TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 1\n" );
-    std::cout << "*******Video Decoding: Aux Geometry ********" << std::endl;
-    auto& videoBitstreamMP = context.getVideoBitstream( VIDEO_GEOMETRY_RAW );
-    auto  auxGeometryCodecId =
+    auto auxGeometryCodecId =
         getCodedCodecId( context, gi.getAuxiliaryGeometryCodecId(), params_.videoDecoderGeometryPath_ );
-    videoDecoder.decompress( context.getVideoRawPointsGeometry(),    // video
-                             context,                                // contexts
-                             path.str(),                             // path
-                             videoBitstreamMP,                       // bitstream
-                             params_.byteStreamVideoCoderGeometry_,  // byte stream video coder
-                             auxGeometryCodecId,                     // codecId
-                             params_.videoDecoderGeometryPath_,      // decoder path
-                             geometryBitDepth,                       // output bit depth
-                             params_.keepIntermediateFiles_,         // keep intermediate files
-                             params_.shvcLayerIndex_ );              // SHVC layer index
-
-    context.getVideoRawPointsGeometry().convertBitdepth( geometryBitDepth, gi.getGeometry2dBitdepthMinus1() + 1,
-                                                         gi.getGeometryMSBAlignFlag() );
-    std::cout << " raw points geometry -> " << videoBitstreamMP.size() << " B " << endl;
+    context.getVideoRawPointsGeometry().resize( frameCount );
+    videoJobs.push_back( {&context.getVideoRawPointsGeometry(), auxGeometryCodecId, [&, auxGeometryCodecId] {
+                            TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 1\n" );
+                            std::cout << "*******Video Decoding: Aux Geometry ********" << std::endl;
+                            auto& videoBitstreamMP = context.getVideoBitstream( VIDEO_GEOMETRY_RAW );
+                            videoDecoder.decompress( context.getVideoRawPointsGeometry(),    // video
+                                                     context,                                // contexts
+                                                     videoPath,                              // path
+                                                     videoBitstreamMP,                       // bitstream
+                                                     params_.byteStreamVideoCoderGeometry_,  // byte stream video coder
+                                                     auxGeometryCodecId,                     // codecId
+                                                     params_.videoDecoderGeometryPath_,      // decoder path
+                                                     geometryBitDepth,                       // output bit depth
+                                                     params_.keepIntermediateFiles_,         // keep intermediate files
+                                                     params_.shvcLayerIndex_ );              // SHVC layer index
+
+                            std::cout << " raw points geometry -> " << videoBitstreamMP.size() << " B " << endl;
+                          },
+                          1, [&]( size_t frameIndex ) {
+                            context.getVideoRawPointsGeometry()[frameIndex].convertBitdepth(
+                                geometryBitDepth, gi.getGeometry2dBitdepthMinus1() + 1, gi.getGeometryMSBAlignFlag() );
+                          }} );
   }
 
   if ( ai.getAttributeCount() > 0 ) {
@@ -202,90 +277,125 @@ int PCCDecoder::decode( PCCContext& context, PCCGroupOfFrames& reconstructs, int
       printf( "CodecId attributeCodecId = %d \n", (int)attributeCodecId );
       for ( int attrPartitionIndex = 0; attrPartitionIndex < attributeDimension; attrPartitionIndex++ ) {
         if ( sps.getMultipleMapStreamsPresentFlag( atlasIndex ) ) {
-          int sizeAttributeVideo = 0;
           context.getVideoAttributesMultiple().resize( sps.getMapCountMinus1( atlasIndex ) + 1 );
           // this allocation is considering only one attribute, with a single partition, but multiple streams
           for ( uint32_t mapIndex = 0; mapIndex < sps.getMapCountMinus1( atlasIndex ) + 1; mapIndex++ ) {
-            // decompress T[mapIndex]
-            TRACE_PICTURE( "Attribute\n" );
-            TRACE_PICTURE( "AttrIdx = %d, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = %d, AuxiliaryVideoFlag = 0\n",
-                           attrIndex, attrPartitionIndex, attributeTypeId, mapIndex );
-            std::cout << "*******Video Decoding: Attribute [" << mapIndex << "] ********" << std::endl;
-            auto  attributeIndex = static_cast<PCCVideoType>( VIDEO_ATTRIBUTE_T0 + attrPartitionIndex +
-                                                             MAX_NUM_ATTR_PARTITIONS * mapIndex );
-            auto& videoBitstream = context.getVideoBitstream( attributeIndex );
-            videoDecoder.decompress( context.getVideoAttributesMultiple( mapIndex ),  // video
-                                     context,                                         // contexts
-                                     path.str(),                                      // path
-                                     videoBitstream,                                  // bitstream
-                                     params_.byteStreamVideoCoderAttribute_,          // byte stream video coder
-                                     attributeCodecId,                                // codecId
-                                     params_.videoDecoderAttributePath_,              // decoder path
-                                     attributeBitDepth,                               // output bit depth
-                                     params_.keepIntermediateFiles_,                  // keep intermediate files
-                                     params_.shvcLayerIndex_,                         // SHVC layer index
-                                     params_.patchColorSubsampling_,                  // patch color subsampling
-                                     params_.inverseColorSpaceConversionConfig_,      // inverse color space conversion
-                                     params_.colorSpaceConversionPath_ );             // color space conversion path
-            std::cout << "attribute T" << mapIndex << " video ->" << videoBitstream.size() << " B" << std::endl;
-            sizeAttributeVideo += videoBitstream.size();
+            context.getVideoAttributesMultiple( mapIndex ).resize( frameCount );
+            videoJobs.push_back(
+                {&context.getVideoAttributesMultiple( mapIndex ), attributeCodecId,
+                 [&, attributeBitDepth, attributeTypeId, attributeCodecId, attrIndex, attrPartitionIndex, mapIndex] {
+                   // decompress T[mapIndex]
+                   TRACE_PICTURE( "Attribute\n" );
+                   TRACE_PICTURE(
+                       "AttrIdx = %d, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = %d, AuxiliaryVideoFlag = 0\n",
+                       attrIndex, attrPartitionIndex, attributeTypeId, mapIndex );
+                   std::cout << "*******Video Decoding: Attribute [" << mapIndex << "] ********" << std::endl;
+                   auto  attributeIndex = static_cast<PCCVideoType>( VIDEO_ATTRIBUTE_T0 + attrPartitionIndex +
+                                                                    MAX_NUM_ATTR_PARTITIONS * mapIndex );
+                   auto& videoBitstream = context.getVideoBitstream( attributeIndex );
+                   videoDecoder.decompress( context.getVideoAttributesMultiple( mapIndex ),  // video
+                                            context,                                         // contexts
+                                            videoPath,                                       // path
+                                            videoBitstream,                                  // bitstream
+                                            params_.byteStreamVideoCoderAttribute_,  // byte stream video coder
+                                            attributeCodecId,                        // codecId
+                                            params_.videoDecoderAttributePath_,      // decoder path
+                                            attributeBitDepth,                       // output bit depth
+                                            params_.keepIntermediateFiles_,          // keep intermediate files
+                                            params_.shvcLayerIndex_,                 // SHVC layer index
+                                            params_.patchColorSubsampling_,          // patch color subsampling
+                                            params_.inverseColorSpaceConversionConfig_,  // inverse color space conversion
+                                            params_.colorSpaceConversionPath_ );  // color space conversion path
+                   std::cout << "attribute T" << mapIndex << " video ->" << videoBitstream.size() << " B"
+                             << std::endl;
+                 },
+                 1, nullptr} );
           }
-          std::cout << "attribute    video ->" << sizeAttributeVideo << " B" << std::endl;
         } else {
-          TRACE_PICTURE( "Attribute\n" );
-          TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 0, AuxiliaryVideoFlag = 0\n",
-                         attrPartitionIndex, attributeTypeId );
-          std::cout << "*******Video Decoding: Attribute ********" << std::endl;
-          auto  attributeIndex = static_cast<PCCVideoType>( VIDEO_ATTRIBUTE + attrPartitionIndex );
-          auto& videoBitstream = context.getVideoBitstream( attributeIndex );
-          printf( " Decode T size = %zu \n", videoBitstream.size() );
-          fflush( stdout );
-          videoDecoder.decompress( context.getVideoAttributesMultiple( 0 ),     // video
-                                   context,                                     // contexts
-                                   path.str(),                                  // path
-                                   videoBitstream,                              // bitstream
-                                   params_.byteStreamVideoCoderAttribute_,      // byte stream video coder
-                                   attributeCodecId,                            // codecId
-                                   params_.videoDecoderAttributePath_,          // decoder path
-                                   attributeBitDepth,                           // output bit depth
-                                   params_.keepIntermediateFiles_,              // keep intermediate files
-                                   params_.shvcLayerIndex_,                     // SHVC layer index
-                                   params_.patchColorSubsampling_,              // patch color subsampling
-                                   params_.inverseColorSpaceConversionConfig_,  // inverse color space conversionConfig
-                                   params_.colorSpaceConversionPath_ );         // color space conversion path
-          std::cout << "attribute video  ->" << videoBitstream.size() << " B" << std::endl;
+          context.getVideoAttributesMultiple( 0 ).resize( frameCount * mapCount );
+          videoJobs.push_back(
+              {&context.getVideoAttributesMultiple( 0 ), attributeCodecId,
+               [&, attributeBitDepth, attributeTypeId, attributeCodecId, attrPartitionIndex] {
+                 TRACE_PICTURE( "Attribute\n" );
+                 TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 0, AuxiliaryVideoFlag = 0\n",
+                                attrPartitionIndex, attributeTypeId );
+                 std::cout << "*******Video Decoding: Attribute ********" << std::endl;
+                 auto  attributeIndex = static_cast<PCCVideoType>( VIDEO_ATTRIBUTE + attrPartitionIndex );
+                 auto& videoBitstream = context.getVideoBitstream( attributeIndex );
+                 printf( " Decode T size = %zu \n", videoBitstream.size() );
+                 fflush( stdout );
+                 videoDecoder.decompress( context.getVideoAttributesMultiple( 0 ),     // video
+                                          context,                                     // contexts
+                                          videoPath,                                   // path
+                                          videoBitstream,                              // bitstream
+                                          params_.byteStreamVideoCoderAttribute_,      // byte stream video coder
+                                          attributeCodecId,                            // codecId
+                                          params_.videoDecoderAttributePath_,          // decoder path
+                                          attributeBitDepth,                           // output bit depth
+                                          params_.keepIntermediateFiles_,              // keep intermediate files
+                                          params_.shvcLayerIndex_,                     // SHVC layer index
+                                          params_.patchColorSubsampling_,              // patch color subsampling
+                                          params_.inverseColorSpaceConversionConfig_,  // inverse color space conversionConfig
+                                          params_.colorSpaceConversionPath_ );  // color space conversion path
+                 std::cout << "attribute video  ->" << videoBitstream.size() << " B" << std::endl;
+               },
+               mapCount, nullptr} );
         }
 
         if ( asps.getRawPatchEnabledFlag() && asps.getAuxiliaryVideoEnabledFlag() &&
              sps.getAuxiliaryVideoPresentFlag( atlasIndex ) ) {
-          std::cout << "*******Video Decoding: Aux Attribute ********" << std::endl;
-          auto attributeIndex = static_cast<PCCVideoType>( VIDEO_ATTRIBUTE_RAW + attrPartitionIndex );
-          TRACE_PICTURE( "Attribute\n" );
-          TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 0, AuxiliaryVideoFlag = 1\n",
-                         attrPartitionIndex, attributeTypeId );
-          auto& videoBitstreamMP    = context.getVideoBitstream( attributeIndex );
-          auto  auxAttributeCodecId = getCodedCodecId( context, ai.getAuxiliaryAttributeCodecId( attrIndex ),
+          auto auxAttributeCodecId = getCodedCodecId( context, ai.getAuxiliaryAttributeCodecId( attrIndex ),
                                                       params_.videoDecoderAttributePath_ );
           printf( "CodecId auxAttributeCodecId = %d \n", (int)auxAttributeCodecId );
-          videoDecoder.decompress( context.getVideoRawPointsAttribute(),        // video
-                                   context,                                     // contexts
-                                   path.str(),                                  // path
-                                   videoBitstreamMP,                            // bitstream
-                                   params_.byteStreamVideoCoderAttribute_,      // byte stream video coder
-                                   auxAttributeCodecId,                         // codecId
-                                   params_.videoDecoderAttributePath_,          // decoder path
-                                   attributeBitDepth,                           // output bit depth
-                                   params_.keepIntermediateFiles_,              // keep intermediate files
-                                   params_.shvcLayerIndex_,                     // SHVC layer index
-                                   false,                                       // patch color subsampling
-                                   params_.inverseColorSpaceConversionConfig_,  // inverse color space conversionConfig
-                                   params_.colorSpaceConversionPath_ );         // color space conversion path
-          // generateRawPointsAttributefromVideo( context, reconstructs );
-          std::cout << " raw points attribute -> " << videoBitstreamMP.size() << " B" << endl;
+          context.getVideoRawPointsAttribute().resize( frameCount );
+          videoJobs.push_back(
+              {&context.getVideoRawPointsAttribute(), auxAttributeCodecId,
+               [&, attributeBitDepth, attributeTypeId, auxAttributeCodecId, attrPartitionIndex] {
+                 std::cout << "*******Video Decoding: Aux Attribute ********" << std::endl;
+                 auto attributeIndex = static_cast<PCCVideoType>( VIDEO_ATTRIBUTE_RAW + attrPartitionIndex );
+                 TRACE_PICTURE( "Attribute\n" );
+                 TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 0, AuxiliaryVideoFlag = 1\n",
+                                attrPartitionIndex, attributeTypeId );
+                 auto& videoBitstreamMP = context.getVideoBitstream( attributeIndex );
+                 videoDecoder.decompress( context.getVideoRawPointsAttribute(),        // video
+                                          context,                                     // contexts
+                                          videoPath,                                   // path
+                                          videoBitstreamMP,                            // bitstream
+                                          params_.byteStreamVideoCoderAttribute_,      // byte stream video coder
+                                          auxAttributeCodecId,                         // codecId
+                                          params_.videoDecoderAttributePath_,          // decoder path
+                                          attributeBitDepth,                           // output bit depth
+                                          params_.keepIntermediateFiles_,              // keep intermediate files
+                                          params_.shvcLayerIndex_,                     // SHVC layer index
+                                          false,                                       // patch color subsampling
+                                          params_.inverseColorSpaceConversionConfig_,  // inverse color space conversionConfig
+                                          params_.colorSpaceConversionPath_ );  // color space conversion path
+                 // generateRawPointsAttributefromVideo( context, reconstructs );
+                 std::cout << " raw points attribute -> " << videoBitstreamMP.size() << " B" << endl;
+               },
+               1, nullptr} );
         }
       }
     }
   }
+  PCCVideoFrameTracker decodedFrames;
+  for ( auto& job : videoJobs ) { decodedFrames.addJob( job.video ); }
+  videoDecoder.setFrameReadyCallback( [&]( const void* video, size_t frameIndex ) {
+    for ( auto& job : videoJobs ) {
+      if ( job.video == video ) {
+        if ( job.convertFrame ) { job.convertFrame( frameIndex ); }
+        break;
+      }
+    }
+    decodedFrames.frameReady( video );
+  } );
+  // the videos are decoded on their own thread while the frames they have output are reconstructed
+  std::thread videoThread( [&] {
+    decodeVideos( videoJobs, decodedFrames );
+    if ( sps.getMultipleMapStreamsPresentFlag( atlasIndex ) ) {
+      std::cout << "total geometry video ->" << totalGeoSize << " B" << std::endl;
+    }
+  } );
 
   reconstructs.setFrameCount( frameCount );
   // recreating the prediction list per attribute (either the attribute is coded absolute, or follows the geometry)
@@ -308,7 +418,17 @@ int PCCDecoder::decode( PCCContext& context, PCCGroupOfFrames& reconstructs, int
   printf( "generate point cloud of %zu frames \n", frameCount );
   fflush( stdout );
   for ( size_t frameIdx = 0; frameIdx < frameCount; frameIdx++ ) {
-    // All video have been decoded, start reconsctruction processes
+    // wait for the video frames of this atlas frame, then start reconsctruction processes
+    bool framesReady = true;
+    for ( auto& job : videoJobs ) {
+      framesReady = decodedFrames.wait( job.video, ( frameIdx + 1 ) * job.framesPerAtlasFrame ) && framesReady;
+    }
+    if ( !framesReady ) {
+      printf( "video frames of frame %zu are missing \n", frameIdx );
+      fflush( stdout );
+      videoThread.join();
+      return -1;
+    }
     if ( asps.getRawPatchEnabledFlag() && asps.getAuxiliaryVideoEnabledFlag() &&
          sps.getAuxiliaryVideoPresentFlag( atlasIndex ) ) {
       for ( int attrIndex = 0; attrIndex < ai.getAttributeCount(); attrIndex++ ) {
@@ -490,7 +610,9 @@ int PCCDecoder::decode( PCCContext& context, PCCGroupOfFrames& reconstructs, int
     TRACE_RECFRAME( " MD5 checksum = " );
     for ( auto& c : checksum ) { TRACE_RECFRAME( "%02x", c ); }
     TRACE_RECFRAME( "\n" );
+    if ( frameCallback_ ) { frameCallback_( reconstruct, frameIdx ); }
   }
+  videoThread.join();
   return 0;
 }
 
@@ -1937,3 +2059,47 @@ PCCCodecId PCCDecoder::getCodedCodecId( PCCContext&        context,
   }
   return PCCCodecId::UNKNOWN_CODEC;
 }
+
+void PCCDecoder::decodeVideos( std::vector<PCCVideoDecodingJob>& jobs, PCCVideoFrameTracker& decodedFrames ) {
+  // the JM and VTM library decoders keep their state in globals and can not run concurrently
+  bool parallel = params_.parallelVideoDecoding_;
+  for ( auto& job : jobs ) {
+#ifdef USE_JMLIB_VIDEO_CODEC
+    if ( job.codecId == JMLIB ) { parallel = false; }
+#endif
+#ifdef USE_VTMLIB_VIDEO_CODEC
+    if ( job.codecId == VTMLIB ) { parallel = false; }
+#endif
+  }
+  if ( !parallel ) {
+    for ( auto& job : jobs ) {
+      job.decode();
+      decodedFrames.jobDone( job.video );
+    }
+    return;
+  }
+  // one task per video, running the jobs that fill it in order
+  std::vector<std::vector<PCCVideoDecodingJob*>> videos;
+  for ( auto& job : jobs ) {
+    auto video = std::find_if( videos.begin(), videos.end(), [&]( const std::vector<PCCVideoDecodingJob*>& queue ) {
+      return queue.front()->video == job.video;
+    } );
+    if ( video == videos.end() ) {
+      videos.push_back( {&job} );
+    } else {
+      video->push_back( &job );
+    }
+  }
+  printf( "decode %zu video sub-bitstreams in %zu parallel tasks \n", jobs.size(), videos.size() );
+  fflush( stdout );
+  tbb::task_group tasks;
+  for ( auto& queue : videos ) {
+    tasks.run( [&queue, &decodedFrames] {
+      for ( auto job : queue ) {
+        job->decode();
+        decodedFrames.jobDone( job->video );
+      }
+    } );
+  }
+  tasks.wait();
+}
@@ -81,13 +81,19 @@ bool PCCVideoDecoder::decompress( PCCVideo<T, 3>&    video,
   fflush( stdout );
   if ( byteStreamVideoCoder ) {
     bitstream.sampleStreamToByteStream(
-#if defined( USE_JMAPP_VIDEO_CODEC ) || defined( USE_JMLIB_VIDEO_CODEC )
+#if defined( USE_JMAPP_VIDEO_CODEC ) && defined( USE_JMLIB_VIDEO_CODEC )
         codecId == JMAPP || codecId == JMLIB,
+#elif defined( USE_JMAPP_VIDEO_CODEC )
+        codecId == JMAPP,
+#elif defined( USE_JMLIB_VIDEO_CODEC )
+        codecId == JMLIB,
 #else
         false,
 #endif
 #if defined( USE_VTMLIB_VIDEO_CODEC )
         codecId == VTMLIB
+#else
+        false
 #endif
     );
   }
@@ -103,6 +109,73 @@ bool PCCVideoDecoder::decompress( PCCVideo<T, 3>&    video,
     shmDecoder->setLayerIndex( shvcLayerIndex );
   }
 #endif
+
+  // Convert dec video
+  std::shared_ptr<PCCVirtualColorConverter<T>> converter;
+  std::string                                  configInverseColorSpace;
+  if ( colorSpaceConversionPath.empty() ) {
+    converter               = std::make_shared<PCCInternalColorConverter<T>>();
+    configInverseColorSpace = stringFormat( "YUV420ToYUV444_%zu_%zu", outputBitDepth, upsamplingFilter );
+  } else {
+#ifdef USE_HDRTOOLS
+    converter = std::make_shared<PCCHDRToolsLibColorConverter<T>>();
+#else
+    converter = std::make_shared<PCCHDRToolsAppColorConverter<T>>();
+#endif
+    configInverseColorSpace = inverseColorSpaceConversionConfig;
+  }
+
+  // Frames are handed over one by one when the caller sized video to the expected frame count: each picture
+  // reported by the library decoders is converted on its own and moved into video. The patch based chroma
+  // upsampling and the intermediate files need the whole video.
+  bool streaming = frameReady_ && video.getFrameCount() > 0 && !keepIntermediateFiles &&
+                   ( inverseColorSpaceConversionConfig.empty() || !patchColorSubsampling );
+#ifndef USE_HDRTOOLS
+  // the external color converter is started once per video
+  streaming = streaming && ( inverseColorSpaceConversionConfig.empty() || colorSpaceConversionPath.empty() );
+#endif
+  if ( streaming ) {
+    PCCVideo<T, 3> decoded;
+    size_t         reported = 0;
+    bool           is444    = false;
+    auto           report   = [&]( size_t frameCount ) {
+      for ( ; reported < frameCount && reported < video.getFrameCount(); reported++ ) {
+        auto& image = decoded[reported];
+        TRACE_PICTURE( " IdxOutOrderCntVal = %d, ", reported );
+        TRACE_PICTURE( " MD5checksumChan0 = %s, ", image.computeMD5( 0 ).c_str() );
+        TRACE_PICTURE( " MD5checksumChan1 = %s, ", image.computeMD5( 1 ).c_str() );
+        TRACE_PICTURE( " MD5checksumChan2 = %s \n", image.computeMD5( 2 ).c_str() );
+        is444 = image.getColorFormat() == PCCCOLORFORMAT::RGB444 || image.getColorFormat() == PCCCOLORFORMAT::YUV444;
+        if ( inverseColorSpaceConversionConfig.empty() || is444 ) {
+          if ( is444 ) {
+            image.setDeprecatedColorFormat( 0 );
+          } else {
+            image.setDeprecatedColorFormat( 1 );
+            image.convertYUV420ToYUV444();
+          }
+        } else {
+          PCCVideo<T, 3> frame;
+          frame.resize( 1 );
+          frame[0] = std::move( image );
+          converter->convert( configInverseColorSpace, frame, colorSpaceConversionPath, fileName + "_rec" );
+          image = std::move( frame[0] );
+          image.setDeprecatedColorFormat( colorSpaceConversionPath.empty() ? 1 : 2 );
+        }
+        video[reported] = std::move( image );
+        frameReady_( &video, reported );
+      }
+    };
+    decoder->setFrameCallback( [&]( PCCVideo<T, 3>&, size_t frameIndex ) { report( frameIndex + 1 ); } );
+    decoder->decode( bitstream, decoded, outputBitDepth, decoderPath, fileName );
+    // the decoders without frame callback output all their frames at once
+    report( decoded.getFrameCount() );
+    TRACE_PICTURE( "Width =  %d, Height = %d \n", video.getWidth(), video.getHeight() );
+    printf( "Decoded frame = %zu x %zu %zu bits is444 = %d NumFrames = %zu / %zu \n", video.getWidth(),
+            video.getHeight(), outputBitDepth, is444, decoded.getFrameCount(), video.getFrameCount() );
+    fflush( stdout );
+    return decoded.getFrameCount() == video.getFrameCount();
+  }
+
   auto start = std::chrono::system_clock::now();
   decoder->decode( bitstream, video, outputBitDepth, decoderPath, fileName );
 
@@ -125,20 +198,6 @@ bool PCCVideoDecoder::decompress( PCCVideo<T, 3>&    video,
     video.write( video.addFormat( fileName + "_rec", outputBitDepth == 8 ? "8" : "10" ), outputBitDepth == 8 ? 1 : 2 );
   }
 
-  // Convert dec video
-  std::shared_ptr<PCCVirtualColorConverter<T>> converter;
-  std::string                                  configInverseColorSpace;
-  if ( colorSpaceConversionPath.empty() ) {
-    converter               = std::make_shared<PCCInternalColorConverter<T>>();
-    configInverseColorSpace = stringFormat( "YUV420ToYUV444_%zu_%zu", outputBitDepth, upsamplingFilter );
-  } else {
-#ifdef USE_HDRTOOLS
-    converter = std::make_shared<PCCHDRToolsLibColorConverter<T>>();
-#else
-    converter = std::make_shared<PCCHDRToolsAppColorConverter<T>>();
-#endif
-    configInverseColorSpace = inverseColorSpaceConversionConfig;
-  }
   if ( inverseColorSpaceConversionConfig.empty() || is444 ) {
     if ( is444 ) {
       video.setDeprecatedColorFormat( 0 );
@@ -375,6 +434,9 @@ bool PCCVideoDecoder::decompress( PCCVideo<T, 3>&    video,
       if ( keepIntermediateFiles ) { video.write( video.addFormat( fileName + "_rec", "16" ), 2 ); }
     }
   }
+  if ( frameReady_ ) {
+    for ( size_t i = 0; i < video.getFrameCount(); i++ ) { frameReady_( &video, i ); }
+  }
   return true;
 }
 
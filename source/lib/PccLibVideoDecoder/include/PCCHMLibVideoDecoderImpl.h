@@ -39,6 +39,7 @@
 
 #include "PCCVideo.h"
 #include "PCCVideoBitstream.h"
+#include <functional>
 
 #include <TLibCommon/TComList.h>
 #include <TLibCommon/TComPicYuv.h>
@@ -54,7 +55,8 @@ class PCCHMLibVideoDecoderImpl {
   PCCHMLibVideoDecoderImpl();
 
   ~PCCHMLibVideoDecoderImpl();
-  void decode( PCCVideoBitstream& bitstream, size_t outputBitDepth, PCCVideo<T, 3>& video );
+  void decode( const uint8_t* data, size_t size, size_t outputBitDepth, PCCVideo<T, 3>& video );
+  void setFrameCallback( std::function<void( PCCVideo<T, 3>&, size_t )> callback ) { m_frameCallback = callback; }
 
  private:
   void               setVideoSize( const pcc_hm::TComSPS* sps );
@@ -69,6 +71,7 @@ class PCCHMLibVideoDecoderImpl {
   int                m_outputWidth;
   int                m_outputHeight;
   bool               m_bRGB2GBR;
+  std::function<void( PCCVideo<T, 3>&, size_t )> m_frameCallback;
 };
 
 };  // namespace pcc
@@ -0,0 +1,66 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef PCCMemoryStreamBuffer_h
+#define PCCMemoryStreamBuffer_h
+
+#include <streambuf>
+#include <cstdint>
+
+namespace pcc {
+
+// Read only stream buffer over a bitstream in memory, so the library decoders read their input
+// through a std::istream without copying it. Seeking is supported as the NAL unit readers rewind.
+class PCCMemoryStreamBuffer : public std::streambuf {
+ public:
+  PCCMemoryStreamBuffer( const uint8_t* data, size_t size ) {
+    char* begin = reinterpret_cast<char*>( const_cast<uint8_t*>( data ) );
+    setg( begin, begin, begin + size );
+  }
+
+ protected:
+  pos_type seekoff( off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which ) override {
+    if ( ( which & std::ios_base::in ) == 0 ) { return pos_type( off_type( -1 ) ); }
+    off_type pos = dir == std::ios_base::beg ? off : dir == std::ios_base::cur ? gptr() - eback() + off
+                                                                               : egptr() - eback() + off;
+    if ( pos < 0 || pos > egptr() - eback() ) { return pos_type( off_type( -1 ) ); }
+    setg( eback(), eback() + pos, egptr() );
+    return pos_type( pos );
+  }
+  pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override {
+    return seekoff( off_type( pos ), std::ios_base::beg, which );
+  }
+};
+
+};  // namespace pcc
+
+#endif /* PCCMemoryStreamBuffer_h */
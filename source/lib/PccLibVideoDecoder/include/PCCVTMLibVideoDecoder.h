@@ -52,6 +52,12 @@ class PCCVTMLibVideoDecoder : public PCCVirtualVideoDecoder<T> {
                size_t             outputBitDepth = 8,
                const std::string& decoderPath    = "",
                const std::string& parameters     = "" );
+  void decode( const uint8_t*     data,
+               size_t             size,
+               PCCVideo<T, 3>&    video,
+               size_t             outputBitDepth = 8,
+               const std::string& decoderPath    = "",
+               const std::string& parameters     = "" );
 };
 
 };  // namespace pcc
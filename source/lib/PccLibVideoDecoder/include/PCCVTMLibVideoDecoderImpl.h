@@ -39,6 +39,7 @@
 
 #include "PCCVideo.h"
 #include "PCCVideoBitstream.h"
+#include <functional>
 #include "PCCVTMLibVideoDecoderCfg.h"
 
 #include <CommonLib/Picture.h>
@@ -54,7 +55,8 @@ class PCCVTMLibVideoDecoderImpl : public PCCVTMLibVideoDecoderCfg {
   PCCVTMLibVideoDecoderImpl();
 
   ~PCCVTMLibVideoDecoderImpl();
-  uint32_t decode( PCCVideoBitstream& bitstream, size_t outputBitDepth, PCCVideo<T, 3>& video );
+  uint32_t decode( const uint8_t* data, size_t size, size_t outputBitDepth, PCCVideo<T, 3>& video );
+  void setFrameCallback( std::function<void( PCCVideo<T, 3>&, size_t )> callback ) { m_frameCallback = callback; }
 
  private:
   void   xCreateDecLib();
@@ -71,6 +73,7 @@ class PCCVTMLibVideoDecoderImpl : public PCCVTMLibVideoDecoderCfg {
   int                                   m_outputWidth;
   int                                   m_outputHeight;
   bool                                  m_bRGB2GBR;
+  std::function<void( PCCVideo<T, 3>&, size_t )> m_frameCallback;
   bool                                  m_newCLVS[MAX_NUM_LAYER_IDS];
   std::ofstream                         m_seiMessageFileStream;
 
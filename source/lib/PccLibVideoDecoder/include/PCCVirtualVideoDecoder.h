@@ -36,12 +36,17 @@
 #include "PCCCommon.h"
 #include "PCCVideo.h"
 #include "PCCVideoBitstream.h"
+#include <functional>
 
 namespace pcc {
 
 template <class T>
 class PCCVirtualVideoDecoder {
  public:
+  // Called on the decoding thread as soon as a picture has been appended to video, in output order.
+  // The frame is still in the decoder output format, and video may grow again once the call returns.
+  typedef std::function<void( PCCVideo<T, 3>& video, size_t frameIndex )> FrameCallback;
+
   PCCVirtualVideoDecoder() {}
   ~PCCVirtualVideoDecoder() {}
 
@@ -53,7 +58,24 @@ class PCCVirtualVideoDecoder {
                        const std::string& decoderPath    = "",
                        const std::string& parameters     = "" ) = 0;
 
- public:
+  // decodes a byte stream held in memory; the library decoders write the pictures straight into
+  // the frames of video, the other decoders get a copy of it in a PCCVideoBitstream
+  virtual void decode( const uint8_t*     data,
+                       size_t             size,
+                       PCCVideo<T, 3>&    video,
+                       size_t             outputBitDepth = 8,
+                       const std::string& decoderPath    = "",
+                       const std::string& parameters     = "" ) {
+    PCCVideoBitstream bitstream( VIDEO_OCCUPANCY );
+    bitstream.vector().assign( data, data + size );
+    decode( bitstream, video, outputBitDepth, decoderPath, parameters );
+  }
+
+  // the library decoders report every picture, the others none
+  void setFrameCallback( FrameCallback callback ) { frameCallback_ = callback; }
+
+ protected:
+  FrameCallback frameCallback_;
 };
 
 };  // namespace pcc
@@ -50,8 +50,19 @@ void PCCHMLibVideoDecoder<T>::decode( PCCVideoBitstream& bitstream,
                                       size_t             outputBitDepth,
                                       const std::string& decoderPath,
                                       const std::string& fileName ) {
+  decode( bitstream.buffer(), bitstream.size(), video, outputBitDepth, decoderPath, fileName );
+}
+
+template <typename T>
+void PCCHMLibVideoDecoder<T>::decode( const uint8_t*     data,
+                                      size_t             size,
+                                      PCCVideo<T, 3>&    video,
+                                      size_t             outputBitDepth,
+                                      const std::string& decoderPath,
+                                      const std::string& fileName ) {
   PCCHMLibVideoDecoderImpl<T> decoder;
-  decoder.decode( bitstream, outputBitDepth, video );
+  decoder.setFrameCallback( this->frameCallback_ );
+  decoder.decode( data, size, outputBitDepth, video );
 }
 
 template class pcc::PCCHMLibVideoDecoder<uint8_t>;
@@ -36,6 +36,7 @@
 #ifdef USE_HMLIB_VIDEO_CODEC
 
 #include "PCCHMLibVideoDecoderImpl.h"
+#include "PCCMemoryStreamBuffer.h"
 
 #include <TLibCommon/TComList.h>
 #include <TLibCommon/TComPicYuv.h>
@@ -57,10 +58,12 @@ PCCHMLibVideoDecoderImpl<T>::~PCCHMLibVideoDecoderImpl() {
 }
 
 template <typename T>
-void PCCHMLibVideoDecoderImpl<T>::decode( PCCVideoBitstream& bitstream, size_t outputBitDepth, PCCVideo<T, 3>& video ) {
-  std::string                         s( reinterpret_cast<char*>( bitstream.buffer() ), bitstream.size() );
-  std::istringstream                  iss( s );
-  std::istream&                       bitstreamFile = iss;
+void PCCHMLibVideoDecoderImpl<T>::decode( const uint8_t*  data,
+                                          size_t          size,
+                                          size_t          outputBitDepth,
+                                          PCCVideo<T, 3>& video ) {
+  PCCMemoryStreamBuffer               buffer( data, size );
+  std::istream                        bitstreamFile( &buffer );
   Int                                 poc;
   pcc_hm::TComList<pcc_hm::TComPic*>* pcListPic = NULL;
   pcc_hm::InputByteStream             bytestream( bitstreamFile );
@@ -361,6 +364,7 @@ void PCCHMLibVideoDecoderImpl<T>::xWritePicture( const pcc_hm::TComPicYuv* pic,
              m_outputHeight, pic->getStride( COMPONENT_Y ), m_outputWidth / chromaSubsample,
              m_outputHeight / chromaSubsample, pic->getStride( COMPONENT_Cb ),
              m_internalBitDepths - m_outputBitDepth[0], format, m_bRGB2GBR );
+  if ( m_frameCallback ) { m_frameCallback( video, video.getFrameCount() - 1 ); }
 }
 
 template class pcc::PCCHMLibVideoDecoderImpl<uint8_t>;
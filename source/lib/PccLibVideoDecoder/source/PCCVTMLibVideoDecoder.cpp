@@ -50,6 +50,16 @@ void PCCVTMLibVideoDecoder<T>::decode( PCCVideoBitstream& bitstream,
                                        size_t             outputBitDepth,
                                        const std::string& decoderPath,
                                        const std::string& fileName ) {
+  decode( bitstream.buffer(), bitstream.size(), video, outputBitDepth, decoderPath, fileName );
+}
+
+template <typename T>
+void PCCVTMLibVideoDecoder<T>::decode( const uint8_t*     data,
+                                       size_t             size,
+                                       PCCVideo<T, 3>&    video,
+                                       size_t             outputBitDepth,
+                                       const std::string& decoderPath,
+                                       const std::string& fileName ) {
   // print information
   fprintf( stdout, "\n" );
   fprintf( stdout, "VVCSoftware: VTM Decoder Version %s ", VTM_VERSION );
@@ -62,6 +72,7 @@ void PCCVTMLibVideoDecoder<T>::decode( PCCVideoBitstream& bitstream,
   fprintf( stdout, "\n" );
 
   PCCVTMLibVideoDecoderImpl<T> decoder;
+  decoder.setFrameCallback( this->frameCallback_ );
 
   // starting time
   double  dResult;
@@ -71,7 +82,7 @@ void PCCVTMLibVideoDecoder<T>::decode( PCCVideoBitstream& bitstream,
 #ifndef _DEBUG
   try {
 #endif  // !_DEBUG
-    if ( 0 != decoder.decode( bitstream, outputBitDepth, video ) ) {
+    if ( 0 != decoder.decode( data, size, outputBitDepth, video ) ) {
       printf( "\n\n***ERROR*** A decoding mismatch occured: signalled md5sum does not match\n" );
     }
 #ifndef _DEBUG
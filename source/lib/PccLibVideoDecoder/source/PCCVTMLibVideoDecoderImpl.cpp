@@ -35,6 +35,7 @@
 #ifdef USE_VTMLIB_VIDEO_CODEC
 
 #include "PCCVTMLibVideoDecoderImpl.h"
+#include "PCCMemoryStreamBuffer.h"
 
 using namespace pcc;
 
@@ -47,14 +48,14 @@ template <typename T>
 PCCVTMLibVideoDecoderImpl<T>::~PCCVTMLibVideoDecoderImpl() {}
 
 template <typename T>
-uint32_t PCCVTMLibVideoDecoderImpl<T>::decode( PCCVideoBitstream& bitstream,
-                                               size_t             outputBitDepth,
-                                               PCCVideo<T, 3>&    video ) {
-  std::string        s( reinterpret_cast<char*>( bitstream.buffer() ), bitstream.size() );
-  std::istringstream iss( s );
-  std::istream&      bitstreamFile = iss;
-  int                poc;
-  PicList*           pcListPic = NULL;
+uint32_t PCCVTMLibVideoDecoderImpl<T>::decode( const uint8_t*  data,
+                                               size_t          size,
+                                               size_t          outputBitDepth,
+                                               PCCVideo<T, 3>& video ) {
+  PCCMemoryStreamBuffer buffer( data, size );
+  std::istream          bitstreamFile( &buffer );
+  int                   poc;
+  PicList*              pcListPic = NULL;
 
   InputByteStream bytestream( bitstreamFile );
   if ( outputBitDepth ) {
@@ -646,6 +647,7 @@ void PCCVTMLibVideoDecoderImpl<T>::xWritePicture( const Picture* pic, PCCVideo<T
              pic->getBuf( COMPONENT_Y, PIC_RECONSTRUCTION ).stride, m_outputWidth / chromaSubsample,
              m_outputHeight / chromaSubsample, pic->getBuf( COMPONENT_Cb, PIC_RECONSTRUCTION ).stride,
              m_internalBitDepths - m_outputBitDepth[0], format, m_bRGB2GBR );
+  if ( m_frameCallback ) { m_frameCallback( video, video.getFrameCount() - 1 ); }
 }
 
 template <typename T>